@@ -1,5 +1,7 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/node/active_elections.hpp>
+#include <nano/node/backlog_scan.hpp>
+#include <nano/node/confirming_set.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/test_common/chains.hpp>
 #include <nano/test_common/system.hpp>
@@ -75,4 +77,37 @@ TEST (backlog, election_activation)
 		ASSERT_EQ (nano::block_status::progress, node.ledger.process (transaction, send));
 	}
 	ASSERT_TIMELY_EQ (5s, node.active.size (), 1);
-}
\ No newline at end of file
+}
+
+/*
+ * Ensures accounts with new blocks are tracked without a full scan and dropped once confirmed
+ */
+TEST (backlog, tracked)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.backlog_scan.full_scan_interval = 1h;
+	auto & node = *system.add_node (node_config);
+	ASSERT_TIMELY_EQ (5s, node.stats.count (nano::stat::type::backlog_scan, nano::stat::detail::full_scan), 1);
+
+	nano::keypair key;
+	nano::block_builder builder;
+	auto send = builder
+				.state ()
+				.account (nano::dev::genesis_key.pub)
+				.previous (nano::dev::genesis->hash ())
+				.representative (nano::dev::genesis_key.pub)
+				.balance (nano::dev::constants.genesis_amount - nano::Knano_ratio)
+				.link (key.pub)
+				.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				.work (*node.work_generate_blocking (nano::dev::genesis->hash ()))
+				.build ();
+	node.process_active (send);
+	ASSERT_TIMELY_EQ (5s, node.backlog_scan.tracked_size (), 1);
+	ASSERT_TIMELY (5s, node.stats.count (nano::stat::type::backlog_scan, nano::stat::detail::activated) > 0);
+
+	node.confirming_set.add (send->hash ());
+	ASSERT_TIMELY (5s, nano::test::confirmed (node, { send }));
+	ASSERT_TIMELY_EQ (5s, node.backlog_scan.tracked_size (), 0);
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::backlog_scan, nano::stat::detail::full_scan));
+}
@@ -533,9 +533,68 @@ TEST (block_uniquer, cleanup)
 	block2.reset ();
 	block4.reset ();
 	ASSERT_EQ (2, uniquer.size ());
-	std::this_thread::sleep_for (nano::block_uniquer::cleanup_cutoff);
-	auto block5 = uniquer.unique (block1);
+	uniquer.cleanup ();
 	ASSERT_EQ (1, uniquer.size ());
+	ASSERT_EQ (block1, uniquer.unique (block1));
+}
+
+// Expired entries are reclaimed by subsequent calls without an explicit cleanup
+TEST (block_uniquer, incremental_cleanup)
+{
+	nano::keypair key;
+	nano::state_block_builder builder;
+	auto block1 = builder
+				  .account (0)
+				  .previous (0)
+				  .representative (0)
+				  .balance (0)
+				  .link (0)
+				  .sign (key.prv, key.pub)
+				  .work (0)
+				  .build ();
+
+	nano::block_uniquer uniquer;
+	ASSERT_EQ (block1, uniquer.unique (block1));
+	for (uint64_t work = 1; work <= 10000; ++work)
+	{
+		auto block = std::make_shared<nano::state_block> (*block1);
+		block->block_work_set (work);
+		ASSERT_EQ (block, uniquer.unique (block));
+	}
+	// Shards are never grown for expired entries
+	ASSERT_LE (uniquer.size (), nano::block_uniquer::shard_count * nano::block_uniquer::shard_min_capacity / 2);
+	ASSERT_EQ (block1, uniquer.unique (std::make_shared<nano::state_block> (*block1)));
+}
+
+TEST (block_uniquer, many_live)
+{
+	nano::keypair key;
+	nano::state_block_builder builder;
+	auto block1 = builder
+				  .account (0)
+				  .previous (0)
+				  .representative (0)
+				  .balance (0)
+				  .link (0)
+				  .sign (key.prv, key.pub)
+				  .work (0)
+				  .build ();
+
+	nano::block_uniquer uniquer;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	for (uint64_t work = 0; work < 10000; ++work)
+	{
+		auto block = std::make_shared<nano::state_block> (*block1);
+		block->block_work_set (work);
+		blocks.push_back (uniquer.unique (block));
+	}
+	ASSERT_EQ (blocks.size (), uniquer.size ());
+	// Copies resolve to the first instance after the shards were grown
+	for (auto const & block : blocks)
+	{
+		ASSERT_EQ (block, uniquer.unique (std::make_shared<nano::state_block> (*std::static_pointer_cast<nano::state_block> (block))));
+	}
+	ASSERT_EQ (blocks.size (), uniquer.size ());
 }
 
 TEST (block_builder, from)
@@ -9,4 +9,120 @@
 
 #include <gtest/gtest.h>
 
-using namespace std::chrono_literals;
\ No newline at end of file
+using namespace std::chrono_literals;
+
+// Blocks added as a batch have their work validated together, blocks with insufficient work are dropped
+TEST (block_processor, add_batch)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	nano::keypair key;
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 1)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	auto send2 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 2)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (send1->hash ()))
+				 .build ();
+	auto send3 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send2->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 3)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (0)
+				 .build ();
+	// Find a nonce below the entry threshold
+	while (!node.network_params.work.validate_entry (*send3))
+	{
+		send3->block_work_set (send3->block_work () + 1);
+	}
+
+	std::atomic<bool> called{ false };
+	ASSERT_EQ (2, node.block_processor.add ({ send1, send2, send3 }, nano::block_source::bootstrap, [&called] (auto) { called = true; }));
+	ASSERT_TIMELY (5s, node.block (send2->hash ()));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::insufficient_work));
+	ASSERT_EQ (3, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::work_batched));
+	// The callback belongs to the last block, which was dropped
+	ASSERT_FALSE (called);
+	ASSERT_EQ (nullptr, node.block (send3->hash ()));
+}
+
+// Contiguous chains are inserted in bulk, their scheduling is deferred to the backlog scan
+TEST (block_processor, add_chain)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	nano::keypair key;
+	nano::block_builder builder;
+	std::deque<std::shared_ptr<nano::block>> chain;
+	auto previous = nano::dev::genesis->hash ();
+	for (int i = 1; i <= 3; ++i)
+	{
+		auto send = builder
+					.state ()
+					.account (nano::dev::genesis_key.pub)
+					.previous (previous)
+					.representative (nano::dev::genesis_key.pub)
+					.balance (nano::dev::constants.genesis_amount - i)
+					.link (key.pub)
+					.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					.work (*system.work.generate (previous))
+					.build ();
+		previous = send->hash ();
+		chain.push_back (send);
+	}
+
+	// Chains with gaps are handed back to the caller
+	ASSERT_FALSE (node.block_processor.add_chain ({ chain[0], chain[2] }));
+
+	// Chains starting with insufficient work are dropped after a single validation, not handed back
+	auto invalid = builder
+				   .state ()
+				   .account (nano::dev::genesis_key.pub)
+				   .previous (nano::dev::genesis->hash ())
+				   .representative (nano::dev::genesis_key.pub)
+				   .balance (nano::dev::constants.genesis_amount - 1)
+				   .link (key.pub)
+				   .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				   .work (0)
+				   .build ();
+	while (!node.network_params.work.validate_entry (*invalid))
+	{
+		invalid->block_work_set (invalid->block_work () + 1);
+	}
+	ASSERT_EQ (0, node.block_processor.add_chain ({ invalid, chain[1] }).value ());
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::work_batched));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::insufficient_work));
+
+	std::atomic<bool> called{ false };
+	ASSERT_EQ (3, node.block_processor.add_chain (chain, [&called] (auto result) {
+		EXPECT_EQ (nano::block_status::progress, result);
+		called = true;
+	}).value ());
+	ASSERT_TIMELY (5s, called);
+	ASSERT_TRUE (nano::test::exists (node, { chain[0], chain[1], chain[2] }));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::block_processor, nano::stat::detail::chain));
+	ASSERT_EQ (3, node.stats.count (nano::stat::type::block_processor_source, nano::stat::detail::bootstrap_bulk));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::backlog_scan, nano::stat::detail::deferred));
+
+	// Once no more chains arrive the account is handed to the backlog scan, which activates it for elections
+	ASSERT_TIMELY (5s, node.stats.count (nano::stat::type::backlog_scan, nano::stat::detail::deferred_released) > 0);
+	ASSERT_TIMELY (5s, node.active.active (chain[0]->qualified_root ()));
+}
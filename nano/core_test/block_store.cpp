@@ -15,6 +15,8 @@
 #include <nano/secure/utility.hpp>
 #include <nano/store/account.hpp>
 #include <nano/store/block.hpp>
+#include <nano/store/block_encoding.hpp>
+#include <nano/store/block_filter.hpp>
 #include <nano/store/lmdb/lmdb.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
 #include <nano/store/versioning.hpp>
@@ -105,6 +107,63 @@ TEST (block_store, sideband_serialization)
 	ASSERT_EQ (sideband1.timestamp, sideband2.timestamp);
 }
 
+TEST (block_store, compact_block_encoding)
+{
+	nano::keypair key;
+	nano::block_builder builder;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	blocks.push_back (builder.send ().previous (1).destination (2).balance (3).sign (key.prv, key.pub).work (4).build ());
+	blocks.push_back (builder.receive ().previous (1).source (2).sign (key.prv, key.pub).work (3).build ());
+	blocks.push_back (builder.open ().source (1).representative (2).account (3).sign (key.prv, key.pub).work (4).build ());
+	blocks.push_back (builder.change ().previous (1).representative (2).sign (key.prv, key.pub).work (3).build ());
+	blocks.push_back (builder.state ().account (1).previous (2).representative (3).balance (4).link (5).sign (key.prv, key.pub).work (6).build ());
+	blocks.push_back (builder.state ().account (1).previous (0).representative (3).balance (4).link (5).sign (key.prv, key.pub).work (6).build ());
+	blocks[0]->sideband_set (nano::block_sideband (7, 8, 0, 9, 10, nano::block_details{}, nano::epoch::epoch_0));
+	blocks[1]->sideband_set (nano::block_sideband (7, 8, 11, std::numeric_limits<uint64_t>::max (), 10, nano::block_details{}, nano::epoch::epoch_0));
+	blocks[2]->sideband_set (nano::block_sideband (0, 0, 11, 1, std::numeric_limits<uint64_t>::max (), nano::block_details{}, nano::epoch::epoch_0));
+	blocks[3]->sideband_set (nano::block_sideband (7, 8, 11, 9, 10, nano::block_details{}, nano::epoch::epoch_0));
+	blocks[4]->sideband_set (nano::block_sideband (0, 8, 0, 9, 10, nano::block_details (nano::epoch::epoch_2, false, true, false), nano::epoch::epoch_1));
+	blocks[5]->sideband_set (nano::block_sideband (0, 0, 0, 1, 10, nano::block_details (nano::epoch::epoch_1, true, false, false), nano::epoch::epoch_0));
+	for (auto const & block : blocks)
+	{
+		std::vector<uint8_t> canonical;
+		{
+			nano::vectorstream stream (canonical);
+			nano::serialize_block (stream, *block);
+			block->sideband ().serialize (stream, block->type ());
+		}
+		auto compact = nano::store::block_encoding::encode (*block);
+		ASSERT_TRUE (nano::store::block_encoding::is_compact (compact.data (), compact.size ()));
+		ASSERT_FALSE (nano::store::block_encoding::is_compact (canonical.data (), canonical.size ()));
+		ASSERT_LE (compact.size (), canonical.size () + 1);
+		ASSERT_EQ (compact, nano::store::block_encoding::encode (canonical));
+		ASSERT_EQ (block->type (), nano::store::block_encoding::type (compact.data (), compact.size ()));
+
+		// Both layouts decode to the same block and sideband
+		for (auto const & value : { compact, canonical })
+		{
+			auto decoded = nano::store::block_encoding::decode (value.data (), value.size ());
+			ASSERT_EQ (*block, *decoded.block);
+			auto const & expected = block->sideband ();
+			ASSERT_EQ (expected.successor, decoded.sideband.successor);
+			ASSERT_EQ (expected.height, decoded.sideband.height);
+			ASSERT_EQ (expected.timestamp, decoded.sideband.timestamp);
+			if (block->type () != nano::block_type::state && block->type () != nano::block_type::open)
+			{
+				ASSERT_EQ (expected.account, decoded.sideband.account);
+			}
+			if (block->type () == nano::block_type::state)
+			{
+				ASSERT_EQ (expected.details, decoded.sideband.details);
+				ASSERT_EQ (expected.source_epoch, decoded.sideband.source_epoch);
+			}
+			nano::block_hash successor;
+			std::copy_n (value.begin () + nano::store::block_encoding::successor_position (value.data (), value.size ()), successor.bytes.size (), successor.bytes.begin ());
+			ASSERT_EQ (expected.successor, successor);
+		}
+	}
+}
+
 TEST (block_store, add_item)
 {
 	nano::logger logger;
@@ -136,6 +195,126 @@ TEST (block_store, add_item)
 	ASSERT_EQ (nullptr, latest3);
 }
 
+TEST (block_store, block_filter)
+{
+	nano::store::block_filter filter;
+	filter.reset (1000, 10);
+	std::vector<nano::block_hash> inserted;
+	for (auto i = 0; i < 1000; ++i)
+	{
+		inserted.push_back (nano::random_pool::generate<nano::block_hash> ());
+		filter.insert (inserted.back ());
+	}
+	// Every query passes until the filter is marked ready
+	ASSERT_TRUE (filter.may_contain (nano::random_pool::generate<nano::block_hash> ()));
+	filter.ready_set ();
+	for (auto const & hash : inserted)
+	{
+		ASSERT_TRUE (filter.may_contain (hash));
+	}
+	size_t positives = 0;
+	for (auto i = 0; i < 10000; ++i)
+	{
+		positives += filter.may_contain (nano::random_pool::generate<nano::block_hash> ());
+	}
+	// Expected false positive rate is about 1%
+	ASSERT_LT (positives, 500);
+	ASSERT_EQ (10000 - positives, filter.counters_get ().filtered);
+
+	// Filter is only loaded back for a matching tag
+	auto path = nano::unique_path () / "block_filter.dat";
+	std::filesystem::create_directories (path.parent_path ());
+	ASSERT_FALSE (filter.save (path, 42));
+	nano::store::block_filter loaded;
+	loaded.reset (1000, 10);
+	ASSERT_TRUE (loaded.load (path, 43));
+	ASSERT_FALSE (loaded.load (path, 42));
+	loaded.ready_set ();
+	for (auto const & hash : inserted)
+	{
+		ASSERT_TRUE (loaded.may_contain (hash));
+	}
+	// Different geometry is rejected
+	nano::store::block_filter resized;
+	resized.reset (2000, 10);
+	ASSERT_TRUE (resized.load (path, 42));
+}
+
+TEST (block_store, block_filter_grow)
+{
+	nano::store::block_filter filter;
+	filter.reset (100, 10);
+	ASSERT_EQ (100, filter.capacity ());
+	std::vector<nano::block_hash> inserted;
+	for (auto i = 0; i < 100; ++i)
+	{
+		inserted.push_back (nano::random_pool::generate<nano::block_hash> ());
+		filter.insert (inserted.back ());
+	}
+	filter.ready_set ();
+
+	// Blocks inserted while growing reach both tables, queries keep using the current one until the new one is filled
+	filter.grow_begin (1000);
+	for (auto i = 0; i < 100; ++i)
+	{
+		inserted.push_back (nano::random_pool::generate<nano::block_hash> ());
+		filter.insert (inserted.back ());
+	}
+	ASSERT_EQ (100, filter.capacity ());
+	for (auto const & hash : inserted)
+	{
+		ASSERT_TRUE (filter.may_contain (hash));
+	}
+	for (auto i = 0; i < 100; ++i)
+	{
+		filter.insert (inserted[i]);
+	}
+	filter.grow_end ();
+	ASSERT_EQ (1000, filter.capacity ());
+	for (auto const & hash : inserted)
+	{
+		ASSERT_TRUE (filter.may_contain (hash));
+	}
+	size_t positives = 0;
+	for (auto i = 0; i < 10000; ++i)
+	{
+		positives += filter.may_contain (nano::random_pool::generate<nano::block_hash> ());
+	}
+	// The larger table is filled to a fifth of its capacity
+	ASSERT_LT (positives, 100);
+}
+
+TEST (block_store, block_filter_lookup)
+{
+	nano::logger logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	store->block_filter.reset (1000, 10);
+	store->block_filter.ready_set ();
+	nano::block_builder builder;
+	auto block = builder
+				 .open ()
+				 .source (0)
+				 .representative (1)
+				 .account (0)
+				 .sign (nano::keypair ().prv, 0)
+				 .work (0)
+				 .build ();
+	block->sideband_set ({});
+	auto transaction (store->tx_begin_write ());
+	ASSERT_FALSE (store->block.exists (transaction, block->hash ()));
+	ASSERT_EQ (nullptr, store->block.get (transaction, block->hash ()));
+	ASSERT_EQ (2, store->block_filter.counters_get ().filtered);
+	store->block.put (transaction, block->hash (), *block);
+	ASSERT_TRUE (store->block.exists (transaction, block->hash ()));
+	ASSERT_NE (nullptr, store->block.get (transaction, block->hash ()));
+	// Deleted blocks stay in the filter and are reported as false positives
+	store->block.del (transaction, block->hash ());
+	ASSERT_FALSE (store->block.exists (transaction, block->hash ()));
+	ASSERT_EQ (1, store->block_filter.counters_get ().false_positives);
+	ASSERT_EQ (1, store->block_filter.counters_get ().erased);
+}
+
 TEST (block_store, clear_successor)
 {
 	nano::logger logger;
@@ -892,6 +1071,36 @@ TEST (block_store, account_count)
 	ASSERT_EQ (1, store->account.count (transaction));
 }
 
+TEST (block_store, account_get_sorted)
+{
+	nano::logger logger;
+	auto store = nano::make_store (logger, nano::unique_path (), nano::dev::constants);
+	ASSERT_TRUE (!store->init_error ());
+	nano::account_info info1{ 1, 1, 1, 42, 100, 200, nano::epoch::epoch_0 };
+	nano::account_info info3{ 3, 3, 3, 84, 200, 400, nano::epoch::epoch_0 };
+	{
+		auto transaction (store->tx_begin_write ());
+		store->account.put (transaction, 1, info1);
+		store->account.put (transaction, 3, info3);
+
+		// Lookups see uncommitted writes of the same transaction
+		std::vector<nano::account> accounts{ 1, 2, 3 };
+		auto result = store->account.get_sorted (transaction, accounts);
+		ASSERT_EQ (3, result.size ());
+		ASSERT_EQ (info1, result[0]);
+		ASSERT_FALSE (result[1]);
+		ASSERT_EQ (info3, result[2]);
+	}
+	auto transaction (store->tx_begin_read ());
+	std::vector<nano::account> accounts{ 0, 3, 4 };
+	auto result = store->account.get_sorted (transaction, accounts);
+	ASSERT_EQ (3, result.size ());
+	ASSERT_FALSE (result[0]);
+	ASSERT_EQ (info3, result[1]);
+	ASSERT_FALSE (result[2]);
+	ASSERT_TRUE (store->account.get_sorted (transaction, std::vector<nano::account>{}).empty ());
+}
+
 TEST (block_store, cemented_count_cache)
 {
 	nano::logger logger;
@@ -5,6 +5,7 @@
 #include <nano/node/bootstrap/bootstrap_service.hpp>
 #include <nano/node/bootstrap/database_scan.hpp>
 #include <nano/node/make_store.hpp>
+#include <nano/node/transport/inproc.hpp>
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/test_common/chains.hpp>
@@ -178,6 +179,63 @@ TEST (account_sets, saturate_priority)
 	ASSERT_EQ (sets.priority (account), nano::bootstrap::account_sets::priority_max);
 }
 
+/*
+ * peer_scoring
+ */
+
+TEST (peer_scoring, adaptive_window)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+	nano::bootstrap_config config;
+	config.channel_limit = 16;
+	config.channel_limit_min = 2;
+	config.channel_limit_max = 64;
+	nano::bootstrap::peer_scoring scoring{ config, nano::dev::network_params.network, node.stats };
+	auto channel = std::make_shared<nano::transport::inproc::channel> (node, node);
+
+	// New peers start with the initial window
+	for (int n = 0; n < 16; ++n)
+	{
+		ASSERT_FALSE (scoring.try_send_message (channel));
+	}
+	ASSERT_EQ (16, scoring.window (channel));
+	ASSERT_TRUE (scoring.limit_exceeded (channel));
+	ASSERT_TRUE (scoring.try_send_message (channel));
+
+	// Responses at a steady latency show no queueing, the window grows past the initial limit
+	for (int n = 0; n < 32; ++n)
+	{
+		scoring.received_message (channel, 100ms, 128);
+	}
+	ASSERT_EQ (48, scoring.window (channel));
+	ASSERT_FALSE (scoring.limit_exceeded (channel));
+
+	// Rising latency indicates requests queueing at the peer
+	for (int n = 0; n < 32; ++n)
+	{
+		scoring.received_message (channel, 1000ms, 128);
+	}
+	ASSERT_LT (scoring.window (channel), 48);
+	ASSERT_GE (scoring.window (channel), 2);
+
+	// The window grows back once latency returns to the lowest observed, up to the maximum
+	for (int n = 0; n < 128; ++n)
+	{
+		scoring.received_message (channel, 100ms, 128);
+	}
+	ASSERT_EQ (64, scoring.window (channel));
+
+	// Timeouts halve the window, never below the minimum
+	for (int n = 0; n < 8; ++n)
+	{
+		scoring.timed_out (channel);
+	}
+	ASSERT_EQ (2, scoring.window (channel));
+	ASSERT_GT (node.stats.count (nano::stat::type::bootstrap_peer, nano::stat::detail::window_increase), 0);
+	ASSERT_GT (node.stats.count (nano::stat::type::bootstrap_peer, nano::stat::detail::window_decrease), 0);
+}
+
 /*
  * bootstrap
  */
@@ -9,6 +9,7 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <sstream>
 
 using namespace std::chrono_literals;
@@ -239,4 +240,47 @@ TEST (bootstrap_frontier_scan, empty_responses)
 	ASSERT_EQ (frontier_scan.next (), start.number () + 1);
 	ASSERT_TRUE (frontier_scan.process (start, empty_response));
 	ASSERT_EQ (frontier_scan.next (), start); // Wraps around
-}
\ No newline at end of file
+}
+
+TEST (bootstrap_frontier_scan, checkpoint)
+{
+	nano::frontier_scan_config config;
+	config.head_parallelism = 4;
+	config.consideration_count = 1;
+	test_context ctx{ config };
+	auto & frontier_scan = ctx.frontier_scan;
+
+	// Fresh ranges have no progress to save
+	ASSERT_TRUE (frontier_scan.checkpoints ().empty ());
+
+	// Advance the first range
+	auto start = frontier_scan.next ();
+	ASSERT_EQ (start.number (), 1);
+	std::deque<std::pair<nano::account, nano::block_hash>> response;
+	response.push_back ({ nano::account{ 100 }, nano::block_hash{ 1 } });
+	ASSERT_TRUE (frontier_scan.process (start, response));
+	auto checkpoints = frontier_scan.checkpoints ();
+	ASSERT_EQ (checkpoints.size (), 1);
+	ASSERT_EQ (checkpoints.front (), std::make_pair (nano::account{ 1 }, nano::account{ 100 }));
+
+	auto path = nano::unique_path () / "bootstrap_frontiers.dat";
+	std::filesystem::create_directories (path.parent_path ());
+	ASSERT_FALSE (frontier_scan.save (path));
+
+	// A new scan with the same layout resumes the range
+	test_context resumed{ config };
+	ASSERT_FALSE (resumed.frontier_scan.load (path));
+	ASSERT_EQ (resumed.frontier_scan.checkpoints (), checkpoints);
+
+	// Progress of ranges that do not exist in a different layout is dropped
+	config.head_parallelism = 8;
+	test_context relayout{ config };
+	ASSERT_EQ (relayout.frontier_scan.restore ({ { nano::account{ 2 }, nano::account{ 100 } } }), 0);
+	ASSERT_EQ (relayout.frontier_scan.restore (checkpoints), 1);
+
+	// Missing and malformed files are rejected
+	test_context missing{ config };
+	ASSERT_TRUE (missing.frontier_scan.load (path.parent_path () / "missing.dat"));
+	std::ofstream{ path } << "garbage\n";
+	ASSERT_TRUE (missing.frontier_scan.load (path));
+}
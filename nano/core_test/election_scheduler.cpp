@@ -158,6 +158,32 @@ TEST (election_scheduler, activate_one_flush)
 	ASSERT_TIMELY (5s, node.active.election (send1->qualified_root ()));
 }
 
+TEST (election_scheduler, activate_batch)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+
+	nano::keypair key;
+	nano::state_block_builder builder;
+	auto send1 = builder.make_block ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - nano::Knano_ratio)
+				 .link (key.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*system.work.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	node.ledger.process (node.ledger.tx_begin_write (), send1);
+
+	// Duplicates are activated once, accounts without unconfirmed blocks are skipped
+	std::vector<nano::account> accounts{ nano::dev::genesis_key.pub, key.pub, nano::dev::genesis_key.pub };
+	ASSERT_EQ (1, node.scheduler.priority.activate (node.ledger.tx_begin_read (), accounts));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::election_scheduler, nano::stat::detail::activated));
+	ASSERT_EQ (1, node.stats.count (nano::stat::type::election_scheduler, nano::stat::detail::activate_skip));
+	ASSERT_TIMELY (5s, node.active.election (send1->qualified_root ()));
+}
+
 /*
  * Tests that an optimistic election can be transitioned to a priority election.
  *
@@ -363,6 +389,25 @@ TEST (election_scheduler_bucket, insert_many)
 	ASSERT_EQ (blocks[3], block0 ());
 }
 
+TEST (election_scheduler_bucket, insert_batch)
+{
+	nano::test::system system;
+	auto & node = *system.add_node ();
+
+	nano::scheduler::priority_bucket_config bucket_config;
+	nano::scheduler::bucket bucket{ 0, bucket_config, node.active, node.stats };
+	ASSERT_TRUE (bucket.push (1000, block0 ()));
+	auto added = bucket.push ({ { 2000, block1 () }, { 1000, block0 () }, { 900, block2 () } });
+	ASSERT_EQ (added, (std::vector<bool>{ true, false, true }));
+	ASSERT_EQ (3, bucket.size ());
+	auto blocks = bucket.blocks ();
+	ASSERT_EQ (3, blocks.size ());
+	// Ensure correct order
+	ASSERT_EQ (blocks[0], block2 ());
+	ASSERT_EQ (blocks[1], block0 ());
+	ASSERT_EQ (blocks[2], block1 ());
+}
+
 TEST (election_scheduler_bucket, max_blocks)
 {
 	nano::test::system system;
@@ -1,7 +1,11 @@
+#include <nano/ipc_flatbuffers_lib/flatbuffer_producer.hpp>
 #include <nano/lib/ipc_client.hpp>
+#include <nano/lib/ipc_shared_memory.hpp>
 #include <nano/lib/tomlconfig.hpp>
 #include <nano/node/ipc/ipc_access_config.hpp>
+#include <nano/node/ipc/ipc_broker.hpp>
 #include <nano/node/ipc/ipc_server.hpp>
+#include <nano/node/node.hpp>
 #include <nano/rpc/rpc.hpp>
 #include <nano/test_common/system.hpp>
 #include <nano/test_common/testutil.hpp>
@@ -10,13 +14,94 @@
 
 #include <boost/property_tree/json_parser.hpp>
 
+#include <array>
 #include <chrono>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <vector>
 
 using namespace std::chrono_literals;
 
+namespace
+{
+/** Records the events streamed to it, or refuses them like a session whose stream buffer is full */
+class test_subscriber final : public nano::ipc::subscriber
+{
+public:
+	explicit test_subscriber (uint64_t id_a, bool full_a = false) :
+		id{ id_a },
+		full{ full_a }
+	{
+	}
+
+	void async_send_message (uint8_t const * data_a, std::size_t length_a, std::function<void (nano::error const &)> broadcast_completion_handler_a) override
+	{
+		broadcast_completion_handler_a (nano::error{});
+	}
+
+	bool stream_event (std::shared_ptr<nano::ipc::event const> const & event_a) override
+	{
+		if (full)
+		{
+			++dropped;
+			return true;
+		}
+		events.push_back (event_a);
+		return false;
+	}
+
+	uint64_t get_id () const override
+	{
+		return id;
+	}
+
+	std::string get_service_name () const override
+	{
+		return {};
+	}
+
+	void set_service_name (std::string const & service_name_a) override
+	{
+	}
+
+	nano::ipc::payload_encoding get_active_encoding () const override
+	{
+		return nano::ipc::payload_encoding::flatbuffers;
+	}
+
+	uint64_t const id;
+	bool const full;
+	std::vector<std::shared_ptr<nano::ipc::event const>> events;
+	std::size_t dropped{ 0 };
+};
+
+/** Notifies the broker of a confirmation of the genesis block */
+void notify_confirmation (nano::node & node_a)
+{
+	nano::election_status status{ nano::dev::genesis, nano::election_status_type::active_confirmed_quorum };
+	node_a.observers.blocks.notify (status, {}, nano::dev::genesis_key.pub, nano::dev::constants.genesis_amount, false, false);
+}
+
+/** Reads messages until the connection fails, counting confirmation events */
+void read_confirmations (nano::ipc::ipc_client & client_a, std::atomic<int> & count_a)
+{
+	auto buffer (std::make_shared<std::vector<uint8_t>> ());
+	client_a.async_read_message (buffer, std::chrono::seconds (5), [&client_a, &count_a, buffer] (nano::error error_a, size_t size_a) {
+		if (!error_a)
+		{
+			flatbuffers::Verifier verifier (buffer->data (), buffer->size ());
+			ASSERT_TRUE (nanoapi::VerifyEnvelopeBuffer (verifier));
+			if (nanoapi::GetEnvelope (buffer->data ())->message_type () == nanoapi::Message_EventConfirmation)
+			{
+				++count_a;
+			}
+			read_confirmations (client_a, count_a);
+		}
+	});
+}
+}
+
 TEST (ipc, asynchronous)
 {
 	nano::test::system system (1);
@@ -86,6 +171,107 @@ TEST (ipc, synchronous)
 	ipc.stop ();
 }
 
+TEST (ipc, shared_memory_ring)
+{
+	alignas (64) std::array<uint8_t, 4096> memory;
+	ASSERT_LE (nano::ipc::shm_ring::memory_size (256), memory.size ());
+	nano::ipc::shm_ring ring{ memory.data (), nano::ipc::shm_ring::memory_size (256), true };
+	std::vector<uint8_t> buffer;
+	ASSERT_TRUE (ring.read (buffer, 0ms));
+
+	// Frames that don't fit before the end of the ring wrap around to the start
+	std::vector<uint8_t> payload (100);
+	for (uint8_t i = 0; i < 10; ++i)
+	{
+		std::fill (payload.begin (), payload.end (), i);
+		ASSERT_FALSE (ring.write (payload.data (), payload.size ()));
+		ASSERT_FALSE (ring.read (buffer, 0ms));
+		ASSERT_EQ (buffer, payload);
+	}
+
+	// Full ring rejects writes until read
+	ASSERT_FALSE (ring.write (payload.data (), payload.size ()));
+	ASSERT_FALSE (ring.write (payload.data (), payload.size ()));
+	ASSERT_TRUE (ring.write (payload.data (), payload.size ()));
+	ASSERT_FALSE (ring.read (buffer, 0ms));
+	ASSERT_FALSE (ring.write (payload.data (), payload.size ()));
+
+	// Frames larger than the ring are rejected
+	std::vector<uint8_t> large (512);
+	ASSERT_TRUE (ring.write (large.data (), large.size ()));
+}
+
+/*
+ * Positions and lengths in shared memory can be modified by the client, the reader must not trust them
+ */
+TEST (ipc, shared_memory_ring_corrupt)
+{
+	alignas (64) std::array<uint8_t, 4096> memory;
+	auto const size = nano::ipc::shm_ring::memory_size (256);
+	nano::ipc::shm_ring ring{ memory.data (), size, true };
+	auto & control = *reinterpret_cast<nano::ipc::shm_ring::header *> (memory.data ());
+	std::vector<uint8_t> buffer;
+	std::vector<uint8_t> payload (16, 7);
+
+	// Length pointing past the end of the data area
+	ASSERT_FALSE (ring.write (payload.data (), payload.size ()));
+	uint32_t const length = 1000;
+	auto const data = memory.data () + (size - 256);
+	std::memcpy (data, &length, sizeof (length));
+	ASSERT_TRUE (ring.read (buffer, 0ms));
+	ASSERT_EQ (ring.corruptions (), 1);
+	ASSERT_EQ (ring.size (), 0);
+
+	// Head further ahead than the capacity allows
+	control.head = control.tail + 4096;
+	ASSERT_TRUE (ring.read (buffer, 0ms));
+	ASSERT_EQ (ring.corruptions (), 2);
+
+	// Capacity in the control block is ignored in favour of the local copy
+	control.capacity = 1024 * 1024;
+	ASSERT_FALSE (ring.write (payload.data (), payload.size ()));
+	ASSERT_FALSE (ring.read (buffer, 0ms));
+	ASSERT_EQ (buffer, payload);
+	ASSERT_EQ (ring.corruptions (), 2);
+}
+
+/*
+ * A second node configured with the same segment name must not unlink the segment of a running node
+ */
+TEST (ipc, shared_memory_in_use)
+{
+	nano::test::system system;
+	auto const name = "nano_ipc_test_" + std::to_string (system.get_available_port ());
+	{
+		auto channel = nano::ipc::shm_channel::create (name, 4096);
+		ASSERT_THROW (nano::ipc::shm_channel::create (name, 4096), boost::interprocess::interprocess_exception);
+		// The existing segment is still usable
+		ASSERT_NO_THROW (nano::ipc::shm_channel::open (name));
+	}
+	// Created again once the previous owner released it
+	ASSERT_NO_THROW (nano::ipc::shm_channel::create (name, 4096));
+}
+
+TEST (ipc, shared_memory_synchronous)
+{
+	nano::test::system system (1);
+	system.nodes[0]->config.ipc_config.transport_shared_memory.enabled = true;
+	system.nodes[0]->config.ipc_config.transport_shared_memory.name = "nano_ipc_test_" + std::to_string (system.get_available_port ());
+	system.nodes[0]->config.ipc_config.transport_shared_memory.capacity = 64 * 1024;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (*system.nodes[0], node_rpc_config);
+	nano::ipc::shm_client client;
+	ASSERT_FALSE (client.connect (system.nodes[0]->config.ipc_config.transport_shared_memory.name));
+
+	std::string response (nano::ipc::request (nano::ipc::payload_encoding::json_v1, client, std::string (R"({"action": "block_count"})")));
+	std::stringstream ss;
+	ss << response;
+	boost::property_tree::ptree blocks;
+	boost::property_tree::read_json (ss, blocks);
+	ASSERT_EQ (blocks.get<int> ("count"), 1);
+	ipc.stop ();
+}
+
 TEST (ipc, permissions_default_user)
 {
 	// Test empty/nonexistant access config. The default user still exists with default permissions.
@@ -204,4 +390,107 @@ TEST (ipc, invalid_endpoint)
 		call_completed = true;
 	});
 	ASSERT_TIMELY (5s, call_completed);
-}
\ No newline at end of file
+}
+
+TEST (ipc, broker_encode_once)
+{
+	nano::test::system system (1);
+	auto & node = *system.nodes[0];
+	node.config.ipc_config.transport_tcp.enabled = true;
+	node.config.ipc_config.transport_tcp.port = system.get_available_port ();
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (node, node_rpc_config);
+	auto broker = ipc.get_broker ();
+
+	auto subscriber1 = std::make_shared<test_subscriber> (1);
+	auto subscriber2 = std::make_shared<test_subscriber> (2);
+	auto subscriber3 = std::make_shared<test_subscriber> (3);
+	broker->subscribe (subscriber1, std::make_shared<nanoapi::TopicConfirmationT> ());
+	broker->subscribe (subscriber2, std::make_shared<nanoapi::TopicConfirmationT> ());
+	auto topic = std::make_shared<nanoapi::TopicConfirmationT> ();
+	topic->options = std::make_unique<nanoapi::TopicConfirmationOptionsT> ();
+	topic->options->include_block = false;
+	broker->subscribe (subscriber3, topic);
+
+	notify_confirmation (node);
+
+	// Subscribers with the same options and encoding share a single encoded event
+	ASSERT_EQ (1, subscriber1->events.size ());
+	ASSERT_EQ (1, subscriber2->events.size ());
+	ASSERT_EQ (1, subscriber3->events.size ());
+	ASSERT_EQ (subscriber1->events.front (), subscriber2->events.front ());
+	ASSERT_NE (subscriber1->events.front (), subscriber3->events.front ());
+	ASSERT_LT (subscriber3->events.front ()->size (), subscriber1->events.front ()->size ());
+	ASSERT_EQ (2, node.stats.count (nano::stat::type::ipc, nano::stat::detail::event_encode));
+	ASSERT_EQ (3, node.stats.count (nano::stat::type::ipc, nano::stat::detail::event_stream));
+
+	// The encoded event carries the frame length in network byte order
+	auto const & event = *subscriber1->events.front ();
+	ASSERT_EQ (event.size (), boost::endian::big_to_native (event.length));
+	flatbuffers::Verifier verifier (event.data (), event.size ());
+	ASSERT_TRUE (nanoapi::VerifyEnvelopeBuffer (verifier));
+	ipc.stop ();
+}
+
+TEST (ipc, broker_full_subscriber)
+{
+	nano::test::system system (1);
+	auto & node = *system.nodes[0];
+	node.config.ipc_config.transport_tcp.enabled = true;
+	node.config.ipc_config.transport_tcp.port = system.get_available_port ();
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (node, node_rpc_config);
+	auto broker = ipc.get_broker ();
+
+	auto full = std::make_shared<test_subscriber> (1, true);
+	auto subscriber = std::make_shared<test_subscriber> (2);
+	broker->subscribe (full, std::make_shared<nanoapi::TopicConfirmationT> ());
+	broker->subscribe (subscriber, std::make_shared<nanoapi::TopicConfirmationT> ());
+
+	// Events refused by a subscriber with a full buffer are dropped, other subscribers still receive them
+	for (int n = 0; n < 8; ++n)
+	{
+		notify_confirmation (node);
+	}
+	ASSERT_EQ (8, full->dropped);
+	ASSERT_EQ (8, subscriber->events.size ());
+	ASSERT_EQ (8, node.stats.count (nano::stat::type::ipc, nano::stat::detail::event_dropped));
+	ASSERT_EQ (8, node.stats.count (nano::stat::type::ipc, nano::stat::detail::event_stream));
+	ipc.stop ();
+}
+
+TEST (ipc, stream_idle_client)
+{
+	nano::test::system system (1);
+	auto & node = *system.nodes[0];
+	node.config.ipc_config.transport_tcp.enabled = true;
+	node.config.ipc_config.transport_tcp.port = system.get_available_port ();
+	node.config.ipc_config.transport_tcp.stream_buffer_size = 4;
+	nano::node_rpc_config node_rpc_config;
+	nano::ipc::ipc_server ipc (node, node_rpc_config);
+
+	// Both clients subscribe to confirmations, only the first one reads its events
+	nano::ipc::ipc_client reader (node.io_ctx);
+	nano::ipc::ipc_client idle (node.io_ctx);
+	ASSERT_FALSE (reader.connect ("::1", ipc.listening_tcp_port ().value ()));
+	ASSERT_FALSE (idle.connect ("::1", ipc.listening_tcp_port ().value ()));
+	nanoapi::TopicConfirmationT topic;
+	reader.async_write (nano::ipc::shared_buffer_from (topic), [] (nano::error, size_t) {});
+	idle.async_write (nano::ipc::shared_buffer_from (topic), [] (nano::error, size_t) {});
+	ASSERT_TIMELY_EQ (5s, 2, ipc.get_broker ()->confirmation_subscriber_count ());
+
+	std::atomic<int> count{ 0 };
+	read_confirmations (reader, count);
+	int const events = 64;
+	for (int n = 0; n < events; ++n)
+	{
+		notify_confirmation (node);
+		// Gives the reader time to drain its bounded buffer, the idle client is not waited for
+		ASSERT_TIMELY_EQ (5s, n + 1, count.load ());
+	}
+
+	// Each event is encoded once and either streamed or dropped for every session
+	ASSERT_EQ (events, node.stats.count (nano::stat::type::ipc, nano::stat::detail::event_encode));
+	ASSERT_EQ (2 * events, node.stats.count (nano::stat::type::ipc, nano::stat::detail::event_stream) + node.stats.count (nano::stat::type::ipc, nano::stat::detail::event_dropped));
+	ipc.stop ();
+}
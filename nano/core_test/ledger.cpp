@@ -12,8 +12,10 @@
 #include <nano/node/vote_router.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
+#include <nano/secure/receivable_batch_iterator.hpp>
 #include <nano/secure/vote.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
+#include <nano/store/snapshot.hpp>
 #include <nano/test_common/ledger_context.hpp>
 #include <nano/test_common/make_store.hpp>
 #include <nano/test_common/system.hpp>
@@ -21,6 +23,7 @@
 
 #include <gtest/gtest.h>
 
+#include <fstream>
 #include <limits>
 
 using namespace std::chrono_literals;
@@ -5549,6 +5552,224 @@ TEST (ledger, migrate_lmdb_to_rocksdb)
 	ASSERT_EQ (error_on_retry, true);
 }
 
+TEST (ledger, snapshot_export_import)
+{
+	auto ctx = nano::test::ledger_send_receive ();
+	auto & store = ctx.store ();
+	auto path = nano::unique_path ();
+	ASSERT_FALSE (nano::store::snapshot::write (store, nano::dev::genesis->hash (), path, ctx.logger ()));
+	// Exporting into an existing snapshot must fail
+	ASSERT_TRUE (nano::store::snapshot::write (store, nano::dev::genesis->hash (), path, ctx.logger ()));
+
+	auto imported = nano::test::make_store ();
+	ASSERT_FALSE (imported->init_error ());
+	ASSERT_FALSE (nano::store::snapshot::read (path, nano::dev::genesis->hash (), *imported, ctx.logger ()));
+
+	auto tx = store.tx_begin_read ();
+	auto tx_imported = imported->tx_begin_read ();
+	ASSERT_EQ (store.block.count (tx), imported->block.count (tx_imported));
+	ASSERT_EQ (store.account.count (tx), imported->account.count (tx_imported));
+	ASSERT_EQ (store.pending.count (tx), imported->pending.count (tx_imported));
+	ASSERT_EQ (store.confirmation_height.count (tx), imported->confirmation_height.count (tx_imported));
+	ASSERT_EQ (store.rep_weight.count (tx), imported->rep_weight.count (tx_imported));
+	for (auto const & block : ctx.blocks ())
+	{
+		auto block_l = imported->block.get (tx_imported, block->hash ());
+		ASSERT_NE (nullptr, block_l);
+		ASSERT_EQ (*block, *block_l);
+		ASSERT_EQ (block->sideband ().height, block_l->sideband ().height);
+	}
+	ASSERT_EQ (store.account.get (tx, nano::dev::genesis_key.pub), imported->account.get (tx_imported, nano::dev::genesis_key.pub));
+
+	// Importing into a non-empty store must fail
+	ASSERT_TRUE (nano::store::snapshot::read (path, nano::dev::genesis->hash (), *imported, ctx.logger ()));
+	// Snapshots of a different network are rejected
+	ASSERT_TRUE (nano::store::snapshot::read (path, nano::block_hash{ 1 }, *nano::test::make_store (), ctx.logger ()));
+}
+
+TEST (ledger, snapshot_corrupt)
+{
+	auto ctx = nano::test::ledger_send_receive ();
+	auto path = nano::unique_path ();
+	ASSERT_FALSE (nano::store::snapshot::write (ctx.store (), nano::dev::genesis->hash (), path, ctx.logger ()));
+
+	// Flip a byte in the first chunk holding blocks
+	std::filesystem::path chunk;
+	for (auto const & entry : std::filesystem::directory_iterator{ path })
+	{
+		if (entry.path ().filename ().string ().starts_with ("blocks-"))
+		{
+			chunk = entry.path ();
+			break;
+		}
+	}
+	ASSERT_FALSE (chunk.empty ());
+	{
+		std::fstream stream{ chunk, std::ios::binary | std::ios::in | std::ios::out };
+		stream.seekg (16);
+		char byte{ 0 };
+		stream.read (&byte, 1);
+		stream.seekp (16);
+		byte = static_cast<char> (byte ^ 0xff);
+		stream.write (&byte, 1);
+	}
+
+	auto imported = nano::test::make_store ();
+	ASSERT_TRUE (nano::store::snapshot::read (path, nano::dev::genesis->hash (), *imported, ctx.logger ()));
+	// Nothing is loaded if verification fails
+	ASSERT_EQ (0, imported->block.count (imported->tx_begin_read ()));
+
+	// Entry sizes are bounded before the checksum is verified
+	{
+		std::fstream stream{ chunk, std::ios::binary | std::ios::in | std::ios::out };
+		uint32_t const size{ std::numeric_limits<uint32_t>::max () };
+		stream.write (reinterpret_cast<char const *> (&size), sizeof (size));
+	}
+	ASSERT_TRUE (nano::store::snapshot::read (path, nano::dev::genesis->hash (), *imported, ctx.logger ()));
+	ASSERT_EQ (0, imported->block.count (imported->tx_begin_read ()));
+}
+
+TEST (ledger, receivable_totals)
+{
+	nano::logger logger;
+	auto store = nano::test::make_store ();
+	ASSERT_FALSE (store->init_error ());
+	nano::stats stats{ logger };
+	nano::generate_cache_flags flags;
+	flags.receivable = true;
+	nano::ledger ledger{ *store, stats, nano::dev::constants, flags };
+	nano::work_pool pool{ nano::dev::network_params.network, std::numeric_limits<unsigned>::max () };
+	nano::keypair key1;
+	nano::block_builder builder;
+	auto send1 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (nano::dev::genesis->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 100)
+				 .link (key1.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (nano::dev::genesis->hash ()))
+				 .build ();
+	auto send2 = builder
+				 .state ()
+				 .account (nano::dev::genesis_key.pub)
+				 .previous (send1->hash ())
+				 .representative (nano::dev::genesis_key.pub)
+				 .balance (nano::dev::constants.genesis_amount - 150)
+				 .link (key1.pub)
+				 .sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+				 .work (*pool.generate (send1->hash ()))
+				 .build ();
+	auto open = builder
+				.state ()
+				.account (key1.pub)
+				.previous (0)
+				.representative (key1.pub)
+				.balance (100)
+				.link (send1->hash ())
+				.sign (key1.prv, key1.pub)
+				.work (*pool.generate (key1.pub))
+				.build ();
+	{
+		auto transaction = ledger.tx_begin_write ();
+		store->initialize (transaction, ledger.cache, ledger.constants);
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send1));
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send2));
+		auto totals = ledger.cache.receivable.get (key1.pub);
+		ASSERT_EQ (2, totals.count);
+		ASSERT_EQ (150, totals.amount);
+		ASSERT_EQ (0, totals.confirmed_count);
+
+		ASSERT_FALSE (ledger.confirm (transaction, send1->hash ()).empty ());
+		totals = ledger.cache.receivable.get (key1.pub);
+		ASSERT_EQ (1, totals.confirmed_count);
+		ASSERT_EQ (100, totals.confirmed_amount);
+		ASSERT_EQ (150, ledger.account_receivable (transaction, key1.pub));
+		ASSERT_EQ (100, ledger.account_receivable (transaction, key1.pub, true));
+
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, open));
+		totals = ledger.cache.receivable.get (key1.pub);
+		ASSERT_EQ (1, totals.count);
+		ASSERT_EQ (50, totals.amount);
+		ASSERT_EQ (0, totals.confirmed_count);
+
+		// Rolling back the receive restores the confirmed entry
+		ASSERT_FALSE (ledger.rollback (transaction, open->hash ()));
+		totals = ledger.cache.receivable.get (key1.pub);
+		ASSERT_EQ (2, totals.count);
+		ASSERT_EQ (150, totals.amount);
+		ASSERT_EQ (100, totals.confirmed_amount);
+
+		ASSERT_FALSE (ledger.rollback (transaction, send2->hash ()));
+		totals = ledger.cache.receivable.get (key1.pub);
+		ASSERT_EQ (1, totals.count);
+		ASSERT_EQ (100, totals.amount);
+		ASSERT_EQ (100, totals.confirmed_amount);
+	}
+
+	// Totals generated from the pending table match the maintained ones
+	nano::ledger ledger2{ *store, stats, nano::dev::constants, flags };
+	auto totals = ledger2.cache.receivable.get (key1.pub);
+	ASSERT_EQ (1, totals.count);
+	ASSERT_EQ (100, totals.amount);
+	ASSERT_EQ (1, totals.confirmed_count);
+	ASSERT_EQ (100, totals.confirmed_amount);
+	ASSERT_EQ (1, ledger2.cache.receivable.size ());
+}
+
+TEST (ledger, receivable_batch_iterator)
+{
+	auto ctx = nano::test::ledger_empty ();
+	auto & ledger = ctx.ledger ();
+	auto & pool = ctx.pool ();
+	nano::keypair key1;
+	nano::keypair key2;
+	nano::keypair key3;
+	nano::block_builder builder;
+	auto transaction = ledger.tx_begin_write ();
+	std::vector<std::pair<nano::account, nano::block_hash>> sent;
+	auto previous = nano::dev::genesis->hash ();
+	auto balance = nano::dev::constants.genesis_amount;
+	for (auto const & destination : { key1.pub, key2.pub, key1.pub, key2.pub, key1.pub })
+	{
+		balance -= 1;
+		auto send = builder
+					.state ()
+					.account (nano::dev::genesis_key.pub)
+					.previous (previous)
+					.representative (nano::dev::genesis_key.pub)
+					.balance (balance)
+					.link (destination)
+					.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					.work (*pool.generate (previous))
+					.build ();
+		ASSERT_EQ (nano::block_status::progress, ledger.process (transaction, send));
+		sent.emplace_back (destination, send->hash ());
+		previous = send->hash ();
+	}
+
+	// Duplicate accounts and accounts without receivable entries are skipped
+	std::vector<std::pair<nano::account, nano::block_hash>> visited;
+	for (nano::receivable_batch_iterator i{ ledger, transaction, { key3.pub, key2.pub, key1.pub, key2.pub } }; !i.end (); ++i)
+	{
+		visited.emplace_back (i->first.account, i->first.hash);
+	}
+	std::sort (sent.begin (), sent.end ());
+	ASSERT_EQ (sent, visited);
+
+	// Only the first entry of each account is visited
+	size_t count = 0;
+	for (nano::receivable_batch_iterator i{ ledger, transaction, { key1.pub, key2.pub, key3.pub } }; !i.end (); i.next_account ())
+	{
+		++count;
+	}
+	ASSERT_EQ (2, count);
+
+	nano::receivable_batch_iterator empty{ ledger, transaction, { key3.pub } };
+	ASSERT_TRUE (empty.end ());
+}
+
 TEST (ledger, is_send_genesis)
 {
 	auto ctx = nano::test::ledger_empty ();
@@ -7,6 +7,8 @@
 #include <future>
 #include <regex>
 
+using namespace std::chrono_literals;
+
 #if USING_NANO_TIMED_LOCKS
 namespace
 {
@@ -196,3 +198,55 @@ TEST (locks, defer_lock)
 	ASSERT_FALSE (lock.owns_lock ());
 }
 #endif
+
+namespace
+{
+nano::lock_profiler::entry find_profile (std::string const & name)
+{
+	auto entries = nano::lock_profiler::collect ();
+	auto existing = std::find_if (entries.begin (), entries.end (), [&name] (auto const & entry) { return entry.name == name; });
+	release_assert (existing != entries.end ());
+	return *existing;
+}
+}
+
+TEST (locks, profiler)
+{
+	nano::mutex mutex{ "locks_profiler_test" };
+	nano::lock_profiler::reset ();
+
+	// Not counted while disabled
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+	}
+	ASSERT_EQ (find_profile ("locks_profiler_test").acquisitions, 0);
+
+	nano::lock_profiler::enable (true);
+	for (int i = 0; i < 64; ++i)
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+	}
+	std::promise<void> locked;
+	std::thread holder ([&mutex, &locked] () {
+		nano::unique_lock<nano::mutex> lock{ mutex };
+		locked.set_value ();
+		std::this_thread::sleep_for (50ms);
+	});
+	locked.get_future ().wait ();
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+	}
+	holder.join ();
+	nano::lock_profiler::enable (false);
+
+	auto profile = find_profile ("locks_profiler_test");
+	ASSERT_EQ (profile.acquisitions, 66);
+	ASSERT_EQ (profile.contended, 1);
+	ASSERT_GE (profile.wait, 10ms);
+	ASSERT_EQ (profile.wait, profile.wait_max);
+	ASSERT_GE (profile.hold_samples, 64 / nano::lock_profiler::hold_sample_interval);
+	ASSERT_LE (profile.hold_max, profile.hold);
+
+	nano::lock_profiler::reset ();
+	ASSERT_EQ (find_profile ("locks_profiler_test").acquisitions, 0);
+}
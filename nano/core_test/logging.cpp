@@ -3,6 +3,8 @@
 
 #include <gtest/gtest.h>
 
+#include <spdlog/sinks/ostream_sink.h>
+
 #include <ostream>
 
 using namespace std::chrono_literals;
@@ -103,4 +105,70 @@ TEST (log_parse, parse_logger_id)
 	ASSERT_THROW (nano::log::parse_logger_id ("::"), std::invalid_argument);
 	ASSERT_THROW (nano::log::parse_logger_id ("::all"), std::invalid_argument);
 	ASSERT_THROW (nano::log::parse_logger_id (""), std::invalid_argument);
-}
\ No newline at end of file
+}
+
+TEST (log_async, format)
+{
+	std::ostringstream output;
+	auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt> (output);
+	sink->set_pattern ("%v");
+	spdlog::logger logger{ "test", sink };
+
+	nano::log::async_backend backend{ 4, { sink } };
+	std::string text{ "text" };
+	// Deferred formatting of numbers, enums and nano number types
+	static_assert (nano::log::deferrable<nano::block_hash const &>);
+	static_assert (nano::log::deferrable<nano::stat::detail>);
+	backend.push (logger, spdlog::level::info, "values {} {} {}", 1, true, nano::stat::detail::all);
+	// Strings are formatted when pushed
+	backend.push (logger, spdlog::level::info, "string {}", text);
+	text = "changed";
+	// Trivially copyable views referencing the caller's objects are formatted when pushed
+	static_assert (!nano::log::deferrable<decltype (fmt::streamed (text))>);
+	{
+		std::string scoped{ "scoped" };
+		backend.push (logger, spdlog::level::info, "streamed {}", fmt::streamed (scoped));
+		scoped = "changed";
+	}
+	backend.drain ();
+	ASSERT_EQ (output.str (), "values 1 true all\nstring text\nstreamed scoped\n");
+	ASSERT_EQ (backend.dropped (), 0);
+}
+
+TEST (log_async, drain_local)
+{
+	std::ostringstream output;
+	auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt> (output);
+	sink->set_pattern ("%v");
+	spdlog::logger logger{ "test", sink };
+
+	nano::log::async_backend backend{ 1024, { sink } };
+	for (int i = 0; i < 100; ++i)
+	{
+		backend.push (logger, spdlog::level::info, "message {}", i);
+	}
+	// A message written directly, as done for the flush level, follows the messages queued before it by the same thread
+	backend.drain_local ();
+	logger.error ("error");
+	ASSERT_EQ (output.str ().rfind ("message 99\n"), output.str ().size () - std::string{ "message 99\nerror\n" }.size ());
+	ASSERT_EQ (backend.dropped (), 0);
+}
+
+TEST (log_async, overflow)
+{
+	std::ostringstream output;
+	auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt> (output);
+	sink->set_pattern ("%v");
+	spdlog::logger logger{ "test", sink };
+
+	nano::log::async_backend backend{ 2, { sink } };
+	// Pushing is much faster than writing to the sink, the small buffer overflows
+	for (int i = 0; i < 10000; ++i)
+	{
+		backend.push (logger, spdlog::level::info, "message {}", i);
+	}
+	backend.drain ();
+	ASSERT_GT (backend.dropped (), 0);
+	ASSERT_NE (output.str ().find ("message 0\n"), std::string::npos);
+	ASSERT_NE (output.str ().find ("log messages, logging buffers are full"), std::string::npos);
+}
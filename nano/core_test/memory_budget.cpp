@@ -0,0 +1,123 @@
+#include <nano/lib/container_info.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/lib/numbers_templ.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/node/memory_budget.hpp>
+#include <nano/node/vote_cache.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+TEST (memory_budget, container_info_usage)
+{
+	nano::container_info child;
+	child.put ("entries", 10, 8);
+	nano::container_info info;
+	info.put ("entries", 4, 16);
+	info.put ("count", 100); // Entries without element size are not counted
+	info.add ("child", child);
+	ASSERT_EQ (info.memory_usage (), 4 * 16 + 10 * 8);
+}
+
+TEST (memory_budget, disabled)
+{
+	nano::test::system system;
+	nano::memory_budget_config config;
+	ASSERT_EQ (config.target, 0);
+	nano::memory_budget budget{ config, system.stats, system.logger };
+	budget.start ();
+	ASSERT_EQ (budget.scale (), 1.0);
+	budget.stop ();
+}
+
+TEST (memory_budget, shrink_grow)
+{
+	nano::test::system system;
+	nano::memory_budget_config config;
+	config.target = 100; // MB
+	config.min_scale = 0.2;
+	nano::memory_budget budget{ config, system.stats, system.logger };
+
+	size_t resident = 150 * 1024 * 1024;
+	budget.resident_memory_query = [&resident] () { return resident; };
+	double applied = 1.0;
+	budget.add (
+	"test", [] () {
+		nano::container_info info;
+		info.put ("entries", 100, 1024 * 1024);
+		return info;
+	},
+	[&applied] (double scale) { applied = scale; });
+
+	// 50 MB excess out of 100 MB tracked, limits are halved
+	budget.adjust ();
+	ASSERT_DOUBLE_EQ (budget.scale (), 0.5);
+	ASSERT_DOUBLE_EQ (applied, 0.5);
+	ASSERT_EQ (system.stats.count (nano::stat::type::memory_budget, nano::stat::detail::shrink), 1);
+
+	// Never shrunk below the minimum
+	for (int i = 0; i < 10; ++i)
+	{
+		budget.adjust ();
+	}
+	ASSERT_DOUBLE_EQ (budget.scale (), config.min_scale);
+	ASSERT_DOUBLE_EQ (applied, config.min_scale);
+
+	// Within the hysteresis band, nothing changes
+	resident = 90 * 1024 * 1024;
+	budget.adjust ();
+	ASSERT_DOUBLE_EQ (budget.scale (), config.min_scale);
+
+	// Grows back gradually, up to the configured limits
+	resident = 50 * 1024 * 1024;
+	budget.adjust ();
+	ASSERT_GT (budget.scale (), config.min_scale);
+	ASSERT_LT (budget.scale (), 1.0);
+	for (int i = 0; i < 100; ++i)
+	{
+		budget.adjust ();
+	}
+	ASSERT_DOUBLE_EQ (budget.scale (), 1.0);
+	ASSERT_DOUBLE_EQ (applied, 1.0);
+	ASSERT_GT (system.stats.count (nano::stat::type::memory_budget, nano::stat::detail::grow), 0);
+}
+
+TEST (memory_budget, unsupported)
+{
+	nano::test::system system;
+	nano::memory_budget_config config;
+	config.target = 100;
+	nano::memory_budget budget{ config, system.stats, system.logger };
+	budget.resident_memory_query = [] () { return size_t{ 0 }; };
+	budget.adjust ();
+	ASSERT_EQ (budget.scale (), 1.0);
+	ASSERT_EQ (system.stats.count (nano::stat::type::memory_budget, nano::stat::detail::unsupported), 1);
+}
+
+TEST (memory_budget, vote_cache_scale)
+{
+	nano::test::system system;
+	nano::vote_cache_config cfg;
+	cfg.max_size = 1024;
+	nano::vote_cache vote_cache{ cfg, system.stats };
+	vote_cache.rep_weight_query = [] (nano::account const &) { return nano::uint128_t{ 1 }; };
+	nano::keypair rep;
+	for (int n = 0; n < 1024; ++n)
+	{
+		vote_cache.insert (nano::test::make_vote (rep, { nano::test::random_hash () }, 1024 * 1024));
+	}
+	ASSERT_EQ (vote_cache.size (), 1024);
+
+	// Shrinking evicts the oldest entries
+	vote_cache.capacity_scale (0.25);
+	ASSERT_EQ (vote_cache.size (), 256);
+
+	// New entries respect the scaled limit
+	vote_cache.insert (nano::test::make_vote (rep, { nano::test::random_hash () }, 1024 * 1024));
+	ASSERT_EQ (vote_cache.size (), 256);
+
+	vote_cache.capacity_scale (1.0);
+	vote_cache.insert (nano::test::make_vote (rep, { nano::test::random_hash () }, 1024 * 1024));
+	ASSERT_EQ (vote_cache.size (), 257);
+}
@@ -89,6 +89,24 @@ TEST (node, block_store_path_failure)
 	ASSERT_TRUE (node->wallets.items.empty ());
 }
 
+// A node that is opened but never started, as done by the CLI, must not overwrite the frontier scan checkpoint
+TEST (node, unstarted_keeps_frontiers_checkpoint)
+{
+	nano::test::system system;
+	auto path (nano::unique_path ());
+	std::filesystem::create_directories (path);
+	auto const checkpoint = path / "bootstrap_frontiers.dat";
+	std::ofstream{ checkpoint } << "checkpoint\n";
+	{
+		auto node (std::make_shared<nano::node> (system.io_ctx, system.get_available_port (), path, system.work));
+	}
+	ASSERT_TRUE (std::filesystem::exists (checkpoint));
+	std::ifstream stream{ checkpoint };
+	std::string contents;
+	std::getline (stream, contents);
+	ASSERT_EQ (contents, "checkpoint");
+}
+
 #if defined(__clang__) && defined(__linux__) && CI
 // Disable test due to instability with clang and actions
 TEST (node_DeathTest, DISABLED_readonly_block_store_not_exist)
@@ -2524,6 +2542,34 @@ TEST (node, peers)
 	ASSERT_TIMELY (10s, node2->network.empty ());
 }
 
+TEST (node, block_filter_restart)
+{
+	nano::test::system system;
+	auto path (nano::unique_path ());
+	{
+		auto node1 (std::make_shared<nano::node> (system.io_ctx, system.get_available_port (), path, system.work));
+		system.nodes.push_back (node1);
+		node1->start ();
+		ASSERT_TIMELY (5s, node1->store.block_filter.ready ());
+		ASSERT_EQ (1, node1->stats.count (nano::stat::type::block_filter, nano::stat::detail::rebuild));
+		ASSERT_TRUE (node1->store.block_filter.may_contain (nano::dev::genesis->hash ()));
+		system.stop_node (*node1);
+		ASSERT_TRUE (std::filesystem::exists (path / "block_filter.dat"));
+	}
+	// Restart node, the saved filter is loaded instead of being rebuilt
+	{
+		auto node2 (std::make_shared<nano::node> (system.io_ctx, system.get_available_port (), path, system.work));
+		system.nodes.push_back (node2);
+		node2->start ();
+		ASSERT_TIMELY (5s, node2->store.block_filter.ready ());
+		ASSERT_EQ (1, node2->stats.count (nano::stat::type::block_filter, nano::stat::detail::loaded));
+		ASSERT_EQ (0, node2->stats.count (nano::stat::type::block_filter, nano::stat::detail::rebuild));
+		ASSERT_TRUE (node2->store.block_filter.may_contain (nano::dev::genesis->hash ()));
+		ASSERT_TRUE (node2->ledger.any.block_exists (node2->ledger.tx_begin_read (), nano::dev::genesis->hash ()));
+		system.stop_node (*node2);
+	}
+}
+
 TEST (node, peer_history_restart)
 {
 	nano::test::system system (1);
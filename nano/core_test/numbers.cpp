@@ -1,11 +1,13 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/lib/numbers_templ.hpp>
+#include <nano/lib/uint128.hpp>
 #include <nano/secure/common.hpp>
 
 #include <gtest/gtest.h>
 
 #include <boost/container_hash/hash.hpp>
 
+#include <random>
 #include <thread>
 #include <unordered_set>
 
@@ -801,6 +803,96 @@ TEST (sat_math, sub_sat)
 	}
 }
 
+namespace
+{
+/** Checks every operation of a fixed width 128 bit type against nano::uint128_t */
+template <typename T>
+void check_uint128_equivalence (nano::uint128_t const & a, nano::uint128_t const & b)
+{
+	T const x{ a };
+	T const y{ b };
+	ASSERT_EQ (x.number (), a);
+	ASSERT_EQ (static_cast<nano::uint128_t> (x), a);
+	ASSERT_EQ ((x + y).number (), nano::uint128_t{ a + b });
+	ASSERT_EQ ((x - y).number (), nano::uint128_t{ a - b });
+	ASSERT_EQ ((x * y).number (), nano::uint128_t{ a * b });
+	if (b != 0)
+	{
+		ASSERT_EQ ((x / y).number (), nano::uint128_t{ a / b });
+		ASSERT_EQ ((x % y).number (), nano::uint128_t{ a % b });
+	}
+	ASSERT_EQ (x == y, a == b);
+	ASSERT_EQ (x != y, a != b);
+	ASSERT_EQ (x < y, a < b);
+	ASSERT_EQ (x <= y, a <= b);
+	ASSERT_EQ (x > y, a > b);
+	ASSERT_EQ (x >= y, a >= b);
+
+	T sum{ x };
+	sum += y;
+	ASSERT_EQ (sum.number (), nano::uint128_t{ a + b });
+	sum -= y;
+	ASSERT_EQ (sum, x);
+}
+
+template <typename T>
+void check_uint128_type ()
+{
+	nano::uint128_t const max = std::numeric_limits<nano::uint128_t>::max ();
+	nano::uint128_t const word = std::numeric_limits<uint64_t>::max ();
+	std::vector<nano::uint128_t> values{ 0, 1, 2, word - 1, word, word + 1, word << 1, nano::uint128_t{ 1 } << 63, nano::uint128_t{ 1 } << 127, max - 1, max, nano::Knano_ratio, nano::nano_ratio, nano::dev::constants.genesis_amount };
+	for (auto const & a : values)
+	{
+		for (auto const & b : values)
+		{
+			check_uint128_equivalence<T> (a, b);
+		}
+		for (unsigned shift = 0; shift < 128; ++shift)
+		{
+			ASSERT_EQ ((T{ a } << shift).number (), nano::uint128_t{ a << shift });
+			ASSERT_EQ ((T{ a } >> shift).number (), nano::uint128_t{ a >> shift });
+		}
+	}
+
+	std::mt19937_64 random{ 0 };
+	auto random_value = [&random] () {
+		// Mix full width values with values that fit into either word, so carries and borrows are exercised
+		nano::uint128_t const value = (nano::uint128_t{ random () } << 64) | random ();
+		switch (random () % 3)
+		{
+			case 0:
+				return value;
+			case 1:
+				return value >> 64;
+			default:
+				return value >> (random () % 128);
+		}
+	};
+	for (int n = 0; n < 100000; ++n)
+	{
+		check_uint128_equivalence<T> (random_value (), random_value ());
+	}
+
+	ASSERT_EQ (T{ 5 }.low (), 5);
+	ASSERT_EQ (T{ 5 }.high (), 0);
+	ASSERT_EQ (T (7, 5).number (), (nano::uint128_t{ 7 } << 64) + 5);
+	ASSERT_EQ (T{ max }.high (), std::numeric_limits<uint64_t>::max ());
+	ASSERT_EQ (T{}, T{ 0 });
+}
+}
+
+TEST (uint128_fast, words)
+{
+	check_uint128_type<nano::uint128_words> ();
+}
+
+#if defined(__SIZEOF_INT128__)
+TEST (uint128_fast, native)
+{
+	check_uint128_type<nano::uint128_native> ();
+}
+#endif
+
 TEST (account, encode_zero)
 {
 	nano::account number0{};
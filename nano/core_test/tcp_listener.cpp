@@ -1,6 +1,7 @@
 #include <nano/boost/asio/ip/address_v6.hpp>
 #include <nano/boost/asio/ip/network_v6.hpp>
 #include <nano/lib/thread_runner.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
 #include <nano/test_common/system.hpp>
@@ -288,4 +289,30 @@ TEST (tcp_listener, tcp_listener_timeout_node_id_handshake)
 		disconnected = node0->tcp_listener.connection_count () == 0;
 		ASSERT_NO_ERROR (system.poll ());
 	}
-}
\ No newline at end of file
+}
+
+TEST (tcp_listener, io_shards)
+{
+	nano::test::system system;
+	nano::node_config node_config = system.default_config ();
+	node_config.io_shards = 2;
+	auto & node1 = *system.add_node (node_config);
+	auto & node2 = *system.add_node (system.default_config ());
+	ASSERT_EQ (node1.io_shards.size (), 2);
+	ASSERT_EQ (node2.io_shards.size (), 0);
+
+	// Channels are only created once the node id handshake completed over the sharded sockets
+	ASSERT_TIMELY (5s, node1.network.find_node_id (node2.get_node_id ()));
+	ASSERT_TIMELY (5s, node2.network.find_node_id (node1.get_node_id ()));
+
+	auto sockets1 = node1.tcp_listener.sockets ();
+	ASSERT_FALSE (sockets1.empty ());
+	for (auto const & socket : sockets1)
+	{
+		ASSERT_NE (&socket->executor ().context (), &node1.io_ctx);
+	}
+	for (auto const & socket : node2.tcp_listener.sockets ())
+	{
+		ASSERT_EQ (&socket->executor ().context (), &node2.io_ctx);
+	}
+}
@@ -0,0 +1,78 @@
+#include <nano/lib/thread_placement.hpp>
+#include <nano/lib/thread_roles.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+TEST (thread_placement, parse_cpus)
+{
+	ASSERT_EQ (nano::thread_placement::parse_cpus ("3"), (std::vector<unsigned>{ 3 }));
+	ASSERT_EQ (nano::thread_placement::parse_cpus ("0-3, 8,2"), (std::vector<unsigned>{ 0, 1, 2, 3, 8 }));
+	ASSERT_THROW (nano::thread_placement::parse_cpus (""), std::invalid_argument);
+	ASSERT_THROW (nano::thread_placement::parse_cpus ("a"), std::invalid_argument);
+	ASSERT_THROW (nano::thread_placement::parse_cpus ("3-1"), std::invalid_argument);
+	ASSERT_THROW (nano::thread_placement::parse_cpus ("1-"), std::invalid_argument);
+	ASSERT_THROW (nano::thread_placement::parse_cpus ("numa:100000"), std::invalid_argument);
+	ASSERT_THROW (nano::thread_placement::parse_cpus ("4096"), std::invalid_argument);
+	ASSERT_THROW (nano::thread_placement::parse_cpus ("0-4294967295"), std::invalid_argument);
+	ASSERT_EQ (nano::thread_placement::parse_cpus ("4095").size (), 1);
+}
+
+TEST (thread_placement, format_cpus)
+{
+	ASSERT_EQ (nano::thread_placement::format_cpus ({ 0, 1, 2, 3, 8, 10, 11 }), "0-3,8,10-11");
+	ASSERT_EQ (nano::thread_placement::format_cpus ({ 5 }), "5");
+	ASSERT_EQ (nano::thread_placement::parse_cpus (nano::thread_placement::format_cpus ({ 0, 2, 3, 4 })), (std::vector<unsigned>{ 0, 2, 3, 4 }));
+}
+
+namespace
+{
+/** Clears the process wide placement when the test ends, also when an assertion fails */
+class placement_guard final
+{
+public:
+	~placement_guard ()
+	{
+		nano::thread_placement::apply ({});
+	}
+};
+}
+
+TEST (thread_placement, apply)
+{
+	placement_guard guard;
+	auto const available = nano::thread_role::available_cpus ();
+	nano::thread_placement_config config;
+	config.enable = true;
+	config.roles[nano::thread_role::name::unknown] = "0";
+	if (available.empty ())
+	{
+		// Placement is rejected on platforms not supporting it
+		ASSERT_THROW (nano::thread_placement::apply (config), std::invalid_argument);
+		GTEST_SKIP ();
+	}
+	auto const cpu = available.back ();
+	config.roles[nano::thread_role::name::unknown] = std::to_string (cpu);
+
+	// Roles are only restricted when enabled
+	config.enable = false;
+	nano::thread_placement::apply (config);
+	ASSERT_TRUE (nano::thread_placement::cpus (nano::thread_role::name::unknown).empty ());
+
+	config.enable = true;
+	nano::thread_placement::apply (config);
+	ASSERT_EQ (nano::thread_placement::cpus (nano::thread_role::name::unknown), (std::vector<unsigned>{ cpu }));
+	ASSERT_TRUE (nano::thread_placement::cpus (nano::thread_role::name::io).empty ());
+	bool error = true;
+	std::thread thread ([&error] () {
+		error = nano::thread_placement::place (nano::thread_role::name::unknown);
+	});
+	thread.join ();
+	ASSERT_FALSE (error);
+
+	// CPUs the process may not run on are rejected, the previous placement is kept
+	config.roles[nano::thread_role::name::io] = "4096";
+	ASSERT_THROW (nano::thread_placement::apply (config), std::invalid_argument);
+	ASSERT_EQ (nano::thread_placement::cpus (nano::thread_role::name::unknown), (std::vector<unsigned>{ cpu }));
+}
@@ -235,6 +235,8 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ss << R"toml(
 	[node]
 	[node.backlog_scan]
+	[node.block_filter]
+	[node.memory_budget]
 	[node.bounded_backlog]
 	[node.bootstrap]
 	[node.bootstrap_server]
@@ -243,6 +245,7 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	[node.httpcallback]
 	[node.ipc.local]
 	[node.ipc.tcp]
+	[node.ipc.shared_memory]
 	[node.logging]
 	[node.statistics.log]
 	[node.statistics.sampling]
@@ -255,6 +258,8 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	[opencl]
 	[rpc]
 	[rpc.child_process]
+	[thread_placement]
+	[thread_placement.roles]
 	)toml";
 
 	nano::tomlconfig t;
@@ -273,6 +278,8 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.rpc.enable_sign_hash, defaults.rpc.enable_sign_hash);
 	ASSERT_EQ (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_EQ (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
+	ASSERT_EQ (conf.thread_placement.enable, defaults.thread_placement.enable);
+	ASSERT_EQ (conf.thread_placement.roles, defaults.thread_placement.roles);
 
 	ASSERT_EQ (conf.node.active_elections.size, defaults.node.active_elections.size);
 	ASSERT_EQ (conf.node.allow_local_peers, defaults.node.allow_local_peers);
@@ -293,6 +300,7 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.external_address, defaults.node.external_address);
 	ASSERT_EQ (conf.node.external_port, defaults.node.external_port);
 	ASSERT_EQ (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_EQ (conf.node.io_shards, defaults.node.io_shards);
 	ASSERT_EQ (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_EQ (conf.node.network_threads, defaults.node.network_threads);
 	ASSERT_EQ (conf.node.background_threads, defaults.node.background_threads);
@@ -323,11 +331,23 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.backlog_scan.enable, defaults.node.backlog_scan.enable);
 	ASSERT_EQ (conf.node.backlog_scan.batch_size, defaults.node.backlog_scan.batch_size);
 	ASSERT_EQ (conf.node.backlog_scan.rate_limit, defaults.node.backlog_scan.rate_limit);
+	ASSERT_EQ (conf.node.backlog_scan.max_tracked, defaults.node.backlog_scan.max_tracked);
+	ASSERT_EQ (conf.node.backlog_scan.tracked_interval, defaults.node.backlog_scan.tracked_interval);
+	ASSERT_EQ (conf.node.backlog_scan.full_scan_interval, defaults.node.backlog_scan.full_scan_interval);
+	ASSERT_EQ (conf.node.backlog_scan.deferred_settle, defaults.node.backlog_scan.deferred_settle);
 
 	ASSERT_EQ (conf.node.bounded_backlog.enable, defaults.node.bounded_backlog.enable);
 	ASSERT_EQ (conf.node.bounded_backlog.batch_size, defaults.node.bounded_backlog.batch_size);
 	ASSERT_EQ (conf.node.bounded_backlog.scan_rate, defaults.node.bounded_backlog.scan_rate);
 
+	ASSERT_EQ (conf.node.block_filter.enable, defaults.node.block_filter.enable);
+	ASSERT_EQ (conf.node.block_filter.bits_per_block, defaults.node.block_filter.bits_per_block);
+	ASSERT_EQ (conf.node.block_filter.headroom, defaults.node.block_filter.headroom);
+
+	ASSERT_EQ (conf.node.memory_budget.target, defaults.node.memory_budget.target);
+	ASSERT_EQ (conf.node.memory_budget.min_scale, defaults.node.memory_budget.min_scale);
+	ASSERT_EQ (conf.node.memory_budget.interval, defaults.node.memory_budget.interval);
+
 	ASSERT_EQ (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_EQ (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_EQ (conf.node.websocket_config.port, defaults.node.websocket_config.port);
@@ -340,11 +360,18 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.enabled, defaults.node.ipc_config.transport_domain.enabled);
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.io_timeout, defaults.node.ipc_config.transport_domain.io_timeout);
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.io_threads, defaults.node.ipc_config.transport_domain.io_threads);
+	ASSERT_EQ (conf.node.ipc_config.transport_domain.stream_buffer_size, defaults.node.ipc_config.transport_domain.stream_buffer_size);
 	ASSERT_EQ (conf.node.ipc_config.transport_domain.path, defaults.node.ipc_config.transport_domain.path);
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.enabled, defaults.node.ipc_config.transport_tcp.enabled);
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.io_timeout, defaults.node.ipc_config.transport_tcp.io_timeout);
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.io_threads, defaults.node.ipc_config.transport_tcp.io_threads);
+	ASSERT_EQ (conf.node.ipc_config.transport_tcp.stream_buffer_size, defaults.node.ipc_config.transport_tcp.stream_buffer_size);
 	ASSERT_EQ (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.allow_unsafe, defaults.node.ipc_config.transport_shared_memory.allow_unsafe);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.enabled, defaults.node.ipc_config.transport_shared_memory.enabled);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.io_timeout, defaults.node.ipc_config.transport_shared_memory.io_timeout);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.name, defaults.node.ipc_config.transport_shared_memory.name);
+	ASSERT_EQ (conf.node.ipc_config.transport_shared_memory.capacity, defaults.node.ipc_config.transport_shared_memory.capacity);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_EQ (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
 
@@ -369,6 +396,8 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
 	ASSERT_EQ (conf.node.rocksdb_config.read_cache, defaults.node.rocksdb_config.read_cache);
 	ASSERT_EQ (conf.node.rocksdb_config.write_cache, defaults.node.rocksdb_config.write_cache);
+	ASSERT_EQ (conf.node.rocksdb_config.block_compression, defaults.node.rocksdb_config.block_compression);
+	ASSERT_EQ (conf.node.rocksdb_config.block_compression_dictionary, defaults.node.rocksdb_config.block_compression_dictionary);
 
 	ASSERT_EQ (conf.node.optimistic_scheduler.enable, defaults.node.optimistic_scheduler.enable);
 	ASSERT_EQ (conf.node.optimistic_scheduler.gap_threshold, defaults.node.optimistic_scheduler.gap_threshold);
@@ -388,6 +417,8 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.block_processor.priority_live, defaults.node.block_processor.priority_live);
 	ASSERT_EQ (conf.node.block_processor.priority_bootstrap, defaults.node.block_processor.priority_bootstrap);
 	ASSERT_EQ (conf.node.block_processor.priority_local, defaults.node.block_processor.priority_local);
+	ASSERT_EQ (conf.node.block_processor.max_bulk_queue, defaults.node.block_processor.max_bulk_queue);
+	ASSERT_EQ (conf.node.block_processor.bulk_batch_size, defaults.node.block_processor.bulk_batch_size);
 
 	ASSERT_EQ (conf.node.vote_processor.max_pr_queue, defaults.node.vote_processor.max_pr_queue);
 	ASSERT_EQ (conf.node.vote_processor.max_non_pr_queue, defaults.node.vote_processor.max_non_pr_queue);
@@ -399,6 +430,9 @@ TEST (toml_config, daemon_config_deserialize_defaults)
 	ASSERT_EQ (conf.node.bootstrap.enable_database_scan, defaults.node.bootstrap.enable_database_scan);
 	ASSERT_EQ (conf.node.bootstrap.enable_dependency_walker, defaults.node.bootstrap.enable_dependency_walker);
 	ASSERT_EQ (conf.node.bootstrap.channel_limit, defaults.node.bootstrap.channel_limit);
+	ASSERT_EQ (conf.node.bootstrap.channel_limit_min, defaults.node.bootstrap.channel_limit_min);
+	ASSERT_EQ (conf.node.bootstrap.channel_limit_max, defaults.node.bootstrap.channel_limit_max);
+	ASSERT_EQ (conf.node.bootstrap.bulk_ingestion_threshold, defaults.node.bootstrap.bulk_ingestion_threshold);
 	ASSERT_EQ (conf.node.bootstrap.database_rate_limit, defaults.node.bootstrap.database_rate_limit);
 	ASSERT_EQ (conf.node.bootstrap.database_warmup_ratio, defaults.node.bootstrap.database_warmup_ratio);
 	ASSERT_EQ (conf.node.bootstrap.max_pull_count, defaults.node.bootstrap.max_pull_count);
@@ -461,6 +495,7 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	external_address = "0:0:0:0:0:ffff:7f01:101"
 	external_port = 999
 	io_threads = 999
+	io_shards = 999
 	lmdb_max_dbs = 999
 	network_threads = 999
 	background_threads = 999
@@ -493,6 +528,20 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	enable = false
 	batch_size = 999
 	rate_limit = 999
+	max_tracked = 999
+	tracked_interval = 999
+	full_scan_interval = 999
+	deferred_settle = 999
+
+	[node.block_filter]
+	enable = false
+	bits_per_block = 20
+	headroom = 999
+
+	[node.memory_budget]
+	target = 999
+	min_scale = 0.5
+	interval = 999
 
 	[node.bounded_backlog]
 	enable = false
@@ -506,6 +555,8 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	priority_live = 999
 	priority_bootstrap = 999
 	priority_local = 999
+	max_bulk_queue = 999
+	bulk_batch_size = 999
 
 	[node.active_elections]
 	size = 999
@@ -531,12 +582,21 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	io_timeout = 999
 	io_threads = 999
 	path = "/tmp/dev"
+	stream_buffer_size = 999
 
 	[node.ipc.tcp]
 	enable = true
 	io_timeout = 999
 	io_threads = 999
 	port = 999
+	stream_buffer_size = 999
+
+	[node.ipc.shared_memory]
+	allow_unsafe = true
+	capacity = 1024
+	enable = true
+	io_timeout = 999
+	name = "dev_ipc"
 
 	[node.ipc.flatbuffers]
 	skip_unexpected_fields_in_json = false
@@ -610,6 +670,9 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	io_threads = 99
 	read_cache = 99
 	write_cache = 99
+	block_compression = ")toml"
+	   << (nano::rocksdb_config::zstd_supported () ? "zstd" : "none") << R"toml("
+	block_compression_dictionary = 99
 
 	[node.experimental]
 	secondary_work_peers = ["dev.org:998"]
@@ -633,6 +696,9 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	enable_database_scan = true
 	enable_dependency_walker = false
 	channel_limit = 999
+	channel_limit_min = 999
+	channel_limit_max = 999
+	bulk_ingestion_threshold = 999
 	database_rate_limit = 999
 	database_warmup_ratio = 999
 	max_pull_count = 999
@@ -687,6 +753,13 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	[rpc.child_process]
 	enable = true
 	rpc_path = "/dev/nano_rpc"
+
+	[thread_placement]
+	enable = true
+
+	[thread_placement.roles]
+	io = "0"
+	block_processing = "0-1"
 	)toml";
 
 	nano::tomlconfig toml;
@@ -705,6 +778,8 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.rpc.enable_sign_hash, defaults.rpc.enable_sign_hash);
 	ASSERT_NE (conf.rpc.child_process.enable, defaults.rpc.child_process.enable);
 	ASSERT_NE (conf.rpc.child_process.rpc_path, defaults.rpc.child_process.rpc_path);
+	ASSERT_NE (conf.thread_placement.enable, defaults.thread_placement.enable);
+	ASSERT_NE (conf.thread_placement.roles, defaults.thread_placement.roles);
 
 	ASSERT_NE (conf.node.active_elections.size, defaults.node.active_elections.size);
 	ASSERT_NE (conf.node.allow_local_peers, defaults.node.allow_local_peers);
@@ -725,6 +800,7 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.external_address, defaults.node.external_address);
 	ASSERT_NE (conf.node.external_port, defaults.node.external_port);
 	ASSERT_NE (conf.node.io_threads, defaults.node.io_threads);
+	ASSERT_NE (conf.node.io_shards, defaults.node.io_shards);
 	ASSERT_NE (conf.node.max_work_generate_multiplier, defaults.node.max_work_generate_multiplier);
 	ASSERT_NE (conf.node.max_unchecked_blocks, defaults.node.max_unchecked_blocks);
 	ASSERT_NE (conf.node.max_backlog, defaults.node.max_backlog);
@@ -757,11 +833,23 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.backlog_scan.enable, defaults.node.backlog_scan.enable);
 	ASSERT_NE (conf.node.backlog_scan.batch_size, defaults.node.backlog_scan.batch_size);
 	ASSERT_NE (conf.node.backlog_scan.rate_limit, defaults.node.backlog_scan.rate_limit);
+	ASSERT_NE (conf.node.backlog_scan.max_tracked, defaults.node.backlog_scan.max_tracked);
+	ASSERT_NE (conf.node.backlog_scan.tracked_interval, defaults.node.backlog_scan.tracked_interval);
+	ASSERT_NE (conf.node.backlog_scan.full_scan_interval, defaults.node.backlog_scan.full_scan_interval);
+	ASSERT_NE (conf.node.backlog_scan.deferred_settle, defaults.node.backlog_scan.deferred_settle);
 
 	ASSERT_NE (conf.node.bounded_backlog.enable, defaults.node.bounded_backlog.enable);
 	ASSERT_NE (conf.node.bounded_backlog.batch_size, defaults.node.bounded_backlog.batch_size);
 	ASSERT_NE (conf.node.bounded_backlog.scan_rate, defaults.node.bounded_backlog.scan_rate);
 
+	ASSERT_NE (conf.node.block_filter.enable, defaults.node.block_filter.enable);
+	ASSERT_NE (conf.node.block_filter.bits_per_block, defaults.node.block_filter.bits_per_block);
+	ASSERT_NE (conf.node.block_filter.headroom, defaults.node.block_filter.headroom);
+
+	ASSERT_NE (conf.node.memory_budget.target, defaults.node.memory_budget.target);
+	ASSERT_NE (conf.node.memory_budget.min_scale, defaults.node.memory_budget.min_scale);
+	ASSERT_NE (conf.node.memory_budget.interval, defaults.node.memory_budget.interval);
+
 	ASSERT_NE (conf.node.websocket_config.enabled, defaults.node.websocket_config.enabled);
 	ASSERT_NE (conf.node.websocket_config.address, defaults.node.websocket_config.address);
 	ASSERT_NE (conf.node.websocket_config.port, defaults.node.websocket_config.port);
@@ -774,11 +862,18 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.ipc_config.transport_domain.enabled, defaults.node.ipc_config.transport_domain.enabled);
 	ASSERT_NE (conf.node.ipc_config.transport_domain.io_timeout, defaults.node.ipc_config.transport_domain.io_timeout);
 	ASSERT_NE (conf.node.ipc_config.transport_domain.io_threads, defaults.node.ipc_config.transport_domain.io_threads);
+	ASSERT_NE (conf.node.ipc_config.transport_domain.stream_buffer_size, defaults.node.ipc_config.transport_domain.stream_buffer_size);
 	ASSERT_NE (conf.node.ipc_config.transport_domain.path, defaults.node.ipc_config.transport_domain.path);
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.enabled, defaults.node.ipc_config.transport_tcp.enabled);
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.io_timeout, defaults.node.ipc_config.transport_tcp.io_timeout);
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.io_threads, defaults.node.ipc_config.transport_tcp.io_threads);
+	ASSERT_NE (conf.node.ipc_config.transport_tcp.stream_buffer_size, defaults.node.ipc_config.transport_tcp.stream_buffer_size);
 	ASSERT_NE (conf.node.ipc_config.transport_tcp.port, defaults.node.ipc_config.transport_tcp.port);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.allow_unsafe, defaults.node.ipc_config.transport_shared_memory.allow_unsafe);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.enabled, defaults.node.ipc_config.transport_shared_memory.enabled);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.io_timeout, defaults.node.ipc_config.transport_shared_memory.io_timeout);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.name, defaults.node.ipc_config.transport_shared_memory.name);
+	ASSERT_NE (conf.node.ipc_config.transport_shared_memory.capacity, defaults.node.ipc_config.transport_shared_memory.capacity);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json, defaults.node.ipc_config.flatbuffers.skip_unexpected_fields_in_json);
 	ASSERT_NE (conf.node.ipc_config.flatbuffers.verify_buffers, defaults.node.ipc_config.flatbuffers.verify_buffers);
 
@@ -804,6 +899,11 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.rocksdb_config.io_threads, defaults.node.rocksdb_config.io_threads);
 	ASSERT_NE (conf.node.rocksdb_config.read_cache, defaults.node.rocksdb_config.read_cache);
 	ASSERT_NE (conf.node.rocksdb_config.write_cache, defaults.node.rocksdb_config.write_cache);
+	if (nano::rocksdb_config::zstd_supported ())
+	{
+		ASSERT_NE (conf.node.rocksdb_config.block_compression, defaults.node.rocksdb_config.block_compression);
+	}
+	ASSERT_NE (conf.node.rocksdb_config.block_compression_dictionary, defaults.node.rocksdb_config.block_compression_dictionary);
 
 	ASSERT_NE (conf.node.optimistic_scheduler.enable, defaults.node.optimistic_scheduler.enable);
 	ASSERT_NE (conf.node.optimistic_scheduler.gap_threshold, defaults.node.optimistic_scheduler.gap_threshold);
@@ -823,6 +923,8 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.block_processor.priority_live, defaults.node.block_processor.priority_live);
 	ASSERT_NE (conf.node.block_processor.priority_bootstrap, defaults.node.block_processor.priority_bootstrap);
 	ASSERT_NE (conf.node.block_processor.priority_local, defaults.node.block_processor.priority_local);
+	ASSERT_NE (conf.node.block_processor.max_bulk_queue, defaults.node.block_processor.max_bulk_queue);
+	ASSERT_NE (conf.node.block_processor.bulk_batch_size, defaults.node.block_processor.bulk_batch_size);
 
 	ASSERT_NE (conf.node.vote_processor.max_pr_queue, defaults.node.vote_processor.max_pr_queue);
 	ASSERT_NE (conf.node.vote_processor.max_non_pr_queue, defaults.node.vote_processor.max_non_pr_queue);
@@ -835,6 +937,9 @@ TEST (toml_config, daemon_config_deserialize_no_defaults)
 	ASSERT_NE (conf.node.bootstrap.enable_frontier_scan, defaults.node.bootstrap.enable_frontier_scan);
 	ASSERT_NE (conf.node.bootstrap.enable_dependency_walker, defaults.node.bootstrap.enable_dependency_walker);
 	ASSERT_NE (conf.node.bootstrap.channel_limit, defaults.node.bootstrap.channel_limit);
+	ASSERT_NE (conf.node.bootstrap.channel_limit_min, defaults.node.bootstrap.channel_limit_min);
+	ASSERT_NE (conf.node.bootstrap.channel_limit_max, defaults.node.bootstrap.channel_limit_max);
+	ASSERT_NE (conf.node.bootstrap.bulk_ingestion_threshold, defaults.node.bootstrap.bulk_ingestion_threshold);
 	ASSERT_NE (conf.node.bootstrap.database_rate_limit, defaults.node.bootstrap.database_rate_limit);
 	ASSERT_NE (conf.node.bootstrap.database_warmup_ratio, defaults.node.bootstrap.database_warmup_ratio);
 	ASSERT_NE (conf.node.bootstrap.max_pull_count, defaults.node.bootstrap.max_pull_count);
@@ -884,6 +989,7 @@ TEST (toml_config, daemon_config_no_required)
 	[node.httpcallback]
 	[node.ipc.local]
 	[node.ipc.tcp]
+	[node.ipc.shared_memory]
 	[node.logging]
 	[node.statistics.log]
 	[node.statistics.sampling]
@@ -892,6 +998,8 @@ TEST (toml_config, daemon_config_no_required)
 	[opencl]
 	[rpc]
 	[rpc.child_process]
+	[thread_placement]
+	[thread_placement.roles]
 	)toml";
 
 	nano::tomlconfig toml;
@@ -999,6 +1107,21 @@ TEST (toml_config, daemon_config_deserialize_errors)
 
 		ASSERT_EQ (toml.get_error ().get_message (), "bootstrap_frontier_request_count must be greater than or equal to 1024");
 	}
+	if (!nano::rocksdb_config::zstd_supported ())
+	{
+		std::stringstream ss;
+		ss << R"toml(
+		[node.rocksdb]
+		block_compression = "zstd"
+		)toml";
+
+		nano::tomlconfig toml;
+		toml.read (ss);
+		nano::daemon_config conf;
+		conf.deserialize_toml (toml);
+
+		ASSERT_EQ (toml.get_error ().get_message (), "block_compression zstd requires a node built with NANO_ROCKSDB_ZSTD");
+	}
 }
 
 TEST (toml_config, daemon_read_config)
@@ -1069,6 +1192,8 @@ TEST (toml_config, log_config_defaults)
 	ASSERT_EQ (confg.file.enable, defaults.file.enable);
 	ASSERT_EQ (confg.file.max_size, defaults.file.max_size);
 	ASSERT_EQ (confg.file.rotation_count, defaults.file.rotation_count);
+	ASSERT_EQ (confg.async.enable, defaults.async.enable);
+	ASSERT_EQ (confg.async.buffer_size, defaults.async.buffer_size);
 }
 
 TEST (toml_config, log_config_no_defaults)
@@ -1090,6 +1215,10 @@ TEST (toml_config, log_config_no_defaults)
 	max_size = 999
 	rotation_count = 999
 
+	[log.async]
+	enable = true
+	buffer_size = 999
+
 	[log.levels]
 	active_elections = "trace"
 	block_processor = "trace"
@@ -1111,6 +1240,8 @@ TEST (toml_config, log_config_no_defaults)
 	ASSERT_NE (confg.file.enable, defaults.file.enable);
 	ASSERT_NE (confg.file.max_size, defaults.file.max_size);
 	ASSERT_NE (confg.file.rotation_count, defaults.file.rotation_count);
+	ASSERT_NE (confg.async.enable, defaults.async.enable);
+	ASSERT_NE (confg.async.buffer_size, defaults.async.buffer_size);
 }
 
 TEST (toml_config, log_config_no_required)
@@ -1122,6 +1253,7 @@ TEST (toml_config, log_config_no_required)
 	[log]
 	[log.console]
 	[log.file]
+	[log.async]
 	[log.levels]
 	)toml";
 
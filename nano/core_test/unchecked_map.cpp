@@ -280,3 +280,61 @@ TEST (unchecked, multiple_get)
 	auto unchecked5 = unchecked.get (block2->hash ());
 	ASSERT_EQ (unchecked5.size (), 0);
 }
+
+TEST (unchecked_map, trigger_batch)
+{
+	context context;
+	auto & unchecked = context.unchecked;
+	std::atomic<int> satisfied{ 0 };
+	unchecked.satisfied.add ([&satisfied] (nano::unchecked_info const &) { ++satisfied; });
+	unchecked.start ();
+
+	nano::unchecked_info info{ block () };
+	unchecked.put (nano::block_hash{ 1 }, info);
+	unchecked.put (nano::block_hash{ 2 }, info);
+	unchecked.put (nano::block_hash{ 3 }, info);
+	ASSERT_EQ (3, unchecked.count ());
+
+	unchecked.trigger ({ nano::block_hash{ 1 }, nano::block_hash{ 2 }, nano::block_hash{ 4 } });
+	ASSERT_TIMELY_EQ (5s, satisfied, 2);
+	ASSERT_TIMELY_EQ (5s, unchecked.count (), 1);
+	ASSERT_FALSE (unchecked.get (nano::block_hash{ 3 }).empty ());
+	ASSERT_EQ (3, context.stats.count (nano::stat::type::unchecked, nano::stat::detail::trigger));
+
+	unchecked.stop ();
+}
+
+// Large maps are split into shards, each evicting its own oldest entries
+TEST (unchecked_map, sharded_eviction)
+{
+	nano::test::system system;
+	auto const max = nano::unchecked_map::shard_min_size * 4;
+	nano::unchecked_map unchecked{ static_cast<unsigned> (max), system.stats, false };
+	nano::unchecked_info info{ block () };
+
+	std::vector<nano::block_hash> dependencies;
+	for (size_t n = 0; n < max * 2; ++n)
+	{
+		dependencies.push_back (nano::test::random_hash ());
+		unchecked.put (dependencies.back (), info);
+	}
+	ASSERT_EQ (unchecked.count (), max);
+	ASSERT_FALSE (unchecked.get (dependencies.back ()).empty ());
+	ASSERT_TRUE (unchecked.get (dependencies.front ()).empty ());
+}
+
+// Callbacks are invoked without holding locks, so they can modify the map
+TEST (unchecked_map, for_each_modify)
+{
+	context context;
+	auto & unchecked = context.unchecked;
+	nano::unchecked_info info{ block () };
+	for (uint64_t n = 1; n <= 10; ++n)
+	{
+		unchecked.put (nano::block_hash{ n }, info);
+	}
+	unchecked.for_each ([&unchecked] (nano::unchecked_key const & key, nano::unchecked_info const &) {
+		unchecked.del (key);
+	});
+	ASSERT_EQ (0, unchecked.count ());
+}
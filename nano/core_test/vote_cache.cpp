@@ -345,6 +345,39 @@ TEST (vote_cache, overfill_entry)
 	ASSERT_EQ (1, vote_cache.size ());
 }
 
+/*
+ * Once an entry is full, votes from higher weight representatives replace the lowest weight voter
+ */
+TEST (vote_cache, entry_replace_lowest_weight)
+{
+	auto hash = nano::test::random_hash ();
+	nano::vote_cache_entry entry{ hash };
+	std::size_t const max_voters = 4;
+	nano::keypair rep1, rep2, rep3, rep4;
+	ASSERT_TRUE (entry.vote (nano::test::make_vote (rep1, { hash }, 1), 30, max_voters));
+	ASSERT_TRUE (entry.vote (nano::test::make_vote (rep2, { hash }, 1), 10, max_voters));
+	ASSERT_TRUE (entry.vote (nano::test::make_vote (rep3, { hash }, 1), 20, max_voters));
+	ASSERT_EQ (entry.size (), 3);
+	ASSERT_EQ (entry.tally (), 60);
+
+	// Reaching the limit drops the lowest weight voter
+	ASSERT_TRUE (entry.vote (nano::test::make_vote (rep4, { hash }, 1), 40, max_voters));
+	ASSERT_EQ (entry.size (), 3);
+	ASSERT_EQ (entry.tally (), 90);
+	auto votes = entry.votes ();
+	ASSERT_TRUE (std::none_of (votes.begin (), votes.end (), [&rep2] (auto const & vote) { return vote->account == rep2.pub; }));
+
+	// Lower weight than every voter, dropped right away
+	entry.vote (nano::test::make_vote (rep2, { hash }, 2), 5, max_voters);
+	ASSERT_EQ (entry.size (), 3);
+	ASSERT_EQ (entry.tally (), 90);
+
+	// Newer final vote from an existing voter only updates the final tally
+	ASSERT_TRUE (entry.vote (nano::test::make_vote (rep1, { hash }, nano::vote::timestamp_max, nano::vote::duration_max), 30, max_voters));
+	ASSERT_EQ (entry.tally (), 90);
+	ASSERT_EQ (entry.final_tally (), 30);
+}
+
 TEST (vote_cache, age_cutoff)
 {
 	nano::test::system system;
@@ -379,4 +412,97 @@ TEST (vote_cache, age_cutoff)
 
 	// After 3 seconds the entry should be removed
 	ASSERT_TIMELY (5s, vote_cache.top (0).empty ());
-}
\ No newline at end of file
+}
+
+/*
+ * Large caches are split into shards, each evicting its own oldest entries
+ */
+TEST (vote_cache, sharded)
+{
+	nano::test::system system;
+	nano::vote_cache_config cfg;
+	cfg.max_size = nano::vote_cache::shard_min_size * 4;
+	nano::vote_cache vote_cache{ cfg, system.stats };
+	vote_cache.rep_weight_query = rep_weight_query ();
+	auto rep1 = create_rep (7);
+
+	std::vector<nano::block_hash> hashes;
+	for (std::size_t n = 0; n < cfg.max_size * 2; ++n)
+	{
+		hashes.push_back (nano::test::random_hash ());
+		vote_cache.insert (nano::test::make_vote (rep1, { hashes.back () }, 1024 * 1024));
+	}
+	ASSERT_EQ (vote_cache.size (), cfg.max_size);
+	// The newest entry is always kept, the oldest one must be evicted after the cache overflowed twice
+	ASSERT_TRUE (vote_cache.contains (hashes.back ()));
+	ASSERT_FALSE (vote_cache.contains (hashes.front ()));
+}
+
+/*
+ * The ranking only tracks a bounded number of the highest tallies, top () still returns every entry above the minimum tally
+ */
+TEST (vote_cache, top_bounded)
+{
+	nano::test::system system;
+	nano::vote_cache_config cfg;
+	nano::vote_cache vote_cache{ cfg, system.stats };
+	vote_cache.rep_weight_query = rep_weight_query ();
+
+	int const count = nano::vote_cache::top_max * 2;
+	std::vector<nano::block_hash> hashes;
+	for (int n = 0; n < count; ++n)
+	{
+		auto rep = create_rep (n + 1);
+		hashes.push_back (nano::test::random_hash ());
+		vote_cache.insert (nano::test::make_vote (rep, { hashes.back () }, 1024 * 1024));
+	}
+	ASSERT_EQ (vote_cache.size (), count);
+
+	auto tops = vote_cache.top (0);
+	ASSERT_EQ (tops.size (), count);
+	ASSERT_EQ (tops.front ().tally, count);
+	ASSERT_EQ (tops.back ().tally, 1);
+	// Entries left out of the ranking require scanning the shards
+	ASSERT_EQ (system.stats.count (nano::stat::type::vote_cache, nano::stat::detail::top_scan), 1);
+
+	// Erased entries are removed from the results
+	ASSERT_TRUE (vote_cache.erase (hashes.back ()));
+	tops = vote_cache.top (0);
+	ASSERT_EQ (tops.size (), count - 1);
+	ASSERT_EQ (tops.front ().tally, count - 1);
+
+	// An entry outside of the ranking enters it once its tally grows
+	auto rep = create_rep (count * 2);
+	vote_cache.insert (nano::test::make_vote (rep, { hashes.front () }, 1024 * 1024));
+	tops = vote_cache.top (0);
+	ASSERT_EQ (tops.front ().hash, hashes.front ());
+	ASSERT_EQ (tops.front ().tally, count * 2 + 1);
+}
+
+/*
+ * Requests above every tally left out of the ranking are served from the ranking alone
+ */
+TEST (vote_cache, top_ranked)
+{
+	nano::test::system system;
+	nano::vote_cache_config cfg;
+	nano::vote_cache vote_cache{ cfg, system.stats };
+	vote_cache.rep_weight_query = rep_weight_query ();
+
+	// Tallies must differ in their upper 64 bits to be told apart by the ranking threshold
+	nano::uint128_t const unit{ nano::uint128_t{ 1 } << 64 };
+	int const count = nano::vote_cache::top_max + 1;
+	for (int n = 0; n < count; ++n)
+	{
+		auto rep = create_rep (unit * (n + 1));
+		vote_cache.insert (nano::test::make_vote (rep, { nano::test::random_hash () }, 1024 * 1024));
+	}
+
+	auto tops = vote_cache.top (unit * 2);
+	ASSERT_EQ (tops.size (), nano::vote_cache::top_max);
+	ASSERT_EQ (tops.back ().tally, unit * 2);
+	ASSERT_EQ (system.stats.count (nano::stat::type::vote_cache, nano::stat::detail::top_scan), 0);
+
+	ASSERT_EQ (vote_cache.top (unit).size (), count);
+	ASSERT_EQ (system.stats.count (nano::stat::type::vote_cache, nano::stat::detail::top_scan), 1);
+}
@@ -107,7 +107,12 @@ TEST (vote_generator, multiple_representatives)
 			return vote_a->account == account;
 		}));
 		ASSERT_NE (votes.end (), existing);
+		// Signed in parallel, each with its own key
+		ASSERT_FALSE ((*existing)->validate ());
 	}
+	ASSERT_GT (node.stats.count (nano::stat::type::vote_generator, nano::stat::detail::generator_signed_parallel), 0);
+	// Locally generated votes are not verified again
+	ASSERT_GT (node.stats.count (nano::stat::type::vote_processor, nano::stat::detail::verification_skipped), 0);
 }
 
 TEST (vote_spacing, basic)
@@ -1103,6 +1103,45 @@ TEST (wallet, foreach_representative_deadlock)
 	ASSERT_TRUE (set);
 }
 
+/**
+ * Voting keys are cached, the cache follows wallet lock state and key changes
+ */
+TEST (wallet, foreach_representative_cache)
+{
+	nano::test::system system (1);
+	auto & node (*system.nodes[0]);
+	auto wallet = system.wallet (0);
+	wallet->insert_adhoc (nano::dev::genesis_key.prv);
+	node.wallets.compute_reps ();
+
+	auto representatives = [&node] () {
+		std::vector<std::pair<nano::public_key, nano::raw_key>> result;
+		node.wallets.foreach_representative ([&result] (nano::public_key const & pub, nano::raw_key const & prv) {
+			result.emplace_back (pub, prv);
+		});
+		return result;
+	};
+	auto reps = representatives ();
+	ASSERT_EQ (1, reps.size ());
+	ASSERT_EQ (nano::dev::genesis_key.pub, reps[0].first);
+	ASSERT_EQ (nano::dev::genesis_key.prv, reps[0].second);
+
+	wallet->store.lock ();
+	ASSERT_TRUE (representatives ().empty ());
+
+	{
+		auto transaction (node.wallets.tx_begin_write ());
+		ASSERT_FALSE (wallet->enter_password (transaction, ""));
+	}
+	ASSERT_EQ (1, representatives ().size ());
+
+	{
+		auto transaction (node.wallets.tx_begin_write ());
+		wallet->store.erase (transaction, nano::dev::genesis_key.pub);
+	}
+	ASSERT_TRUE (representatives ().empty ());
+}
+
 TEST (wallet, search_receivable)
 {
 	nano::test::system system;
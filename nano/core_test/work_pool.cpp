@@ -3,6 +3,7 @@
 #include <nano/lib/logging.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/lib/work_version.hpp>
 #include <nano/node/openclconfig.hpp>
 #include <nano/node/openclwork.hpp>
@@ -201,3 +202,47 @@ TEST (work, eco_pow)
 	// It's possible under some unlucky circumstances that this fails to the random nature of valid work generation.
 	ASSERT_LT (future1.get (), future2.get ());
 }
+
+// every kernel supported by this machine must produce the same values as the reference blake2b implementation
+TEST (work, kernels)
+{
+	auto kernels = nano::work_kernel::supported ();
+	ASSERT_FALSE (kernels.empty ());
+	ASSERT_EQ (kernels.back (), &nano::work_kernel::scalar ());
+	ASSERT_EQ (kernels.front (), &nano::work_kernel::select ());
+	for (auto kernel : kernels)
+	{
+		for (int n = 0; n < 100; ++n)
+		{
+			nano::root root;
+			nano::random_pool::generate_block (root.bytes.data (), root.bytes.size ());
+			nano::work_kernel::lanes_t nonces;
+			nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (nonces.data ()), sizeof (nonces));
+			nano::work_kernel::lanes_t values;
+			kernel->values (root, nonces, values);
+			for (std::size_t lane = 0; lane < nano::work_kernel::lanes; ++lane)
+			{
+				ASSERT_EQ (values[lane], nano::dev::network_params.work.value (root, nonces[lane])) << kernel->name;
+			}
+		}
+	}
+}
+
+// batched work values match single evaluation, including a partially filled last batch
+TEST (work, values_batch)
+{
+	std::size_t const count = 3 * nano::work_kernel::lanes + 5;
+	std::vector<nano::root> roots (count);
+	std::vector<uint64_t> works (count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		nano::random_pool::generate_block (roots[i].bytes.data (), roots[i].bytes.size ());
+		nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (&works[i]), sizeof (works[i]));
+	}
+	std::vector<uint64_t> values (count);
+	nano::dev::network_params.work.values (roots, works, values);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		ASSERT_EQ (values[i], nano::dev::network_params.work.value (roots[i], works[i]));
+	}
+}
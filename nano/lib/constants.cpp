@@ -5,6 +5,7 @@
 #include <nano/lib/constants.hpp>
 #include <nano/lib/env.hpp>
 #include <nano/lib/logging.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/lib/work_version.hpp>
 
 namespace
@@ -91,11 +92,34 @@ uint64_t nano::work_thresholds::value (nano::root const & root_a, uint64_t work_
 	blake2b_final (&hash, reinterpret_cast<uint8_t *> (&result), sizeof (result));
 	return result;
 }
+
+void nano::work_thresholds::values (std::span<nano::root const> roots, std::span<uint64_t const> works, std::span<uint64_t> results) const
+{
+	debug_assert (roots.size () == works.size () && works.size () == results.size ());
+	auto const & kernel = nano::work_kernel::select ();
+	nano::work_kernel::roots_t roots_l{};
+	nano::work_kernel::lanes_t works_l{};
+	nano::work_kernel::lanes_t results_l;
+	for (std::size_t i = 0; i < roots.size (); i += nano::work_kernel::lanes)
+	{
+		// The last batch is padded with the roots and works already in the lanes, their values are discarded
+		auto const count = std::min (nano::work_kernel::lanes, roots.size () - i);
+		std::copy_n (roots.begin () + i, count, roots_l.begin ());
+		std::copy_n (works.begin () + i, count, works_l.begin ());
+		kernel.values (roots_l, works_l, results_l);
+		std::copy_n (results_l.begin (), count, results.begin () + i);
+	}
+}
 #else
 uint64_t nano::work_thresholds::value (nano::root const & root_a, uint64_t work_a) const
 {
 	return base + 1;
 }
+
+void nano::work_thresholds::values (std::span<nano::root const> roots, std::span<uint64_t const> works, std::span<uint64_t> results) const
+{
+	std::fill (results.begin (), results.end (), base + 1);
+}
 #endif
 
 uint64_t nano::work_thresholds::threshold (nano::block_details const & details_a) const
@@ -4,6 +4,7 @@
 #include <nano/lib/fwd.hpp>
 
 #include <chrono>
+#include <span>
 #include <string_view>
 
 namespace nano
@@ -57,6 +58,8 @@ public:
 	uint64_t threshold (nano::work_version const, nano::block_details const) const;
 	uint64_t threshold_base (nano::work_version const) const;
 	uint64_t value (nano::root const & root_a, uint64_t work_a) const;
+	/** Computes the work values of many (root, work) pairs into \p results , several at a time with the fastest CPU work kernel */
+	void values (std::span<nano::root const> roots, std::span<uint64_t const> works, std::span<uint64_t> results) const;
 	double normalized_multiplier (double const, uint64_t const) const;
 	double denormalized_multiplier (double const, uint64_t const) const;
 	uint64_t difficulty (nano::work_version const, nano::root const &, uint64_t const) const;
@@ -143,6 +143,24 @@ public:
 		return entries_m;
 	}
 
+	/**
+	 * Approximate memory used by the entries of this container and all subcontainers in bytes
+	 * Only accounts for the size of the elements, not the overhead of the container or memory owned by the elements
+	 */
+	std::size_t memory_usage () const
+	{
+		std::size_t result = 0;
+		for (auto const & entry : entries_m)
+		{
+			result += entry.size * entry.sizeof_element;
+		}
+		for (auto const & [name, child] : children_m)
+		{
+			result += child.memory_usage ();
+		}
+		return result;
+	}
+
 public:
 	// Needed to convert to legacy container_info_component during transition period
 	std::unique_ptr<nano::container_info_component> to_legacy (std::string const & name) const
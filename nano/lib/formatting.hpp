@@ -2,6 +2,7 @@
 
 #include <nano/lib/common.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/stats_enums.hpp>
 
 #include <fmt/ostream.h>
 
@@ -59,3 +60,34 @@ template <>
 struct fmt::formatter<nano::root> : fmt::formatter<nano::hash_or_account>
 {
 };
+
+namespace nano
+{
+/** Formats stat enums by name, passing the enums instead of their names lets the async logger defer formatting */
+template <class Enum>
+struct stat_enum_formatter : fmt::formatter<std::string_view>
+{
+	template <class FormatContext>
+	auto format (Enum value, FormatContext & ctx) const
+	{
+		return fmt::formatter<std::string_view>::format (nano::to_string (value), ctx);
+	}
+};
+}
+
+template <>
+struct fmt::formatter<nano::stat::type> : nano::stat_enum_formatter<nano::stat::type>
+{
+};
+template <>
+struct fmt::formatter<nano::stat::detail> : nano::stat_enum_formatter<nano::stat::detail>
+{
+};
+template <>
+struct fmt::formatter<nano::stat::dir> : nano::stat_enum_formatter<nano::stat::dir>
+{
+};
+template <>
+struct fmt::formatter<nano::stat::sample> : nano::stat_enum_formatter<nano::stat::sample>
+{
+};
@@ -6,12 +6,14 @@
 #include <nano/lib/asio.hpp>
 #include <nano/lib/ipc.hpp>
 #include <nano/lib/ipc_client.hpp>
+#include <nano/lib/ipc_shared_memory.hpp>
 
 #include <boost/endian/conversion.hpp>
 #include <boost/polymorphic_cast.hpp>
 
 #include <deque>
 #include <future>
+#include <thread>
 
 namespace
 {
@@ -357,3 +359,72 @@ std::string nano::ipc::request (nano::ipc::payload_encoding encoding_a, nano::ip
 
 	return result_l.get_future ().get ();
 }
+
+nano::ipc::shm_client::shm_client () = default;
+
+nano::ipc::shm_client::~shm_client () = default;
+
+nano::error nano::ipc::shm_client::connect (std::string const & name_a)
+{
+	nano::error result;
+	try
+	{
+		channel = nano::ipc::shm_channel::open (name_a);
+	}
+	catch (boost::interprocess::interprocess_exception const & ex)
+	{
+		result = nano::error (std::string ("Could not open shared memory segment: ") + ex.what ());
+	}
+	return result;
+}
+
+nano::error nano::ipc::shm_client::write (nano::ipc::payload_encoding encoding_a, uint8_t const * data_a, std::size_t size_a, std::chrono::milliseconds timeout_a)
+{
+	if (!channel)
+	{
+		return nano::error ("Not connected");
+	}
+
+	frame = get_preamble (encoding_a);
+	frame.insert (frame.end (), data_a, data_a + size_a);
+
+	auto const deadline = std::chrono::steady_clock::now () + timeout_a;
+	while (channel->requests ().write (frame.data (), frame.size ()))
+	{
+		if (std::chrono::steady_clock::now () > deadline)
+		{
+			return nano::error ("Request ring is full");
+		}
+		std::this_thread::sleep_for (std::chrono::milliseconds (1));
+	}
+	return nano::error{};
+}
+
+nano::error nano::ipc::shm_client::write (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a, std::chrono::milliseconds timeout_a)
+{
+	return write (nano::ipc::payload_encoding::flatbuffers, flatbuffer_a->GetBufferPointer (), flatbuffer_a->GetSize (), timeout_a);
+}
+
+nano::error nano::ipc::shm_client::read (std::vector<uint8_t> & buffer_a, std::chrono::milliseconds timeout_a)
+{
+	if (!channel)
+	{
+		return nano::error ("Not connected");
+	}
+	if (channel->replies ().read (buffer_a, timeout_a))
+	{
+		return nano::error ("Timed out waiting for reply");
+	}
+	return nano::error{};
+}
+
+std::string nano::ipc::request (nano::ipc::payload_encoding encoding_a, nano::ipc::shm_client & shm_client, std::string const & rpc_action_a)
+{
+	std::string result;
+	std::vector<uint8_t> reply;
+	if (!shm_client.write (encoding_a, reinterpret_cast<uint8_t const *> (rpc_action_a.data ()), rpc_action_a.size ()) && !shm_client.read (reply, std::chrono::seconds (15)))
+	{
+		result.assign (reply.begin (), reply.end ());
+	}
+	return result;
+}
@@ -17,6 +17,8 @@ namespace nano
 class shared_const_buffer;
 namespace ipc
 {
+	class shm_channel;
+
 	class ipc_client_impl
 	{
 	public:
@@ -63,9 +65,41 @@ namespace ipc
 		std::unique_ptr<ipc_client_impl> impl;
 	};
 
+	/**
+	 * Client for the node's shared memory transport, for consumers running on the same host as the node.
+	 * Requests are the usual preamble followed by the payload. Replies and subscription events are read as whole frames, without a length prefix.
+	 * @note Not thread safe, use one instance per consumer thread
+	 */
+	class shm_client final
+	{
+	public:
+		shm_client ();
+		~shm_client ();
+
+		/** Attach to the shared memory segment named in the node's ipc.shared_memory config. Replaces any previously attached client. */
+		nano::error connect (std::string const & name_a);
+
+		/** Write a request, waiting at most \p timeout_a for space in the request ring */
+		nano::error write (nano::ipc::payload_encoding encoding_a, uint8_t const * data_a, std::size_t size_a, std::chrono::milliseconds timeout_a = std::chrono::seconds (5));
+
+		/** Write a Flatbuffers request */
+		nano::error write (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a, std::chrono::milliseconds timeout_a = std::chrono::seconds (5));
+
+		/** Read the next reply or event into \p buffer_a, waiting at most \p timeout_a */
+		nano::error read (std::vector<uint8_t> & buffer_a, std::chrono::milliseconds timeout_a);
+
+	private:
+		std::unique_ptr<nano::ipc::shm_channel> channel;
+		/** Request frame, reused between writes */
+		std::vector<uint8_t> frame;
+	};
+
 	/** Convenience function for making synchronous IPC calls. The client must be connected */
 	std::string request (nano::ipc::payload_encoding encoding_a, nano::ipc::ipc_client & ipc_client, std::string const & rpc_action_a);
 
+	/** Convenience function for making synchronous IPC calls over shared memory. The client must be connected */
+	std::string request (nano::ipc::payload_encoding encoding_a, nano::ipc::shm_client & shm_client, std::string const & rpc_action_a);
+
 	/**
 	 * Returns a buffer with an IPC preamble for the given \p encoding_a
 	 */
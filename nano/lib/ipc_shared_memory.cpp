@@ -0,0 +1,330 @@
+#include <nano/lib/assert.hpp>
+#include <nano/lib/ipc_shared_memory.hpp>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <optional>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+#endif
+
+namespace
+{
+/** Length value marking the unused end of the data area, the next frame starts at the beginning */
+uint32_t constexpr padding_marker = std::numeric_limits<uint32_t>::max ();
+
+std::size_t constexpr round_up (std::size_t value, std::size_t alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+std::size_t constexpr frame_size (std::size_t payload)
+{
+	return round_up (sizeof (uint32_t) + payload, 8);
+}
+
+std::size_t constexpr ring_header_size = round_up (sizeof (nano::ipc::shm_ring::header), 64);
+std::size_t constexpr channel_header_size = 64;
+
+uint64_t current_process_id ()
+{
+#ifdef _WIN32
+	return GetCurrentProcessId ();
+#else
+	return static_cast<uint64_t> (::getpid ());
+#endif
+}
+
+bool process_running (uint64_t pid)
+{
+#ifdef _WIN32
+	auto handle = OpenProcess (PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD> (pid));
+	if (handle == nullptr)
+	{
+		return false;
+	}
+	DWORD exit_code = 0;
+	auto const result = GetExitCodeProcess (handle, &exit_code) && exit_code == STILL_ACTIVE;
+	CloseHandle (handle);
+	return result;
+#else
+	// A process owned by another user still exists when signalling it is not permitted
+	return pid != 0 && (::kill (static_cast<pid_t> (pid), 0) == 0 || errno == EPERM);
+#endif
+}
+}
+
+/*
+ * shm_ring
+ */
+
+nano::ipc::shm_ring::shm_ring (void * memory_a, std::size_t size_a, bool initialize_a) :
+	control{ static_cast<header *> (memory_a) },
+	data{ static_cast<uint8_t *> (memory_a) + ring_header_size },
+	capacity{ size_a - ring_header_size }
+{
+	if (initialize_a)
+	{
+		new (control) header{};
+		control->capacity = capacity;
+	}
+	release_assert (std::has_single_bit (capacity));
+}
+
+bool nano::ipc::shm_ring::write (uint8_t const * data_a, std::size_t size_a)
+{
+	auto const frame = frame_size (size_a);
+	if (frame > capacity || size_a >= padding_marker)
+	{
+		return true;
+	}
+
+	// Only the producer advances the head
+	auto head = control->head.load (std::memory_order_relaxed);
+	auto const tail = control->tail.load (std::memory_order_acquire);
+	auto const offset = head & (capacity - 1);
+	auto const skip = capacity - offset < frame ? capacity - offset : 0;
+	if (head + skip + frame - tail > capacity)
+	{
+		return true;
+	}
+
+	if (skip > 0)
+	{
+		std::memcpy (data + offset, &padding_marker, sizeof (padding_marker));
+		head += skip;
+	}
+	auto const start = head & (capacity - 1);
+	auto const length = static_cast<uint32_t> (size_a);
+	std::memcpy (data + start, &length, sizeof (length));
+	std::memcpy (data + start + sizeof (length), data_a, size_a);
+
+	// Publishing the head before checking for a waiting reader pairs with the reader setting the flag before checking the head
+	control->head.store (head + frame, std::memory_order_seq_cst);
+	if (control->waiting.load (std::memory_order_seq_cst) != 0)
+	{
+		notify ();
+	}
+	return false;
+}
+
+bool nano::ipc::shm_ring::read (std::vector<uint8_t> & buffer_a, std::chrono::milliseconds timeout_a)
+{
+	// Only the consumer advances the tail
+	auto tail = control->tail.load (std::memory_order_relaxed);
+	if (control->head.load (std::memory_order_acquire) == tail)
+	{
+		auto const deadline = boost::posix_time::microsec_clock::universal_time () + boost::posix_time::milliseconds (timeout_a.count ());
+		boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock{ control->mutex };
+		control->waiting.store (1, std::memory_order_seq_cst);
+		while (control->head.load (std::memory_order_seq_cst) == tail)
+		{
+			if (!control->condition.timed_wait (lock, deadline))
+			{
+				break;
+			}
+		}
+		control->waiting.store (0, std::memory_order_relaxed);
+	}
+
+	// Everything below comes from memory the other process can write, it is checked before being used
+	auto const head = control->head.load (std::memory_order_acquire);
+	if (head == tail)
+	{
+		return true;
+	}
+	auto available = head - tail;
+	auto offset = tail & (capacity - 1);
+	if (available > capacity || capacity - offset < sizeof (uint32_t))
+	{
+		reset ();
+		return true;
+	}
+
+	uint32_t length;
+	std::memcpy (&length, data + offset, sizeof (length));
+	if (length == padding_marker)
+	{
+		// The producer publishes the padding together with the frame following it
+		auto const skip = capacity - offset;
+		if (skip >= available)
+		{
+			reset ();
+			return true;
+		}
+		tail += skip;
+		available -= skip;
+		offset = 0;
+		std::memcpy (&length, data, sizeof (length));
+	}
+	if (length == padding_marker || sizeof (length) + length > capacity - offset || frame_size (length) > available)
+	{
+		reset ();
+		return true;
+	}
+
+	buffer_a.assign (data + offset + sizeof (length), data + offset + sizeof (length) + length);
+	control->tail.store (tail + frame_size (length), std::memory_order_release);
+	return false;
+}
+
+void nano::ipc::shm_ring::reset ()
+{
+	corruptions_m.fetch_add (1, std::memory_order_relaxed);
+	discard ();
+}
+
+void nano::ipc::shm_ring::discard ()
+{
+	control->tail.store (control->head.load (std::memory_order_acquire), std::memory_order_release);
+}
+
+void nano::ipc::shm_ring::notify ()
+{
+	// Taking the mutex ensures a reader between checking the head and waiting does not miss the notification
+	boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex> lock{ control->mutex };
+	control->condition.notify_all ();
+}
+
+std::size_t nano::ipc::shm_ring::size () const
+{
+	return control->head.load (std::memory_order_acquire) - control->tail.load (std::memory_order_acquire);
+}
+
+uint64_t nano::ipc::shm_ring::corruptions () const
+{
+	return corruptions_m.load (std::memory_order_relaxed);
+}
+
+std::size_t nano::ipc::shm_ring::memory_size (std::size_t capacity_a)
+{
+	debug_assert (std::has_single_bit (capacity_a));
+	return ring_header_size + capacity_a;
+}
+
+/*
+ * shm_channel
+ */
+
+nano::ipc::shm_channel::shm_channel (std::string const & name_a, bool owner_a) :
+	name{ name_a },
+	owner{ owner_a }
+{
+}
+
+nano::ipc::shm_channel::~shm_channel ()
+{
+	if (owner)
+	{
+		boost::interprocess::shared_memory_object::remove (name.c_str ());
+	}
+}
+
+std::unique_ptr<nano::ipc::shm_channel> nano::ipc::shm_channel::create (std::string const & name_a, std::size_t capacity_a)
+{
+	static_assert (sizeof (header) <= channel_header_size);
+	release_assert (std::has_single_bit (capacity_a));
+
+	// A segment left behind by a node that did not shut down cleanly is replaced, one created by a running node is left alone
+	if (auto const owner_l = running_owner (name_a))
+	{
+		throw boost::interprocess::interprocess_exception (("Shared memory segment \"" + name_a + "\" is in use by process " + std::to_string (*owner_l)).c_str ());
+	}
+	boost::interprocess::shared_memory_object::remove (name_a.c_str ());
+
+	std::unique_ptr<shm_channel> result{ new shm_channel{ name_a, true } };
+	// Requests and replies can contain wallet data, other local users must not be able to map the segment
+	boost::interprocess::permissions permissions;
+	permissions.set_permissions (0600);
+	result->memory = boost::interprocess::shared_memory_object{ boost::interprocess::create_only, name_a.c_str (), boost::interprocess::read_write, permissions };
+	result->memory.truncate (channel_header_size + 2 * shm_ring::memory_size (capacity_a));
+	result->region = boost::interprocess::mapped_region{ result->memory, boost::interprocess::read_write };
+	result->control = new (result->region.get_address ()) header{};
+	result->control->capacity = capacity_a;
+	result->control->owner = current_process_id ();
+	result->capacity = capacity_a;
+	result->attach (true);
+	// Clients check the magic last, the segment is fully initialized once it is set
+	std::atomic_thread_fence (std::memory_order_release);
+	result->control->magic = magic;
+	return result;
+}
+
+std::unique_ptr<nano::ipc::shm_channel> nano::ipc::shm_channel::open (std::string const & name_a)
+{
+	std::unique_ptr<shm_channel> result{ new shm_channel{ name_a, false } };
+	result->memory = boost::interprocess::shared_memory_object{ boost::interprocess::open_only, name_a.c_str (), boost::interprocess::read_write };
+	result->region = boost::interprocess::mapped_region{ result->memory, boost::interprocess::read_write };
+	result->control = static_cast<header *> (result->region.get_address ());
+	if (result->region.get_size () < channel_header_size || result->control->magic != magic)
+	{
+		throw boost::interprocess::interprocess_exception ("Invalid IPC shared memory segment");
+	}
+	std::atomic_thread_fence (std::memory_order_acquire);
+	result->capacity = result->control->capacity;
+	if (!std::has_single_bit (result->capacity) || result->region.get_size () < channel_header_size + 2 * shm_ring::memory_size (result->capacity))
+	{
+		throw boost::interprocess::interprocess_exception ("Invalid IPC shared memory segment");
+	}
+	result->attach (false);
+
+	// Replies still pending for a previous client are of no use to this one
+	result->replies_m->discard ();
+	result->control->generation.fetch_add (1);
+	return result;
+}
+
+std::optional<uint64_t> nano::ipc::shm_channel::running_owner (std::string const & name_a)
+{
+	try
+	{
+		boost::interprocess::shared_memory_object memory_l{ boost::interprocess::open_only, name_a.c_str (), boost::interprocess::read_only };
+		boost::interprocess::mapped_region region_l{ memory_l, boost::interprocess::read_only };
+		if (region_l.get_size () >= channel_header_size)
+		{
+			auto const & control_l = *static_cast<header const *> (region_l.get_address ());
+			if (control_l.magic == magic && process_running (control_l.owner))
+			{
+				return control_l.owner;
+			}
+		}
+	}
+	catch (boost::interprocess::interprocess_exception const &)
+	{
+		// No segment with this name, or one that cannot be inspected
+	}
+	return std::nullopt;
+}
+
+void nano::ipc::shm_channel::attach (bool initialize_a)
+{
+	auto const ring_size = shm_ring::memory_size (capacity);
+	auto const base = static_cast<uint8_t *> (region.get_address ()) + channel_header_size;
+	requests_m = std::make_unique<shm_ring> (base, ring_size, initialize_a);
+	replies_m = std::make_unique<shm_ring> (base + ring_size, ring_size, initialize_a);
+}
+
+nano::ipc::shm_ring & nano::ipc::shm_channel::requests ()
+{
+	return *requests_m;
+}
+
+nano::ipc::shm_ring & nano::ipc::shm_channel::replies ()
+{
+	return *replies_m;
+}
+
+uint64_t nano::ipc::shm_channel::generation () const
+{
+	return control->generation.load ();
+}
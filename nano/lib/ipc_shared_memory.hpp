@@ -0,0 +1,131 @@
+#pragma once
+
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nano::ipc
+{
+/**
+ * Single producer, single consumer ring of frames in a shared memory region.
+ * Each frame is a native endian 32-bit length followed by the payload, padded to 8 bytes. Frames never wrap, the unused tail
+ * of the data area is skipped with a padding marker instead. Readers block on an interprocess condition only when the ring is empty.
+ */
+class shm_ring final
+{
+public:
+	/** Control block at the start of the ring memory, followed by the data area */
+	struct header
+	{
+		uint64_t capacity;
+		alignas (64) std::atomic<uint64_t> head;
+		alignas (64) std::atomic<uint64_t> tail;
+		alignas (64) std::atomic<uint32_t> waiting;
+		boost::interprocess::interprocess_mutex mutex;
+		boost::interprocess::interprocess_condition condition;
+	};
+
+	/**
+	 * Attaches to ring memory of \p size_a bytes
+	 * @param initialize_a Constructs the control block, only done by the process creating the region
+	 */
+	shm_ring (void * memory_a, std::size_t size_a, bool initialize_a);
+
+	/** @return true if there is not enough free space for the frame */
+	bool write (uint8_t const * data_a, std::size_t size_a);
+	/**
+	 * Reads the next frame into \p buffer_a, waiting up to \p timeout_a if the ring is empty
+	 * Positions and lengths written by the other process are checked against the ring bounds, if they are inconsistent all
+	 * unread frames are dropped and corruptions () is incremented.
+	 * @return true if no frame was available
+	 */
+	bool read (std::vector<uint8_t> & buffer_a, std::chrono::milliseconds timeout_a);
+	/** Drops all unread frames, must only be called by the consumer */
+	void discard ();
+	/** Wakes up a blocked reader */
+	void notify ();
+
+	/** Number of bytes used by frames waiting to be read */
+	std::size_t size () const;
+	/** Number of times the consumer found the ring in an inconsistent state */
+	uint64_t corruptions () const;
+	/** Bytes of memory needed for a ring with a data area of \p capacity_a bytes, which must be a power of two */
+	static std::size_t memory_size (std::size_t capacity_a);
+
+private:
+	/** Drops unread frames after the ring was found inconsistent */
+	void reset ();
+
+	header * control;
+	uint8_t * data;
+	/** Copy of the capacity taken on attach, the control block can be modified by the other process */
+	uint64_t const capacity;
+	std::atomic<uint64_t> corruptions_m{ 0 };
+};
+
+/**
+ * Named shared memory segment with a pair of rings, requests flow from the client to the node and replies and events flow back.
+ * The node creates the segment readable by its own user only, a single local client attaches to it at a time. A newly attached
+ * client replaces the previous one.
+ * @throws boost::interprocess::interprocess_exception if the segment cannot be created or opened
+ */
+class shm_channel final
+{
+public:
+	/**
+	 * Creates the segment, replacing a segment with the same name left behind by a process that exited
+	 * @throws boost::interprocess::interprocess_exception if a running process created a segment with the same name
+	 */
+	static std::unique_ptr<shm_channel> create (std::string const & name_a, std::size_t capacity_a);
+	/** Opens a segment created by the node and registers as its client */
+	static std::unique_ptr<shm_channel> open (std::string const & name_a);
+
+	~shm_channel ();
+
+	/** Ring written by the client */
+	shm_ring & requests ();
+	/** Ring written by the node */
+	shm_ring & replies ();
+
+	/** Incremented each time a client attaches, lets the node drop the session state of a previous client */
+	uint64_t generation () const;
+
+private:
+	struct header
+	{
+		uint64_t magic;
+		uint64_t capacity;
+		std::atomic<uint64_t> generation;
+		/** Process id of the node that created the segment */
+		uint64_t owner;
+	};
+
+	shm_channel (std::string const & name_a, bool owner_a);
+	void attach (bool initialize_a);
+	/** Process id of the creator of an existing segment named \p name_a , if that process is still running */
+	static std::optional<uint64_t> running_owner (std::string const & name_a);
+
+	std::string const name;
+	bool const owner;
+	boost::interprocess::shared_memory_object memory;
+	boost::interprocess::mapped_region region;
+	header * control{ nullptr };
+	/** Ring capacity, taken from the config by the node and from the validated control block by the client */
+	std::size_t capacity{ 0 };
+	std::unique_ptr<shm_ring> requests_m;
+	std::unique_ptr<shm_ring> replies_m;
+
+public:
+	static uint64_t constexpr magic = 0x4e414e4f53484d31; // "NANOSHM1"
+};
+}
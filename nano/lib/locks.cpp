@@ -5,8 +5,11 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
+#include <map>
+#include <memory>
 
 #if USING_NANO_TIMED_LOCKS
 namespace nano
@@ -245,6 +248,145 @@ bool any_filters_registered ()
 }
 #endif
 
+/*
+ * mutex
+ */
+
+namespace
+{
+uint64_t elapsed_ns (std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds> (end - start).count ();
+}
+
+void update_max (std::atomic<uint64_t> & max, uint64_t value)
+{
+	auto current = max.load (std::memory_order_relaxed);
+	while (value > current && !max.compare_exchange_weak (current, value, std::memory_order_relaxed))
+	{
+	}
+}
+}
+
+void nano::mutex::lock_profiled ()
+{
+	auto & profile_l = *profile;
+	if (!mutex_m.try_lock ())
+	{
+		auto const start = std::chrono::steady_clock::now ();
+		mutex_m.lock ();
+		auto const waited = elapsed_ns (start, std::chrono::steady_clock::now ());
+		profile_l.contended.fetch_add (1, std::memory_order_relaxed);
+		profile_l.wait_ns.fetch_add (waited, std::memory_order_relaxed);
+		update_max (profile_l.wait_max_ns, waited);
+	}
+	profile_l.acquisitions.fetch_add (1, std::memory_order_relaxed);
+
+	thread_local unsigned acquisitions_l{ 0 };
+	if (++acquisitions_l % lock_profiler::hold_sample_interval == 0)
+	{
+		hold_start = std::chrono::steady_clock::now ();
+	}
+}
+
+void nano::mutex::unlock_profiled ()
+{
+	auto const held = elapsed_ns (hold_start, std::chrono::steady_clock::now ());
+	hold_start = {};
+	mutex_m.unlock ();
+
+	auto & profile_l = *profile;
+	profile_l.hold_samples.fetch_add (1, std::memory_order_relaxed);
+	profile_l.hold_ns.fetch_add (held, std::memory_order_relaxed);
+	update_max (profile_l.hold_max_ns, held);
+}
+
+/*
+ * lock_profile
+ */
+
+nano::lock_profile::lock_profile (std::string name_a) :
+	name{ std::move (name_a) }
+{
+}
+
+/*
+ * lock_profiler
+ */
+
+namespace
+{
+struct lock_profiles
+{
+	std::mutex mutex;
+	std::map<std::string, std::unique_ptr<nano::lock_profile>, std::less<>> profiles;
+};
+
+// Named mutexes can be constructed during static initialization, the registry is created on first use
+lock_profiles & profiles ()
+{
+	static lock_profiles instance;
+	return instance;
+}
+}
+
+void nano::lock_profiler::enable (bool enable_a)
+{
+	enabled_m.store (enable_a, std::memory_order_relaxed);
+}
+
+std::vector<nano::lock_profiler::entry> nano::lock_profiler::collect ()
+{
+	auto & registry = profiles ();
+	std::lock_guard guard{ registry.mutex };
+	std::vector<entry> result;
+	result.reserve (registry.profiles.size ());
+	for (auto const & [name, profile] : registry.profiles)
+	{
+		result.push_back ({ name,
+		profile->acquisitions.load (std::memory_order_relaxed),
+		profile->contended.load (std::memory_order_relaxed),
+		std::chrono::nanoseconds{ profile->wait_ns.load (std::memory_order_relaxed) },
+		std::chrono::nanoseconds{ profile->wait_max_ns.load (std::memory_order_relaxed) },
+		profile->hold_samples.load (std::memory_order_relaxed),
+		std::chrono::nanoseconds{ profile->hold_ns.load (std::memory_order_relaxed) },
+		std::chrono::nanoseconds{ profile->hold_max_ns.load (std::memory_order_relaxed) } });
+	}
+	return result;
+}
+
+void nano::lock_profiler::reset ()
+{
+	auto & registry = profiles ();
+	std::lock_guard guard{ registry.mutex };
+	for (auto const & [name, profile] : registry.profiles)
+	{
+		profile->acquisitions = 0;
+		profile->contended = 0;
+		profile->wait_ns = 0;
+		profile->wait_max_ns = 0;
+		profile->hold_samples = 0;
+		profile->hold_ns = 0;
+		profile->hold_max_ns = 0;
+	}
+}
+
+nano::lock_profile & nano::lock_profiler::profile (char const * name_a)
+{
+	auto & registry = profiles ();
+	std::lock_guard guard{ registry.mutex };
+	auto existing = registry.profiles.find (std::string_view{ name_a });
+	if (existing == registry.profiles.end ())
+	{
+		existing = registry.profiles.emplace (name_a, std::make_unique<nano::lock_profile> (name_a)).first;
+	}
+	return *existing->second;
+}
+
+/*
+ * mutex_identifier
+ */
+
 char const * nano::mutex_identifier (mutexes mutex)
 {
 	switch (mutex)
@@ -6,8 +6,12 @@
 #include <nano/lib/timer.hpp>
 #endif
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
+#include <string>
+#include <vector>
 
 namespace nano
 {
@@ -39,15 +43,68 @@ enum class mutexes
 
 char const * mutex_identifier (mutexes mutex);
 
+/** Contention counters shared by all mutexes with the same name, only updated while lock profiling is enabled */
+class lock_profile final
+{
+public:
+	explicit lock_profile (std::string name);
+
+	std::string const name;
+	std::atomic<uint64_t> acquisitions{ 0 };
+	std::atomic<uint64_t> contended{ 0 };
+	std::atomic<uint64_t> wait_ns{ 0 };
+	std::atomic<uint64_t> wait_max_ns{ 0 };
+	std::atomic<uint64_t> hold_samples{ 0 };
+	std::atomic<uint64_t> hold_ns{ 0 };
+	std::atomic<uint64_t> hold_max_ns{ 0 };
+};
+
+/**
+ * Sampling profiler for named mutexes, available in all builds and toggled at runtime.
+ * While enabled every acquisition is counted and blocked acquisitions are timed. Hold times are measured for one in
+ * hold_sample_interval acquisitions per thread, timing each one would double the cost of an uncontended lock.
+ */
+class lock_profiler final
+{
+public:
+	static unsigned constexpr hold_sample_interval = 16;
+
+	struct entry
+	{
+		std::string name;
+		uint64_t acquisitions;
+		uint64_t contended;
+		std::chrono::nanoseconds wait;
+		std::chrono::nanoseconds wait_max;
+		uint64_t hold_samples;
+		std::chrono::nanoseconds hold;
+		std::chrono::nanoseconds hold_max;
+	};
+
+	static void enable (bool enable);
+	static bool enabled ()
+	{
+		return enabled_m.load (std::memory_order_relaxed);
+	}
+	/** Counters of all named mutexes, sorted by name */
+	static std::vector<entry> collect ();
+	static void reset ();
+	/** Counters for mutexes named \p name, created on first use and never released */
+	static nano::lock_profile & profile (char const * name);
+
+private:
+	static inline std::atomic<bool> enabled_m{ false };
+};
+
 class mutex
 {
 public:
 	mutex () = default;
-	mutex (char const * name_a)
+	mutex (char const * name_a) :
 #if USING_NANO_TIMED_LOCKS
-		:
-		name (name_a)
+		name (name_a),
 #endif
+		profile (name_a ? &lock_profiler::profile (name_a) : nullptr)
 	{
 #if USING_NANO_TIMED_LOCKS
 		// This mutex should be filtered
@@ -74,17 +131,33 @@ public:
 
 	void lock ()
 	{
+		if (profile != nullptr && lock_profiler::enabled ())
+		{
+			lock_profiled ();
+			return;
+		}
 		mutex_m.lock ();
 	}
 
 	void unlock ()
 	{
+		// Only set by the current holder, stays consistent when profiling is toggled while the mutex is held
+		if (hold_start != std::chrono::steady_clock::time_point{})
+		{
+			unlock_profiled ();
+			return;
+		}
 		mutex_m.unlock ();
 	}
 
 	bool try_lock ()
 	{
-		return mutex_m.try_lock ();
+		auto result = mutex_m.try_lock ();
+		if (result && profile != nullptr && lock_profiler::enabled ())
+		{
+			profile->acquisitions.fetch_add (1, std::memory_order_relaxed);
+		}
+		return result;
 	}
 
 #if USING_NANO_TIMED_LOCKS
@@ -95,9 +168,15 @@ public:
 #endif
 
 private:
+	void lock_profiled ();
+	void unlock_profiled ();
+
 #if USING_NANO_TIMED_LOCKS
 	char const * name{ nullptr };
 #endif
+	nano::lock_profile * profile{ nullptr };
+	/** Start of a sampled hold, only accessed by the thread holding the mutex */
+	std::chrono::steady_clock::time_point hold_start{};
 	std::mutex mutex_m;
 };
 
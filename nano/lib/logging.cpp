@@ -26,6 +26,7 @@ bool nano::logger::global_initialized{ false };
 nano::log_config nano::logger::global_config{};
 std::vector<spdlog::sink_ptr> nano::logger::global_sinks{};
 nano::object_stream_config nano::logger::global_tracing_config{};
+std::unique_ptr<nano::log::async_backend> nano::logger::global_async{};
 
 // By default, use only the tag as the logger name, since only one node is running in the process
 std::function<std::string (nano::log::logger_id, std::string identifier)> nano::logger::global_name_formatter{ [] (nano::log::logger_id logger_id, std::string identifier) {
@@ -122,6 +123,9 @@ void nano::logger::initialize_common (nano::log_config const & config, std::opti
 {
 	global_config = config;
 
+	// Pending messages are written to the previous sinks
+	global_async.reset ();
+
 	spdlog::set_automatic_registration (false);
 	spdlog::set_level (to_spdlog_level (config.default_level));
 
@@ -198,16 +202,31 @@ void nano::logger::initialize_common (nano::log_config const & config, std::opti
 			global_tracing_config = nano::object_stream_config::json_config ();
 			break;
 	}
+
+	// Async setup
+	if (config.async.enable)
+	{
+		global_async = std::make_unique<nano::log::async_backend> (config.async.buffer_size, global_sinks);
+	}
 }
 
 void nano::logger::flush ()
 {
+	if (global_async)
+	{
+		global_async->drain ();
+	}
 	for (auto & sink : global_sinks)
 	{
 		sink->flush ();
 	}
 }
 
+uint64_t nano::logger::dropped ()
+{
+	return global_async ? global_async->dropped () : 0;
+}
+
 /*
  * logger
  */
@@ -383,6 +402,11 @@ void nano::log_config::serialize (nano::tomlconfig & toml) const
 	file_config.put ("rotation_count", file.rotation_count);
 	toml.put_child ("file", file_config);
 
+	nano::tomlconfig async_config;
+	async_config.put ("enable", async.enable, "Write log messages from a background thread. Messages are dropped instead of blocking the node when it falls behind.\ntype:bool");
+	async_config.put ("buffer_size", async.buffer_size, "Number of messages each thread can have pending, rounded up to a power of two.\nEvery thread that logs allocates its own buffer of about 200 bytes per message.\ntype:uint64");
+	toml.put_child ("async", async_config);
+
 	nano::tomlconfig levels_config;
 	for (auto const & [logger_id, level] : levels)
 	{
@@ -416,6 +440,17 @@ void nano::log_config::deserialize (nano::tomlconfig & toml)
 		file_config.get ("rotation_count", file.rotation_count);
 	}
 
+	if (toml.has_key ("async"))
+	{
+		auto async_config = toml.get_required_child ("async");
+		async_config.get ("enable", async.enable);
+		async_config.get ("buffer_size", async.buffer_size);
+		if (async.buffer_size == 0)
+		{
+			toml.get_error ().set ("log.async.buffer_size must be greater than zero");
+		}
+	}
+
 	if (toml.has_key ("levels"))
 	{
 		auto levels_config = toml.get_required_child ("levels");
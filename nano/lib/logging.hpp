@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/lib/formatting.hpp>
+#include <nano/lib/logging_async.hpp>
 #include <nano/lib/logging_enums.hpp>
 #include <nano/lib/object_stream.hpp>
 #include <nano/lib/object_stream_adapters.hpp>
@@ -128,8 +129,19 @@ public:
 		std::size_t rotation_count{ 4 };
 	};
 
+	/**
+	 * Messages below the flush level are handed to a background thread through per thread buffers instead of being written by the caller.
+	 * Messages are dropped when a thread's buffer is full.
+	 */
+	struct async_config
+	{
+		bool enable{ false };
+		std::size_t buffer_size{ 1024 };
+	};
+
 	console_config console;
 	file_config file;
+	async_config async;
 
 	nano::log::tracing_format tracing_format{ nano::log::tracing_format::standard };
 
@@ -159,6 +171,8 @@ public:
 	static void initialize (nano::log_config fallback, std::optional<std::filesystem::path> data_path = std::nullopt, std::vector<std::string> const & config_overrides = {});
 	static void initialize_for_tests (nano::log_config fallback);
 	static void flush ();
+	/** Number of messages dropped by the async backend because its buffers were full */
+	static uint64_t dropped ();
 
 private:
 	static bool global_initialized;
@@ -166,6 +180,7 @@ private:
 	static std::vector<spdlog::sink_ptr> global_sinks;
 	static std::function<std::string (nano::log::logger_id, std::string identifier)> global_name_formatter;
 	static nano::object_stream_config global_tracing_config;
+	static std::unique_ptr<nano::log::async_backend> global_async;
 
 	static void initialize_common (nano::log_config const &, std::optional<std::filesystem::path> data_path);
 
@@ -173,37 +188,37 @@ public:
 	template <class... Args>
 	void log (nano::log::level level, nano::log::type type, spdlog::format_string_t<Args...> fmt, Args &&... args)
 	{
-		get_logger (type).log (to_spdlog_level (level), fmt, std::forward<Args> (args)...);
+		write (get_logger (type), to_spdlog_level (level), fmt, std::forward<Args> (args)...);
 	}
 
 	template <class... Args>
 	void debug (nano::log::type type, spdlog::format_string_t<Args...> fmt, Args &&... args)
 	{
-		get_logger (type).debug (fmt, std::forward<Args> (args)...);
+		write (get_logger (type), spdlog::level::debug, fmt, std::forward<Args> (args)...);
 	}
 
 	template <class... Args>
 	void info (nano::log::type type, spdlog::format_string_t<Args...> fmt, Args &&... args)
 	{
-		get_logger (type).info (fmt, std::forward<Args> (args)...);
+		write (get_logger (type), spdlog::level::info, fmt, std::forward<Args> (args)...);
 	}
 
 	template <class... Args>
 	void warn (nano::log::type type, spdlog::format_string_t<Args...> fmt, Args &&... args)
 	{
-		get_logger (type).warn (fmt, std::forward<Args> (args)...);
+		write (get_logger (type), spdlog::level::warn, fmt, std::forward<Args> (args)...);
 	}
 
 	template <class... Args>
 	void error (nano::log::type type, spdlog::format_string_t<Args...> fmt, Args &&... args)
 	{
-		get_logger (type).error (fmt, std::forward<Args> (args)...);
+		write (get_logger (type), spdlog::level::err, fmt, std::forward<Args> (args)...);
 	}
 
 	template <class... Args>
 	void critical (nano::log::type type, spdlog::format_string_t<Args...> fmt, Args &&... args)
 	{
-		get_logger (type).critical (fmt, std::forward<Args> (args)...);
+		write (get_logger (type), spdlog::level::critical, fmt, std::forward<Args> (args)...);
 	}
 
 public:
@@ -246,6 +261,31 @@ private:
 	std::shared_mutex mutex;
 
 private:
+	/**
+	 * Messages at or above the flush level are written synchronously, so they are on disk before the caller continues.
+	 * Messages the calling thread queued earlier are written out first, keeping the order of each thread's messages.
+	 */
+	template <class... Args>
+	void write (spdlog::logger & logger, spdlog::level::level_enum level, spdlog::format_string_t<Args...> fmt, Args &&... args)
+	{
+		if (!logger.should_log (level))
+		{
+			return;
+		}
+		if (global_async && level < logger.flush_level ())
+		{
+			global_async->push (logger, level, fmt, std::forward<Args> (args)...);
+		}
+		else
+		{
+			if (global_async)
+			{
+				global_async->drain_local ();
+			}
+			logger.log (level, fmt, std::forward<Args> (args)...);
+		}
+	}
+
 	spdlog::logger & get_logger (nano::log::type, nano::log::detail = nano::log::detail::all);
 	std::shared_ptr<spdlog::logger> make_logger (nano::log::logger_id);
 	nano::log::level find_level (nano::log::logger_id) const;
@@ -0,0 +1,212 @@
+#include <nano/lib/assert.hpp>
+#include <nano/lib/logging_async.hpp>
+#include <nano/lib/thread_roles.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+/** Upper bound for the delay between pushing a record and writing it out while the node is idle */
+std::chrono::milliseconds constexpr poll_interval{ 10 };
+/** Records written from one buffer before moving on to the next, keeps a busy thread from starving the others */
+std::size_t constexpr batch_size = 256;
+
+std::atomic<uint64_t> instances{ 0 };
+}
+
+/*
+ * async_backend::buffer
+ */
+
+nano::log::async_backend::buffer::buffer (std::size_t capacity) :
+	records (std::bit_ceil (std::max<std::size_t> (capacity, 2))),
+	mask{ records.size () - 1 }
+{
+}
+
+nano::log::async_backend::record * nano::log::async_backend::buffer::reserve ()
+{
+	// Only the producer advances the head
+	auto const head_l = head.load (std::memory_order_relaxed);
+	if (head_l - tail.load (std::memory_order_acquire) >= records.size ())
+	{
+		return nullptr;
+	}
+	return &records[head_l & mask];
+}
+
+void nano::log::async_backend::buffer::publish ()
+{
+	head.store (head.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+nano::log::async_backend::record * nano::log::async_backend::buffer::front ()
+{
+	// Only the consumer advances the tail
+	auto const tail_l = tail.load (std::memory_order_relaxed);
+	if (tail_l == head.load (std::memory_order_acquire))
+	{
+		return nullptr;
+	}
+	return &records[tail_l & mask];
+}
+
+void nano::log::async_backend::buffer::pop ()
+{
+	tail.store (tail.load (std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool nano::log::async_backend::buffer::empty () const
+{
+	return tail.load (std::memory_order_acquire) == head.load (std::memory_order_acquire);
+}
+
+/*
+ * async_backend
+ */
+
+nano::log::async_backend::async_backend (std::size_t buffer_size_a, std::vector<spdlog::sink_ptr> const & sinks_a) :
+	buffer_size{ buffer_size_a },
+	instance{ ++instances },
+	overflow_logger{ std::make_shared<spdlog::logger> ("log", sinks_a.begin (), sinks_a.end ()) }
+{
+	thread = std::thread ([this] () {
+		nano::thread_role::set (nano::thread_role::name::logging);
+		run ();
+	});
+}
+
+nano::log::async_backend::~async_backend ()
+{
+	{
+		std::lock_guard guard{ mutex };
+		stopped = true;
+	}
+	condition.notify_all ();
+	thread.join ();
+}
+
+nano::log::async_backend::buffer & nano::log::async_backend::local_buffer ()
+{
+	// Buffers are released when their thread exits, the backend writes out what is left in them before dropping its reference
+	thread_local std::shared_ptr<buffer> local;
+	thread_local uint64_t local_instance{ 0 };
+	if (local_instance != instance)
+	{
+		local = std::make_shared<buffer> (buffer_size);
+		local_instance = instance;
+		std::lock_guard guard{ mutex };
+		buffers.push_back (local);
+	}
+	return *local;
+}
+
+void nano::log::async_backend::run ()
+{
+	std::vector<std::shared_ptr<buffer>> current;
+	std::unique_lock lock{ mutex };
+	while (true)
+	{
+		auto const requests = drain_requests;
+		auto const stop = stopped;
+		current = buffers;
+		lock.unlock ();
+
+		// Keep writing until all buffers are empty, a drain request then covers everything pushed before it was made
+		while (process (current) > 0)
+		{
+		}
+		report_dropped (current);
+		current.clear ();
+
+		lock.lock ();
+		// Buffers of exited threads are only referenced here and are empty at this point
+		std::erase_if (buffers, [] (auto const & buffer_l) {
+			return buffer_l.use_count () == 1 && buffer_l->empty ();
+		});
+		drain_completed = requests;
+		drained.notify_all ();
+		if (stop)
+		{
+			break;
+		}
+		condition.wait_for (lock, poll_interval, [this, requests] () {
+			return stopped || drain_requests != requests;
+		});
+	}
+}
+
+std::size_t nano::log::async_backend::process (std::vector<std::shared_ptr<buffer>> const & buffers_a)
+{
+	std::size_t result = 0;
+	spdlog::memory_buf_t formatted;
+	for (auto const & buffer_l : buffers_a)
+	{
+		for (std::size_t count = 0; count < batch_size; ++count)
+		{
+			auto * record_l = buffer_l->front ();
+			if (record_l == nullptr)
+			{
+				break;
+			}
+			if (record_l->format != nullptr)
+			{
+				formatted.clear ();
+				record_l->format (*record_l, formatted);
+				record_l->logger->log (record_l->time, spdlog::source_loc{}, record_l->level, spdlog::string_view_t{ formatted.data (), formatted.size () });
+			}
+			else
+			{
+				record_l->logger->log (record_l->time, spdlog::source_loc{}, record_l->level, spdlog::string_view_t{ record_l->text.data (), record_l->text.size () });
+			}
+			buffer_l->pop ();
+			++result;
+		}
+	}
+	return result;
+}
+
+void nano::log::async_backend::report_dropped (std::vector<std::shared_ptr<buffer>> const & buffers_a)
+{
+	uint64_t dropped_l = 0;
+	for (auto const & buffer_l : buffers_a)
+	{
+		dropped_l += buffer_l->dropped.exchange (0, std::memory_order_relaxed);
+	}
+	if (dropped_l > 0)
+	{
+		dropped_total.fetch_add (dropped_l, std::memory_order_relaxed);
+		overflow_logger->warn ("Dropped {} log messages, logging buffers are full", dropped_l);
+	}
+}
+
+void nano::log::async_backend::drain ()
+{
+	debug_assert (std::this_thread::get_id () != thread.get_id ());
+	std::unique_lock lock{ mutex };
+	auto const request = ++drain_requests;
+	condition.notify_all ();
+	drained.wait (lock, [this, request] () {
+		return drain_completed >= request || stopped;
+	});
+}
+
+void nano::log::async_backend::drain_local ()
+{
+	if (std::this_thread::get_id () != thread.get_id () && !local_buffer ().empty ())
+	{
+		drain ();
+	}
+}
+
+uint64_t nano::log::async_backend::dropped () const
+{
+	std::lock_guard guard{ mutex };
+	uint64_t result = dropped_total.load (std::memory_order_relaxed);
+	for (auto const & buffer_l : buffers)
+	{
+		result += buffer_l->dropped.load (std::memory_order_relaxed);
+	}
+	return result;
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+namespace nano::log
+{
+/**
+ * Value types whose copies are self-contained, so they can be captured and formatted later on the logging thread.
+ * Being trivially copyable is not enough, views such as the result of fmt::streamed hold references to the caller's objects.
+ */
+template <class T>
+concept deferrable_value = std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_base_of_v<nano::uint128_union, T> || std::is_base_of_v<nano::uint256_union, T> || std::is_base_of_v<nano::uint512_union, T> || std::is_base_of_v<nano::hash_or_account, T>;
+
+/** Arguments that can be captured by value and formatted later, on the logging thread */
+template <class T>
+concept deferrable = deferrable_value<std::remove_cvref_t<T>> && std::is_trivially_copyable_v<std::remove_cvref_t<T>>;
+
+/**
+ * Asynchronous logging backend. Each logging thread appends records to its own lock-free single producer, single consumer buffer,
+ * a background thread formats the records and writes them to the sinks.
+ * Messages with only numbers, enums and nano number types as arguments are captured by value and formatted on the background
+ * thread. Other messages are formatted on the calling thread, which still avoids blocking on sink I/O.
+ * When a thread's buffer is full new messages are dropped and counted instead of blocking the caller.
+ */
+class async_backend final
+{
+public:
+	/** Space for arguments captured by value, larger argument lists are formatted on the calling thread */
+	static std::size_t constexpr args_size = 128;
+
+	struct record
+	{
+		spdlog::logger * logger{ nullptr };
+		spdlog::level::level_enum level{ spdlog::level::off };
+		spdlog::log_clock::time_point time;
+		/** Formats the captured arguments, null if text holds the already formatted message */
+		void (*format) (record const &, spdlog::memory_buf_t &){ nullptr };
+		std::string_view format_string;
+		alignas (std::max_align_t) std::array<std::byte, args_size> args;
+		std::string text;
+	};
+
+	class buffer final
+	{
+	public:
+		explicit buffer (std::size_t capacity);
+
+		/** Slot for the next record, null if the buffer is full */
+		record * reserve ();
+		void publish ();
+		/** Oldest unconsumed record, null if the buffer is empty */
+		record * front ();
+		void pop ();
+		bool empty () const;
+
+		std::atomic<uint64_t> dropped{ 0 };
+
+	private:
+		std::vector<record> records;
+		std::size_t const mask;
+		alignas (64) std::atomic<std::size_t> head{ 0 };
+		alignas (64) std::atomic<std::size_t> tail{ 0 };
+	};
+
+	async_backend (std::size_t buffer_size, std::vector<spdlog::sink_ptr> const & sinks);
+	/** Writes out all pending records before returning */
+	~async_backend ();
+
+	template <class... Args>
+	void push (spdlog::logger & logger, spdlog::level::level_enum level, spdlog::format_string_t<Args...> fmt, Args &&... args)
+	{
+		auto & local = local_buffer ();
+		auto * slot = local.reserve ();
+		if (slot == nullptr)
+		{
+			local.dropped.fetch_add (1, std::memory_order_relaxed);
+			return;
+		}
+
+		slot->logger = &logger;
+		slot->level = level;
+		slot->time = spdlog::log_clock::now ();
+		using tuple_t = std::tuple<std::remove_cvref_t<Args>...>;
+		if constexpr ((deferrable<Args> && ...) && sizeof (tuple_t) <= args_size && alignof (tuple_t) <= alignof (std::max_align_t))
+		{
+			// Format strings are compile time literals, the view stays valid
+			fmt::string_view const view = fmt;
+			slot->format_string = std::string_view{ view.data (), view.size () };
+			new (slot->args.data ()) tuple_t{ args... };
+			slot->format = &format_deferred<tuple_t>;
+		}
+		else
+		{
+			slot->text.clear ();
+			fmt::format_to (std::back_inserter (slot->text), fmt, std::forward<Args> (args)...);
+			slot->format = nullptr;
+		}
+		local.publish ();
+	}
+
+	/** Blocks until all records pushed before the call are written to the sinks */
+	void drain ();
+	/** Drains if the calling thread has records waiting, so a message it then writes directly follows its earlier messages */
+	void drain_local ();
+	/** Number of messages dropped because a buffer was full */
+	uint64_t dropped () const;
+
+private:
+	template <class Tuple>
+	static void format_deferred (record const & record_a, spdlog::memory_buf_t & out)
+	{
+		// Captured arguments are trivially copyable, they need no destruction
+		auto const & values = *std::launder (reinterpret_cast<Tuple const *> (record_a.args.data ()));
+		std::apply ([&record_a, &out] (auto const &... values_a) {
+			fmt::vformat_to (std::back_inserter (out), fmt::string_view{ record_a.format_string.data (), record_a.format_string.size () }, fmt::make_format_args (values_a...));
+		},
+		values);
+	}
+
+	buffer & local_buffer ();
+	void run ();
+	/** Writes out pending records of all buffers, returns the number written */
+	std::size_t process (std::vector<std::shared_ptr<buffer>> const &);
+	void report_dropped (std::vector<std::shared_ptr<buffer>> const &);
+
+	std::size_t const buffer_size;
+	uint64_t const instance;
+	/** Reports dropped messages, writes directly to the sinks */
+	std::shared_ptr<spdlog::logger> overflow_logger;
+
+	std::vector<std::shared_ptr<buffer>> buffers;
+	std::atomic<uint64_t> dropped_total{ 0 };
+	uint64_t drain_requests{ 0 };
+	uint64_t drain_completed{ 0 };
+	bool stopped{ false };
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+	std::condition_variable drained;
+	std::thread thread;
+};
+}
@@ -80,6 +80,8 @@ enum class type
 	thread_runner,
 	signal_manager,
 	peer_history,
+	block_filter,
+	memory_budget,
 	message_processor,
 	online_reps,
 	local_block_broadcaster,
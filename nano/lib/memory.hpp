@@ -15,6 +15,9 @@ namespace nano
 bool get_use_memory_pools ();
 void set_use_memory_pools (bool use_memory_pools);
 
+/** Returns the resident set size of the process in bytes, platform specific. Returns 0 if it cannot be determined */
+size_t resident_memory ();
+
 /** This makes some heuristic assumptions about the implementation defined shared_ptr internals.
 	Should only be used in the memory pool purge functions at exit, which doesn't matter much if
 	it is incorrect (other than reports from heap memory analysers) */
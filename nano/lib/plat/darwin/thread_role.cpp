@@ -6,3 +6,19 @@ void nano::thread_role::set_os_name (std::string const & thread_name)
 {
 	pthread_setname_np (thread_name.c_str ());
 }
+
+// macOS only supports affinity hints between threads, not binding to CPUs
+bool nano::thread_role::set_os_affinity (std::vector<unsigned> const & cpus)
+{
+	return true;
+}
+
+std::vector<unsigned> nano::thread_role::available_cpus ()
+{
+	return {};
+}
+
+std::vector<unsigned> nano::thread_role::numa_node_cpus (unsigned node)
+{
+	return {};
+}
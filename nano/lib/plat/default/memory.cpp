@@ -0,0 +1,6 @@
+#include <nano/lib/memory.hpp>
+
+size_t nano::resident_memory ()
+{
+	return 0;
+}
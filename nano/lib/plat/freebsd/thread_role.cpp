@@ -1,5 +1,8 @@
 #include <nano/lib/threading.hpp>
 
+#include <sys/param.h>
+#include <sys/cpuset.h>
+
 #include <pthread.h>
 #include <pthread_np.h>
 
@@ -7,3 +10,42 @@ void nano::thread_role::set_os_name (std::string const & thread_name)
 {
 	pthread_set_name_np (pthread_self (), thread_name.c_str ());
 }
+
+bool nano::thread_role::set_os_affinity (std::vector<unsigned> const & cpus)
+{
+	cpuset_t set;
+	CPU_ZERO (&set);
+	for (auto cpu : cpus)
+	{
+		if (cpu >= CPU_SETSIZE)
+		{
+			return true;
+		}
+		CPU_SET (cpu, &set);
+	}
+	return pthread_setaffinity_np (pthread_self (), sizeof (set), &set) != 0;
+}
+
+std::vector<unsigned> nano::thread_role::available_cpus ()
+{
+	cpuset_t set;
+	CPU_ZERO (&set);
+	if (cpuset_getaffinity (CPU_LEVEL_WHICH, CPU_WHICH_PID, -1, sizeof (set), &set) != 0)
+	{
+		return {};
+	}
+	std::vector<unsigned> result;
+	for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+	{
+		if (CPU_ISSET (cpu, &set))
+		{
+			result.push_back (cpu);
+		}
+	}
+	return result;
+}
+
+std::vector<unsigned> nano::thread_role::numa_node_cpus (unsigned node)
+{
+	return {};
+}
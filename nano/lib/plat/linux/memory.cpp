@@ -0,0 +1,18 @@
+#include <nano/lib/memory.hpp>
+
+#include <fstream>
+
+#include <unistd.h>
+
+size_t nano::resident_memory ()
+{
+	// Second field of statm is the number of resident pages
+	std::ifstream statm{ "/proc/self/statm" };
+	size_t size{ 0 };
+	size_t resident{ 0 };
+	if (statm >> size >> resident)
+	{
+		return resident * static_cast<size_t> (sysconf (_SC_PAGESIZE));
+	}
+	return 0;
+}
@@ -1,8 +1,64 @@
+#include <nano/lib/thread_placement.hpp>
 #include <nano/lib/thread_roles.hpp>
 
+#include <fstream>
+
 #include <pthread.h>
+#include <sched.h>
 
 void nano::thread_role::set_os_name (std::string const & thread_name)
 {
 	pthread_setname_np (pthread_self (), thread_name.c_str ());
 }
+
+bool nano::thread_role::set_os_affinity (std::vector<unsigned> const & cpus)
+{
+	cpu_set_t set;
+	CPU_ZERO (&set);
+	for (auto cpu : cpus)
+	{
+		if (cpu >= CPU_SETSIZE)
+		{
+			return true;
+		}
+		CPU_SET (cpu, &set);
+	}
+	return pthread_setaffinity_np (pthread_self (), sizeof (set), &set) != 0;
+}
+
+std::vector<unsigned> nano::thread_role::available_cpus ()
+{
+	cpu_set_t set;
+	CPU_ZERO (&set);
+	if (sched_getaffinity (0, sizeof (set), &set) != 0)
+	{
+		return {};
+	}
+	std::vector<unsigned> result;
+	for (unsigned cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+	{
+		if (CPU_ISSET (cpu, &set))
+		{
+			result.push_back (cpu);
+		}
+	}
+	return result;
+}
+
+std::vector<unsigned> nano::thread_role::numa_node_cpus (unsigned node)
+{
+	std::ifstream file{ "/sys/devices/system/node/node" + std::to_string (node) + "/cpulist" };
+	std::string cpulist;
+	if (!std::getline (file, cpulist) || cpulist.empty ())
+	{
+		return {};
+	}
+	try
+	{
+		return nano::thread_placement::parse_cpus (cpulist);
+	}
+	catch (std::invalid_argument const &)
+	{
+		return {};
+	}
+}
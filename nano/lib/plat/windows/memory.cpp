@@ -0,0 +1,15 @@
+#include <nano/lib/memory.hpp>
+
+#include <windows.h>
+
+#include <psapi.h>
+
+size_t nano::resident_memory ()
+{
+	PROCESS_MEMORY_COUNTERS counters{};
+	if (GetProcessMemoryInfo (GetCurrentProcess (), &counters, sizeof (counters)))
+	{
+		return counters.WorkingSetSize;
+	}
+	return 0;
+}
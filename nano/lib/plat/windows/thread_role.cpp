@@ -12,3 +12,53 @@ void nano::thread_role::set_os_name (std::string const & thread_name)
 		SetThreadDescription_local (GetCurrentThread (), thread_name_wide.c_str ());
 	}
 }
+
+// Only the first processor group of up to 64 CPUs is supported
+bool nano::thread_role::set_os_affinity (std::vector<unsigned> const & cpus)
+{
+	DWORD_PTR mask = 0;
+	for (auto cpu : cpus)
+	{
+		if (cpu >= sizeof (mask) * 8)
+		{
+			return true;
+		}
+		mask |= DWORD_PTR{ 1 } << cpu;
+	}
+	return SetThreadAffinityMask (GetCurrentThread (), mask) == 0;
+}
+
+std::vector<unsigned> nano::thread_role::available_cpus ()
+{
+	std::vector<unsigned> result;
+	DWORD_PTR process_mask = 0;
+	DWORD_PTR system_mask = 0;
+	if (GetProcessAffinityMask (GetCurrentProcess (), &process_mask, &system_mask))
+	{
+		for (unsigned cpu = 0; cpu < sizeof (process_mask) * 8; ++cpu)
+		{
+			if (process_mask & (DWORD_PTR{ 1 } << cpu))
+			{
+				result.push_back (cpu);
+			}
+		}
+	}
+	return result;
+}
+
+std::vector<unsigned> nano::thread_role::numa_node_cpus (unsigned node)
+{
+	std::vector<unsigned> result;
+	ULONGLONG mask = 0;
+	if (node <= 0xFF && GetNumaNodeProcessorMask (static_cast<UCHAR> (node), &mask))
+	{
+		for (unsigned cpu = 0; cpu < sizeof (mask) * 8; ++cpu)
+		{
+			if (mask & (ULONGLONG{ 1 } << cpu))
+			{
+				result.push_back (cpu);
+			}
+		}
+	}
+	return result;
+}
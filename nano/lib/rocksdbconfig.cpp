@@ -8,6 +8,8 @@ nano::error nano::rocksdb_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("io_threads", io_threads, "Number of threads to use with the background compaction and flushing.\ntype:uint32");
 	toml.put ("read_cache", read_cache, "Amount of megabytes per table allocated to read cache. Valid range is 1 - 1024. Default is 32.\nCarefully monitor memory usage if non-default values are used\ntype:long");
 	toml.put ("write_cache", write_cache, "Total amount of megabytes allocated to write cache. Valid range is 1 - 256. Default is 64.\nCarefully monitor memory usage if non-default values are used\ntype:long");
+	toml.put ("block_compression", block_compression, "Compression used for the blocks table, either \"none\" or \"zstd\". Requires RocksDB built with zstd support (NANO_ROCKSDB_ZSTD).\nOnly newly written data is compressed, existing data is compressed as it gets compacted\ntype:string");
+	toml.put ("block_compression_dictionary", block_compression_dictionary, "Size in kilobytes of the zstd dictionary trained on blocks. Valid range is 0 - 1024, 0 disables dictionary compression.\ntype:uint32");
 
 	return toml.get_error ();
 }
@@ -18,6 +20,8 @@ nano::error nano::rocksdb_config::deserialize_toml (nano::tomlconfig & toml)
 	toml.get_optional<unsigned> ("io_threads", io_threads);
 	toml.get_optional<long> ("read_cache", read_cache);
 	toml.get_optional<long> ("write_cache", write_cache);
+	toml.get_optional<std::string> ("block_compression", block_compression);
+	toml.get_optional<unsigned> ("block_compression_dictionary", block_compression_dictionary);
 
 	// Validate ranges
 	if (io_threads == 0)
@@ -35,6 +39,20 @@ nano::error nano::rocksdb_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get_error ().set ("write_cache must be between 1 and 256 MB");
 	}
 
+	if (block_compression != "none" && block_compression != "zstd")
+	{
+		toml.get_error ().set ("block_compression must be either none or zstd");
+	}
+	else if (block_compression == "zstd" && !zstd_supported ())
+	{
+		toml.get_error ().set ("block_compression zstd requires a node built with NANO_ROCKSDB_ZSTD");
+	}
+
+	if (block_compression_dictionary > 1024)
+	{
+		toml.get_error ().set ("block_compression_dictionary must be between 0 and 1024 KB");
+	}
+
 	return toml.get_error ();
 }
 
@@ -43,3 +61,12 @@ bool nano::rocksdb_config::using_rocksdb_in_tests ()
 	auto use_rocksdb_str = std::getenv ("TEST_USE_ROCKSDB");
 	return use_rocksdb_str && (boost::lexical_cast<int> (use_rocksdb_str) == 1);
 }
+
+bool nano::rocksdb_config::zstd_supported ()
+{
+#ifdef NANO_ROCKSDB_ZSTD
+	return true;
+#else
+	return false;
+#endif
+}
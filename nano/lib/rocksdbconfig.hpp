@@ -3,6 +3,7 @@
 #include <nano/lib/errors.hpp>
 #include <nano/lib/threading.hpp>
 
+#include <string>
 #include <thread>
 
 namespace nano
@@ -23,10 +24,16 @@ public:
 
 	/** To use RocksDB in tests make sure the environment variable TEST_USE_ROCKSDB=1 is set */
 	static bool using_rocksdb_in_tests ();
+	/** Whether the linked RocksDB was built with zstd support, see NANO_ROCKSDB_ZSTD */
+	static bool zstd_supported ();
 
 	bool enable{ false };
 	unsigned io_threads{ std::max (nano::hardware_concurrency () / 2, 1u) };
 	long read_cache{ 32 };
 	long write_cache{ 64 };
+	/** Compression of the blocks table, either "none" or "zstd" */
+	std::string block_compression{ "none" };
+	/** Size in kilobytes of the zstd dictionary trained on blocks, 0 disables dictionary compression */
+	unsigned block_compression_dictionary{ 16 };
 };
 }
@@ -89,11 +89,7 @@ void nano::stats::add (stat::type type, stat::detail detail, stat::dir dir, coun
 
 	if (enable_logging)
 	{
-		logger.debug (nano::log::type::stats, "Stat: {}::{}::{} += {}",
-		to_string (type),
-		to_string (detail),
-		to_string (dir),
-		value);
+		logger.debug (nano::log::type::stats, "Stat: {}::{}::{} += {}", type, detail, dir, value);
 	}
 
 	// Updates need to happen while holding the mutex
@@ -171,7 +167,7 @@ void nano::stats::sample (stat::sample sample, nano::stats::sampler_value_t valu
 
 	if (enable_logging)
 	{
-		logger.debug (nano::log::type::stats, "Sample: {} -> {}", to_string (sample), value);
+		logger.debug (nano::log::type::stats, "Sample: {} -> {}", sample, value);
 	}
 
 	// Updates need to happen while holding the mutex
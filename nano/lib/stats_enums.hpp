@@ -82,6 +82,7 @@ enum class type
 	bootstrap_account_sets,
 	bootstrap_frontier_scan,
 	bootstrap_timeout,
+	bootstrap_peer,
 	bootstrap_server,
 	bootstrap_server_request,
 	bootstrap_server_overfill,
@@ -118,6 +119,8 @@ enum class type
 	process_confirmed,
 	online_reps,
 	pruning,
+	block_filter,
+	memory_budget,
 
 	_last // Must be the last enum
 };
@@ -147,6 +150,7 @@ enum class detail
 	broadcast,
 	cleanup,
 	top,
+	top_scan,
 	none,
 	success,
 	unknown,
@@ -219,12 +223,16 @@ enum class detail
 	process_blocking,
 	process_blocking_timeout,
 	force,
+	work_batched,
+	chain,
+	chain_truncated,
 
 	// block source
 	live,
 	live_originator,
 	bootstrap,
 	bootstrap_legacy,
+	bootstrap_bulk,
 	unchecked,
 	local,
 	forced,
@@ -272,6 +280,7 @@ enum class detail
 	// vote processor
 	vote_overflow,
 	vote_ignored,
+	verification_skipped,
 
 	// election specific
 	vote_new,
@@ -391,6 +400,10 @@ enum class detail
 
 	// ipc
 	invocations,
+	event_encode,
+	event_stream,
+	event_dropped,
+	shared_memory_corrupt,
 
 	// confirmation height
 	blocks_confirmed,
@@ -438,6 +451,8 @@ enum class detail
 	generator_replies,
 	generator_replies_discarded,
 	generator_spacing,
+	generator_signed,
+	generator_signed_parallel,
 	sent_pr,
 	sent_non_pr,
 
@@ -463,6 +478,11 @@ enum class detail
 	activate_skip,
 	activate_full,
 	scanned,
+	full_scan,
+	untracked,
+	tracked_overflow,
+	deferred,
+	deferred_released,
 
 	// active
 	insert,
@@ -513,6 +533,9 @@ enum class detail
 	processing_frontiers,
 	frontiers_dropped,
 	sync_accounts,
+	window_increase,
+	window_decrease,
+	window_timeout,
 
 	prioritize,
 	prioritize_failed,
@@ -529,6 +552,10 @@ enum class detail
 	next_by_timestamp,
 	advance,
 	advance_failed,
+	checkpoint_load,
+	checkpoint_save,
+	checkpoint_failed,
+	dispatch,
 
 	next_none,
 	next_priority,
@@ -663,6 +690,19 @@ enum class detail
 	// vote_rebroadcaster
 	rebroadcast_hashes,
 
+	// block_filter
+	filtered,
+	false_positive,
+	rebuild,
+	loaded,
+	saved,
+	load_failed,
+
+	// memory_budget
+	shrink,
+	grow,
+	unsupported,
+
 	_last // Must be the last enum
 };
 
@@ -681,9 +721,13 @@ enum class sample
 
 	active_election_duration,
 	bootstrap_tag_duration,
+	bootstrap_peer_goodput,
+	bootstrap_peer_window,
 	rep_response_time,
 	vote_generator_final_hashes,
 	vote_generator_hashes,
+	block_filter_false_positive_ppm,
+	memory_budget_resident_mb,
 
 	_last // Must be the last enum
 };
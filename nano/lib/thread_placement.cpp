@@ -0,0 +1,206 @@
+#include <nano/lib/enum_util.hpp>
+#include <nano/lib/thread_placement.hpp>
+#include <nano/lib/tomlconfig.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <mutex>
+#include <stdexcept>
+
+/*
+ * thread_placement_config
+ */
+
+nano::error nano::thread_placement_config::serialize_toml (nano::tomlconfig & toml) const
+{
+	toml.put ("enable", enable, "Restrict the threads of each role listed in [thread_placement.roles] to a set of CPUs.\nEntries are comma separated CPU numbers, CPU ranges such as \"0-7\" and NUMA nodes such as \"numa:1\", e.g. block_processing = \"numa:0\" or io = \"2-3\".\nRole names are listed by the thread_role enum, roles not listed are not restricted.\ntype:bool");
+
+	nano::tomlconfig roles_l;
+	for (auto const & [role, spec] : roles)
+	{
+		roles_l.put (std::string{ nano::thread_role::to_string (role) }, spec);
+	}
+	toml.put_child ("roles", roles_l);
+
+	return toml.get_error ();
+}
+
+nano::error nano::thread_placement_config::deserialize_toml (nano::tomlconfig & toml)
+{
+	toml.get ("enable", enable);
+
+	if (toml.has_key ("roles"))
+	{
+		auto roles_l = toml.get_required_child ("roles");
+		for (auto const & [role_str, spec] : roles_l.get_values<std::string> ())
+		{
+			try
+			{
+				auto role = nano::enum_util::parse<nano::thread_role::name> (role_str);
+				nano::thread_placement::parse_cpus (spec);
+				roles[role] = spec;
+			}
+			catch (std::invalid_argument const & ex)
+			{
+				toml.get_error ().set (std::string{ "Invalid thread placement for " } + role_str + ": " + ex.what ());
+			}
+		}
+	}
+
+	return toml.get_error ();
+}
+
+/*
+ * thread_placement
+ */
+
+namespace
+{
+std::mutex placement_mutex;
+std::map<nano::thread_role::name, std::vector<unsigned>> placement;
+
+/** Upper bound on CPU and NUMA node numbers, keeps ranges from a config file from expanding into huge lists */
+unsigned constexpr max_cpus = 4096;
+
+unsigned parse_number (std::string_view text)
+{
+	unsigned result = 0;
+	auto [end, error] = std::from_chars (text.data (), text.data () + text.size (), result);
+	if (text.empty () || error != std::errc{} || end != text.data () + text.size ())
+	{
+		throw std::invalid_argument ("invalid CPU number \"" + std::string{ text } + "\"");
+	}
+	if (result >= max_cpus)
+	{
+		throw std::invalid_argument ("CPU number \"" + std::string{ text } + "\" exceeds the maximum of " + std::to_string (max_cpus - 1));
+	}
+	return result;
+}
+
+std::string_view trim (std::string_view text)
+{
+	auto const first = text.find_first_not_of (" \t\n");
+	if (first == std::string_view::npos)
+	{
+		return {};
+	}
+	return text.substr (first, text.find_last_not_of (" \t\n") - first + 1);
+}
+}
+
+void nano::thread_placement::apply (nano::thread_placement_config const & config)
+{
+	std::map<nano::thread_role::name, std::vector<unsigned>> result;
+	if (config.enable)
+	{
+		auto const available = nano::thread_role::available_cpus ();
+		if (available.empty ())
+		{
+			throw std::invalid_argument ("thread placement is not supported on this platform");
+		}
+		for (auto const & [role, spec] : config.roles)
+		{
+			auto cpus_l = parse_cpus (spec);
+			for (auto cpu : cpus_l)
+			{
+				if (!std::binary_search (available.begin (), available.end (), cpu))
+				{
+					throw std::invalid_argument ("CPU " + std::to_string (cpu) + " of " + std::string{ nano::thread_role::to_string (role) } + " is not available to this process");
+				}
+			}
+			result[role] = std::move (cpus_l);
+		}
+	}
+	std::lock_guard guard{ placement_mutex };
+	placement = std::move (result);
+}
+
+std::vector<unsigned> nano::thread_placement::cpus (nano::thread_role::name role)
+{
+	std::lock_guard guard{ placement_mutex };
+	if (auto existing = placement.find (role); existing != placement.end ())
+	{
+		return existing->second;
+	}
+	return {};
+}
+
+bool nano::thread_placement::place (nano::thread_role::name role)
+{
+	auto const cpus_l = cpus (role);
+	if (cpus_l.empty ())
+	{
+		return false;
+	}
+	return nano::thread_role::set_os_affinity (cpus_l);
+}
+
+std::vector<unsigned> nano::thread_placement::parse_cpus (std::string_view spec)
+{
+	std::vector<unsigned> result;
+	while (!spec.empty ())
+	{
+		auto const separator = spec.find (',');
+		auto const item = trim (spec.substr (0, separator));
+		spec = separator == std::string_view::npos ? std::string_view{} : spec.substr (separator + 1);
+
+		if (item.starts_with ("numa:"))
+		{
+			auto const node = parse_number (trim (item.substr (5)));
+			auto const node_cpus = nano::thread_role::numa_node_cpus (node);
+			if (node_cpus.empty ())
+			{
+				throw std::invalid_argument ("NUMA node " + std::to_string (node) + " is not available");
+			}
+			result.insert (result.end (), node_cpus.begin (), node_cpus.end ());
+		}
+		else if (auto const dash = item.find ('-'); dash != std::string_view::npos)
+		{
+			auto const first = parse_number (trim (item.substr (0, dash)));
+			auto const last = parse_number (trim (item.substr (dash + 1)));
+			if (first > last)
+			{
+				throw std::invalid_argument ("invalid CPU range \"" + std::string{ item } + "\"");
+			}
+			for (auto cpu = first; cpu <= last; ++cpu)
+			{
+				result.push_back (cpu);
+			}
+		}
+		else
+		{
+			result.push_back (parse_number (item));
+		}
+	}
+	if (result.empty ())
+	{
+		throw std::invalid_argument ("empty CPU list");
+	}
+	std::sort (result.begin (), result.end ());
+	result.erase (std::unique (result.begin (), result.end ()), result.end ());
+	return result;
+}
+
+std::string nano::thread_placement::format_cpus (std::vector<unsigned> const & cpus)
+{
+	std::string result;
+	for (std::size_t i = 0; i < cpus.size ();)
+	{
+		auto last = i;
+		while (last + 1 < cpus.size () && cpus[last + 1] == cpus[last] + 1)
+		{
+			++last;
+		}
+		if (!result.empty ())
+		{
+			result += ',';
+		}
+		result += std::to_string (cpus[i]);
+		if (last > i)
+		{
+			result += '-' + std::to_string (cpus[last]);
+		}
+		i = last + 1;
+	}
+	return result;
+}
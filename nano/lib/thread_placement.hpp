@@ -0,0 +1,63 @@
+#pragma once
+
+#include <nano/lib/errors.hpp>
+#include <nano/lib/thread_roles.hpp>
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nano
+{
+class tomlconfig;
+
+/**
+ * Maps thread roles to the CPUs their threads may run on.
+ * Each entry is a comma separated list of CPU numbers, CPU ranges ("0-7") and NUMA nodes ("numa:1"). Memory is placed on the
+ * NUMA node of the thread first touching it, so pinning a role to the CPUs of a node also keeps the memory it allocates local.
+ */
+class thread_placement_config final
+{
+public:
+	nano::error serialize_toml (nano::tomlconfig &) const;
+	nano::error deserialize_toml (nano::tomlconfig &);
+
+public:
+	bool enable{ false };
+	std::map<nano::thread_role::name, std::string> roles;
+};
+}
+
+/*
+ * Process wide placement of threads by role, a thread is moved to the CPUs of its role when it calls nano::thread_role::set
+ */
+namespace nano::thread_placement
+{
+/*
+ * Resolves the CPU sets of the config, threads taking a role afterwards are placed accordingly
+ * @throws std::invalid_argument if an entry is invalid, names CPUs the process is not allowed to run on or placement is enabled on a platform not supporting it
+ */
+void apply (nano::thread_placement_config const &);
+
+/*
+ * CPUs assigned to the role, empty if threads of the role are not restricted
+ */
+std::vector<unsigned> cpus (nano::thread_role::name);
+
+/*
+ * Restricts the current thread to the CPUs of the role, returns true on error
+ */
+bool place (nano::thread_role::name);
+
+/*
+ * Parses a CPU list, sorted and without duplicates
+ * @throws std::invalid_argument if the list is malformed, empty, names a CPU above 4095 or names a NUMA node that does not exist
+ */
+std::vector<unsigned> parse_cpus (std::string_view);
+
+/*
+ * Formats a CPU list using ranges, e.g. "0-3,8"
+ */
+std::string format_cpus (std::vector<unsigned> const &);
+}
@@ -1,4 +1,6 @@
 #include <nano/lib/enum_util.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/lib/thread_placement.hpp>
 #include <nano/lib/thread_roles.hpp>
 #include <nano/lib/utility.hpp>
 
@@ -25,6 +27,15 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::io_ipc:
 			thread_role_name_string = "I/O (IPC)";
 			break;
+		case nano::thread_role::name::io_shard:
+			thread_role_name_string = "I/O (shard)";
+			break;
+		case nano::thread_role::name::ipc_shared_memory:
+			thread_role_name_string = "IPC shared mem";
+			break;
+		case nano::thread_role::name::logging:
+			thread_role_name_string = "Logging";
+			break;
 		case nano::thread_role::name::work:
 			thread_role_name_string = "Work pool";
 			break;
@@ -64,6 +75,9 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::voting_final:
 			thread_role_name_string = "Voting final";
 			break;
+		case nano::thread_role::name::vote_signing:
+			thread_role_name_string = "Vote signing";
+			break;
 		case nano::thread_role::name::signature_checking:
 			thread_role_name_string = "Signature check";
 			break;
@@ -196,6 +210,12 @@ std::string nano::thread_role::get_string (nano::thread_role::name role)
 		case nano::thread_role::name::pruning:
 			thread_role_name_string = "Pruning";
 			break;
+		case nano::thread_role::name::block_filter:
+			thread_role_name_string = "Block filter";
+			break;
+		case nano::thread_role::name::memory_budget:
+			thread_role_name_string = "Memory budget";
+			break;
 		default:
 			debug_assert (false && "nano::thread_role::get_string unhandled thread role");
 	}
@@ -229,10 +249,16 @@ void nano::thread_role::set (nano::thread_role::name role)
 {
 	auto thread_role_name_string = get_string (role);
 	nano::thread_role::set_os_name (thread_role_name_string); // Implementation is platform specific
+	// Placement entries are validated when applied, a failure here leaves the thread unrestricted
+	if (nano::thread_placement::place (role))
+	{
+		nano::default_logger ().warn (nano::log::type::thread_runner, "Unable to place thread {} on CPUs {}", thread_role_name_string, nano::thread_placement::format_cpus (nano::thread_placement::cpus (role)));
+	}
 	current_thread_role = role;
 }
 
 bool nano::thread_role::is_network_io ()
 {
-	return nano::thread_role::get () == nano::thread_role::name::io;
+	auto const role = nano::thread_role::get ();
+	return role == nano::thread_role::name::io || role == nano::thread_role::name::io_shard;
 }
\ No newline at end of file
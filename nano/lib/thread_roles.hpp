@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 /*
  * Functions for understanding the role of the current thread
@@ -13,6 +14,9 @@ enum class name
 	io,
 	io_daemon,
 	io_ipc,
+	io_shard,
+	ipc_shared_memory,
+	logging,
 	work,
 	message_processing,
 	vote_processing,
@@ -26,6 +30,7 @@ enum class name
 	bootstrap_connections,
 	voting,
 	voting_final,
+	vote_signing,
 	signature_checking,
 	rpc_request_processor,
 	rpc_process_container,
@@ -70,6 +75,8 @@ enum class name
 	monitor,
 	http_callbacks,
 	pruning,
+	block_filter,
+	memory_budget,
 };
 
 std::string_view to_string (name);
@@ -95,6 +102,21 @@ std::string get_string ();
  */
 void set_os_name (std::string const &);
 
+/*
+ * Internal only, restricts the current thread to the CPUs, returns true on error or if not supported by the platform
+ */
+bool set_os_affinity (std::vector<unsigned> const & cpus);
+
+/*
+ * Internal only, CPUs the process is allowed to run on, empty if the platform does not support restricting threads to CPUs
+ */
+std::vector<unsigned> available_cpus ();
+
+/*
+ * Internal only, CPUs of the NUMA node, empty if the node does not exist or the platform does not report NUMA topology
+ */
+std::vector<unsigned> numa_node_cpus (unsigned node);
+
 /*
  * Check if the current thread is a network IO thread
  */
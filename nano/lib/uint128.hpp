@@ -0,0 +1,262 @@
+#pragma once
+
+#include <nano/lib/assert.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <compare>
+#include <cstdint>
+#include <limits>
+
+namespace nano
+{
+/**
+ * Fixed width 128 bit unsigned integer built from two 64 bit words
+ * Arithmetic wraps modulo 2^128, same as nano::uint128_t. Addition, subtraction, shifts and comparisons are done on the words directly,
+ * multiplication and division go through nano::uint128_t. Used when the compiler has no native 128 bit integer.
+ */
+class uint128_words final
+{
+public:
+	constexpr uint128_words () = default;
+	constexpr uint128_words (uint64_t value) :
+		low_m{ value }
+	{
+	}
+	constexpr uint128_words (uint64_t high, uint64_t low) :
+		low_m{ low },
+		high_m{ high }
+	{
+	}
+	explicit uint128_words (nano::uint128_t const & value) :
+		low_m{ static_cast<uint64_t> (value & std::numeric_limits<uint64_t>::max ()) },
+		high_m{ static_cast<uint64_t> (value >> 64) }
+	{
+	}
+
+	constexpr uint64_t low () const
+	{
+		return low_m;
+	}
+	constexpr uint64_t high () const
+	{
+		return high_m;
+	}
+	nano::uint128_t number () const
+	{
+		return (nano::uint128_t{ high_m } << 64) | low_m;
+	}
+	explicit operator nano::uint128_t () const
+	{
+		return number ();
+	}
+
+	friend constexpr uint128_words operator+ (uint128_words const & a, uint128_words const & b)
+	{
+		uint64_t const low = a.low_m + b.low_m;
+		return { a.high_m + b.high_m + (low < a.low_m), low };
+	}
+	friend constexpr uint128_words operator- (uint128_words const & a, uint128_words const & b)
+	{
+		return { a.high_m - b.high_m - (a.low_m < b.low_m), a.low_m - b.low_m };
+	}
+	friend uint128_words operator* (uint128_words const & a, uint128_words const & b)
+	{
+		return uint128_words{ a.number () * b.number () };
+	}
+	/** @warning The divisor must not be zero */
+	friend uint128_words operator/ (uint128_words const & a, uint128_words const & b)
+	{
+		debug_assert (b != 0);
+		return uint128_words{ a.number () / b.number () };
+	}
+	/** @warning The divisor must not be zero */
+	friend uint128_words operator% (uint128_words const & a, uint128_words const & b)
+	{
+		debug_assert (b != 0);
+		return uint128_words{ a.number () % b.number () };
+	}
+	/** @warning The shift must be less than 128 */
+	friend constexpr uint128_words operator<< (uint128_words const & a, unsigned shift)
+	{
+		debug_assert (shift < 128);
+		if (shift == 0)
+		{
+			return a;
+		}
+		if (shift >= 64)
+		{
+			return { a.low_m << (shift - 64), 0 };
+		}
+		return { (a.high_m << shift) | (a.low_m >> (64 - shift)), a.low_m << shift };
+	}
+	/** @warning The shift must be less than 128 */
+	friend constexpr uint128_words operator>> (uint128_words const & a, unsigned shift)
+	{
+		debug_assert (shift < 128);
+		if (shift == 0)
+		{
+			return a;
+		}
+		if (shift >= 64)
+		{
+			return { 0, a.high_m >> (shift - 64) };
+		}
+		return { a.high_m >> shift, (a.low_m >> shift) | (a.high_m << (64 - shift)) };
+	}
+
+	constexpr uint128_words & operator+= (uint128_words const & other)
+	{
+		return *this = *this + other;
+	}
+	constexpr uint128_words & operator-= (uint128_words const & other)
+	{
+		return *this = *this - other;
+	}
+	uint128_words & operator*= (uint128_words const & other)
+	{
+		return *this = *this * other;
+	}
+	uint128_words & operator/= (uint128_words const & other)
+	{
+		return *this = *this / other;
+	}
+
+	friend constexpr std::strong_ordering operator<=> (uint128_words const & a, uint128_words const & b)
+	{
+		return a.high_m != b.high_m ? a.high_m <=> b.high_m : a.low_m <=> b.low_m;
+	}
+	friend constexpr bool operator== (uint128_words const & a, uint128_words const & b)
+	{
+		return ((a.high_m ^ b.high_m) | (a.low_m ^ b.low_m)) == 0;
+	}
+
+private:
+	uint64_t low_m{ 0 };
+	uint64_t high_m{ 0 };
+};
+
+#if defined(__SIZEOF_INT128__)
+/**
+ * Fixed width 128 bit unsigned integer backed by the compiler's native unsigned __int128
+ * Same interface and results as nano::uint128_words, each operation compiles to a couple of instructions on 64 bit targets
+ */
+class uint128_native final
+{
+	__extension__ using value_type = unsigned __int128;
+
+public:
+	constexpr uint128_native () = default;
+	constexpr uint128_native (uint64_t value) :
+		value{ value }
+	{
+	}
+	constexpr uint128_native (uint64_t high, uint64_t low) :
+		value{ (value_type{ high } << 64) | low }
+	{
+	}
+	explicit uint128_native (nano::uint128_t const & value) :
+		uint128_native{ static_cast<uint64_t> (value >> 64), static_cast<uint64_t> (value & std::numeric_limits<uint64_t>::max ()) }
+	{
+	}
+
+	constexpr uint64_t low () const
+	{
+		return static_cast<uint64_t> (value);
+	}
+	constexpr uint64_t high () const
+	{
+		return static_cast<uint64_t> (value >> 64);
+	}
+	nano::uint128_t number () const
+	{
+		return (nano::uint128_t{ high () } << 64) | low ();
+	}
+	explicit operator nano::uint128_t () const
+	{
+		return number ();
+	}
+
+	friend constexpr uint128_native operator+ (uint128_native const & a, uint128_native const & b)
+	{
+		return from (a.value + b.value);
+	}
+	friend constexpr uint128_native operator- (uint128_native const & a, uint128_native const & b)
+	{
+		return from (a.value - b.value);
+	}
+	friend constexpr uint128_native operator* (uint128_native const & a, uint128_native const & b)
+	{
+		return from (a.value * b.value);
+	}
+	/** @warning The divisor must not be zero */
+	friend constexpr uint128_native operator/ (uint128_native const & a, uint128_native const & b)
+	{
+		debug_assert (b.value != 0);
+		return from (a.value / b.value);
+	}
+	/** @warning The divisor must not be zero */
+	friend constexpr uint128_native operator% (uint128_native const & a, uint128_native const & b)
+	{
+		debug_assert (b.value != 0);
+		return from (a.value % b.value);
+	}
+	/** @warning The shift must be less than 128 */
+	friend constexpr uint128_native operator<< (uint128_native const & a, unsigned shift)
+	{
+		debug_assert (shift < 128);
+		return from (a.value << shift);
+	}
+	/** @warning The shift must be less than 128 */
+	friend constexpr uint128_native operator>> (uint128_native const & a, unsigned shift)
+	{
+		debug_assert (shift < 128);
+		return from (a.value >> shift);
+	}
+
+	constexpr uint128_native & operator+= (uint128_native const & other)
+	{
+		value += other.value;
+		return *this;
+	}
+	constexpr uint128_native & operator-= (uint128_native const & other)
+	{
+		value -= other.value;
+		return *this;
+	}
+	constexpr uint128_native & operator*= (uint128_native const & other)
+	{
+		value *= other.value;
+		return *this;
+	}
+	constexpr uint128_native & operator/= (uint128_native const & other)
+	{
+		return *this = *this / other;
+	}
+
+	friend constexpr std::strong_ordering operator<=> (uint128_native const & a, uint128_native const & b)
+	{
+		return a.value == b.value ? std::strong_ordering::equal : (a.value < b.value ? std::strong_ordering::less : std::strong_ordering::greater);
+	}
+	friend constexpr bool operator== (uint128_native const & a, uint128_native const & b)
+	{
+		return a.value == b.value;
+	}
+
+private:
+	static constexpr uint128_native from (value_type value)
+	{
+		uint128_native result;
+		result.value = value;
+		return result;
+	}
+
+	value_type value{ 0 };
+};
+
+/** Fast fixed width type for tally and weight arithmetic, convert to nano::uint128_t at API boundaries */
+using uint128_fast_t = nano::uint128_native;
+#else
+/** Fast fixed width type for tally and weight arithmetic, convert to nano::uint128_t at API boundaries */
+using uint128_fast_t = nano::uint128_words;
+#endif
+}
@@ -1,13 +1,23 @@
 #pragma once
 
-#include <nano/lib/interval.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/utility.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace nano
 {
+/**
+ * Deduplicates shared values by their full hash, so identical blocks and votes received from multiple peers share a single instance.
+ * Values are split into shards by key, each an open addressing table with linear probing behind its own mutex.
+ * Expired entries are reclaimed incrementally: every call sweeps a few slots of the touched shard and probing reuses expired slots,
+ * instead of periodically sweeping the whole container while holding a global lock.
+ */
 template <typename Key, typename Value>
 class uniquer final
 {
@@ -23,58 +33,199 @@ public:
 		}
 
 		// Types used as value need to provide full_hash()
-		Key hash = value->full_hash ();
+		Key key = value->full_hash ();
+		auto const hash = std::hash<Key>{}(key);
 
-		nano::lock_guard<nano::mutex> guard{ mutex };
-
-		if (cleanup_interval.elapse (cleanup_cutoff))
-		{
-			cleanup ();
-		}
+		auto & shard = shards[hash & (shard_count - 1)];
+		nano::lock_guard<nano::mutex> guard{ shard.mutex };
+		shard.sweep (sweep_step);
+		return shard.insert (hash >> shard_bits, key, value);
+	}
 
-		auto & existing = values[hash];
-		if (auto result = existing.lock ())
-		{
-			return result;
-		}
-		else
+	/** Number of stored entries, including expired entries not yet reclaimed */
+	std::size_t size () const
+	{
+		std::size_t result = 0;
+		for (auto const & shard : shards)
 		{
-			existing = value;
+			nano::lock_guard<nano::mutex> guard{ shard.mutex };
+			result += shard.count;
 		}
-
-		return value;
+		return result;
 	}
 
-	std::size_t size () const
+	/** Reclaims all expired entries at once, normally expiry is incremental */
+	void cleanup ()
 	{
-		nano::lock_guard<nano::mutex> guard{ mutex };
-		return values.size ();
+		for (auto & shard : shards)
+		{
+			nano::lock_guard<nano::mutex> guard{ shard.mutex };
+			shard.rehash ();
+		}
 	}
 
 	nano::container_info container_info () const
 	{
-		nano::lock_guard<nano::mutex> guard{ mutex };
+		std::size_t count = 0;
+		std::size_t capacity = 0;
+		for (auto const & shard : shards)
+		{
+			nano::lock_guard<nano::mutex> guard{ shard.mutex };
+			count += shard.count;
+			capacity += shard.slots.size ();
+		}
 
 		nano::container_info info;
-		info.put ("cache", values);
+		info.put ("cache", count);
+		info.put ("slots", capacity, sizeof (slot));
 		return info;
 	}
 
-	static std::chrono::milliseconds constexpr cleanup_cutoff{ 500 };
+public: // Config
+	static std::size_t constexpr shard_bits = 4;
+	static std::size_t constexpr shard_count = std::size_t{ 1 } << shard_bits;
+	/** Initial and minimum number of slots per shard, must be a power of two */
+	static std::size_t constexpr shard_min_capacity = 64;
+	/** Number of slots checked for expired entries on each call */
+	static std::size_t constexpr sweep_step = 4;
 
 private:
-	void cleanup ()
+	struct slot
 	{
-		debug_assert (!mutex.try_lock ());
+		Key key;
+		std::weak_ptr<Value> value;
+		std::size_t hash{ 0 };
+		bool used{ false };
+	};
 
-		std::erase_if (values, [] (auto const & item) {
-			return item.second.expired ();
-		});
-	}
+	class shard
+	{
+	public:
+		shard () :
+			slots (shard_min_capacity)
+		{
+		}
 
-private:
-	mutable nano::mutex mutex;
-	std::unordered_map<Key, std::weak_ptr<Value>> values;
-	nano::interval cleanup_interval;
+		std::shared_ptr<Value> insert (std::size_t hash, Key const & key, std::shared_ptr<Value> const & value)
+		{
+			debug_assert (!mutex.try_lock ());
+
+			auto const mask = slots.size () - 1;
+			auto index = hash & mask;
+			auto reusable = slots.size ();
+			for (; slots[index].used; index = (index + 1) & mask)
+			{
+				auto & existing = slots[index];
+				if (existing.hash == hash && existing.key == key)
+				{
+					if (auto result = existing.value.lock ())
+					{
+						return result;
+					}
+					existing.value = value;
+					return value;
+				}
+				if (reusable == slots.size () && existing.value.expired ())
+				{
+					reusable = index;
+				}
+			}
+
+			// An expired slot on the probe path can be taken over without breaking the chain for other keys
+			if (reusable != slots.size ())
+			{
+				slots[reusable] = { key, value, hash, true };
+				return value;
+			}
+
+			slots[index] = { key, value, hash, true };
+			++count;
+			// Keeping the load factor low guarantees an empty slot terminating every probe sequence
+			if (count * 2 > slots.size ())
+			{
+				rehash ();
+			}
+			return value;
+		}
+
+		/** Checks the next \p step slots from the cursor, erasing expired entries */
+		void sweep (std::size_t step)
+		{
+			debug_assert (!mutex.try_lock ());
+
+			auto const mask = slots.size () - 1;
+			for (std::size_t n = 0; n < step && count > 0; ++n)
+			{
+				if (slots[cursor].used && slots[cursor].value.expired ())
+				{
+					// A following entry may be shifted into the cursor position, it is checked on the next step
+					erase (cursor);
+				}
+				else
+				{
+					cursor = (cursor + 1) & mask;
+				}
+			}
+		}
+
+		/** Rebuilds the table with live entries only, sized for a load factor of at most 1/4 */
+		void rehash ()
+		{
+			debug_assert (!mutex.try_lock ());
+
+			std::vector<slot> live;
+			live.reserve (count);
+			for (auto & item : slots)
+			{
+				if (item.used && !item.value.expired ())
+				{
+					live.push_back (std::move (item));
+				}
+			}
+
+			slots = std::vector<slot> (std::max (shard_min_capacity, std::bit_ceil (live.size () * 4)));
+			count = live.size ();
+			cursor = 0;
+
+			auto const mask = slots.size () - 1;
+			for (auto & item : live)
+			{
+				auto index = item.hash & mask;
+				while (slots[index].used)
+				{
+					index = (index + 1) & mask;
+				}
+				slots[index] = std::move (item);
+			}
+		}
+
+	private:
+		/** Backward shift deletion, keeps probe sequences contiguous without tombstones */
+		void erase (std::size_t index)
+		{
+			auto const mask = slots.size () - 1;
+			auto hole = index;
+			for (auto next = (hole + 1) & mask; slots[next].used; next = (next + 1) & mask)
+			{
+				// The entry can fill the hole when its home slot is not between the hole and its current position
+				auto const home = slots[next].hash & mask;
+				if (((next - home) & mask) >= ((next - hole) & mask))
+				{
+					slots[hole] = std::move (slots[next]);
+					hole = next;
+				}
+			}
+			slots[hole] = slot{};
+			--count;
+		}
+
+	public:
+		std::vector<slot> slots;
+		std::size_t count{ 0 };
+		std::size_t cursor{ 0 };
+		mutable nano::mutex mutex;
+	};
+
+	std::array<shard, shard_count> shards;
 };
-}
\ No newline at end of file
+}
@@ -1,4 +1,3 @@
-#include <nano/crypto/blake2/blake2.h>
 #include <nano/crypto_lib/random_pool.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/constants.hpp>
@@ -6,6 +5,7 @@
 #include <nano/lib/thread_roles.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/lib/work.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/lib/work_version.hpp>
 #include <nano/node/xorshift.hpp>
 
@@ -31,7 +31,8 @@ nano::work_pool::work_pool (nano::network_constants & network_constants, unsigne
 	ticket (0),
 	done (false),
 	pow_rate_limiter (pow_rate_limiter_a),
-	opencl (opencl_a)
+	opencl (opencl_a),
+	kernel (nano::work_kernel::select ())
 {
 	static_assert (ATOMIC_INT_LOCK_FREE == 2, "Atomic int needed");
 
@@ -67,8 +68,8 @@ void nano::work_pool::loop (uint64_t thread)
 	nano::random_pool::generate_block (reinterpret_cast<uint8_t *> (rng.s.data ()), rng.s.size () * sizeof (decltype (rng.s)::value_type));
 	uint64_t work;
 	uint64_t output;
-	blake2b_state hash;
-	blake2b_init (&hash, sizeof (output));
+	nano::work_kernel::lanes_t nonces;
+	nano::work_kernel::lanes_t values;
 	nano::unique_lock<nano::mutex> lock{ mutex };
 	auto pow_sleep = pow_rate_limiter;
 	while (!done)
@@ -103,14 +104,19 @@ void nano::work_pool::loop (uint64_t thread)
 					// Don't query main memory every iteration in order to reduce memory bus traffic
 					// All operations here operate on stack memory
 					// Count iterations down to zero since comparing to zero is easier than comparing to another number
-					unsigned iteration (256);
+					unsigned iteration (256 / nano::work_kernel::lanes);
 					while (iteration && output < current_l.difficulty)
 					{
-						work = rng.next ();
-						blake2b_update (&hash, reinterpret_cast<uint8_t *> (&work), sizeof (work));
-						blake2b_update (&hash, current_l.item.bytes.data (), current_l.item.bytes.size ());
-						blake2b_final (&hash, reinterpret_cast<uint8_t *> (&output), sizeof (output));
-						blake2b_init (&hash, sizeof (output));
+						for (auto & nonce : nonces)
+						{
+							nonce = rng.next ();
+						}
+						kernel.values (current_l.item, nonces, values);
+						for (std::size_t lane = 0; lane < nano::work_kernel::lanes && output < current_l.difficulty; ++lane)
+						{
+							work = nonces[lane];
+							output = values[lane];
+						}
 						iteration -= 1;
 					}
 
@@ -25,6 +25,7 @@ class block_details;
 enum class block_type : uint8_t;
 
 class opencl_work;
+class work_kernel;
 class work_item final
 {
 public:
@@ -60,6 +61,8 @@ public:
 	nano::condition_variable producer_condition;
 	std::chrono::nanoseconds pow_rate_limiter;
 	nano::opencl_work_func_t opencl;
+	// CPU work generation, the widest vector kernel supported by this machine
+	nano::work_kernel const & kernel;
 	nano::observer_set<bool> work_observers;
 
 	nano::container_info container_info () const;
@@ -0,0 +1,231 @@
+#include <nano/crypto/blake2/blake2.h>
+#include <nano/lib/work_kernel.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+uint64_t constexpr blake2b_iv[8] = {
+	0x6a09e667f3bcc908ULL, 0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+	0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL, 0x5be0cd19137e2179ULL
+};
+
+uint8_t constexpr blake2b_sigma[12][16] = {
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 },
+	{ 11, 8, 12, 0, 5, 2, 15, 13, 10, 14, 3, 6, 7, 1, 9, 4 },
+	{ 7, 9, 3, 1, 13, 12, 11, 14, 2, 6, 5, 10, 4, 0, 15, 8 },
+	{ 9, 0, 5, 7, 2, 4, 10, 15, 14, 1, 11, 12, 6, 8, 3, 13 },
+	{ 2, 12, 6, 10, 0, 11, 8, 3, 4, 13, 7, 5, 15, 14, 1, 9 },
+	{ 12, 5, 1, 15, 14, 13, 4, 10, 0, 7, 6, 3, 9, 2, 8, 11 },
+	{ 13, 11, 7, 14, 12, 1, 3, 9, 5, 0, 15, 4, 8, 6, 2, 10 },
+	{ 6, 15, 14, 9, 11, 3, 0, 8, 12, 2, 13, 7, 1, 4, 10, 5 },
+	{ 10, 2, 8, 4, 7, 6, 1, 5, 15, 11, 9, 14, 3, 12, 13, 0 },
+	{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 },
+	{ 14, 10, 4, 8, 9, 15, 13, 6, 1, 12, 0, 2, 11, 7, 5, 3 }
+};
+
+void values_scalar (nano::root const * roots, std::size_t stride, nano::work_kernel::lanes_t const & nonces, nano::work_kernel::lanes_t & values)
+{
+	for (std::size_t lane = 0; lane < nano::work_kernel::lanes; ++lane)
+	{
+		auto const & root = roots[lane * stride];
+		uint64_t nonce = nonces[lane];
+		blake2b_state hash;
+		blake2b_init (&hash, sizeof (values[lane]));
+		blake2b_update (&hash, reinterpret_cast<uint8_t *> (&nonce), sizeof (nonce));
+		blake2b_update (&hash, root.bytes.data (), root.bytes.size ());
+		blake2b_final (&hash, reinterpret_cast<uint8_t *> (&values[lane]), sizeof (values[lane]));
+	}
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__))
+#define NANO_WORK_KERNEL_VECTOR
+
+// One nonce per vector lane, the width matches the registers of the target instruction set
+// Vector attributes are not applied to dependent alias templates, each width is spelled out
+template <std::size_t width>
+struct vector;
+template <>
+struct vector<2>
+{
+	using type = uint64_t __attribute__ ((vector_size (16)));
+};
+template <>
+struct vector<4>
+{
+	using type = uint64_t __attribute__ ((vector_size (32)));
+};
+template <>
+struct vector<8>
+{
+	using type = uint64_t __attribute__ ((vector_size (64)));
+};
+
+// Vectors are only passed by reference, passing them by value would depend on the instruction set enabled for each function
+template <unsigned shift, typename vector_t>
+[[gnu::always_inline]] inline void rotr (vector_t & value)
+{
+	value = (value >> shift) | (value << (64 - shift));
+}
+
+template <typename vector_t>
+[[gnu::always_inline]] inline void mix (vector_t & a, vector_t & b, vector_t & c, vector_t & d, vector_t const & x, vector_t const & y)
+{
+	a += b + x;
+	d ^= a;
+	rotr<32> (d);
+	c += d;
+	b ^= c;
+	rotr<24> (b);
+	a += b + y;
+	d ^= a;
+	rotr<16> (d);
+	c += d;
+	b ^= c;
+	rotr<63> (b);
+}
+
+/**
+ * Single block blake2b with an 8 byte digest of [nonce][root], the whole work_1 input fits into one compression.
+ * Only the first message word differs between lanes, the kernel lanes are processed in batches of the vector width.
+ */
+template <std::size_t width>
+[[gnu::always_inline]] inline void values_batch (nano::root const * roots, std::size_t stride, uint64_t const * nonces, uint64_t * values)
+{
+	using vector_t = typename vector<width>::type;
+	vector_t const zero{};
+	vector_t message[16];
+	std::memcpy (&message[0], nonces, sizeof (vector_t));
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		if (stride == 0)
+		{
+			uint64_t word;
+			std::memcpy (&word, roots->bytes.data () + i * sizeof (word), sizeof (word));
+			message[i + 1] = zero + word;
+		}
+		else
+		{
+			// Transposes the roots, so each vector holds the same root word of every lane
+			for (std::size_t lane = 0; lane < width; ++lane)
+			{
+				uint64_t word;
+				std::memcpy (&word, roots[lane * stride].bytes.data () + i * sizeof (word), sizeof (word));
+				message[i + 1][lane] = word;
+			}
+		}
+	}
+	for (std::size_t i = 5; i < 16; ++i)
+	{
+		message[i] = zero;
+	}
+
+	// Parameter block: 8 byte digest, no key, fanout and depth of 1
+	uint64_t const h0 = blake2b_iv[0] ^ 0x01010000ULL ^ sizeof (uint64_t);
+	vector_t v[16] = {
+		zero + h0, zero + blake2b_iv[1], zero + blake2b_iv[2], zero + blake2b_iv[3],
+		zero + blake2b_iv[4], zero + blake2b_iv[5], zero + blake2b_iv[6], zero + blake2b_iv[7],
+		zero + blake2b_iv[0], zero + blake2b_iv[1], zero + blake2b_iv[2], zero + blake2b_iv[3],
+		// Input length of 40 bytes, last block flag set
+		zero + (blake2b_iv[4] ^ (sizeof (uint64_t) + sizeof (nano::root))), zero + blake2b_iv[5], zero + ~blake2b_iv[6], zero + blake2b_iv[7]
+	};
+	for (auto const & s : blake2b_sigma)
+	{
+		mix (v[0], v[4], v[8], v[12], message[s[0]], message[s[1]]);
+		mix (v[1], v[5], v[9], v[13], message[s[2]], message[s[3]]);
+		mix (v[2], v[6], v[10], v[14], message[s[4]], message[s[5]]);
+		mix (v[3], v[7], v[11], v[15], message[s[6]], message[s[7]]);
+		mix (v[0], v[5], v[10], v[15], message[s[8]], message[s[9]]);
+		mix (v[1], v[6], v[11], v[12], message[s[10]], message[s[11]]);
+		mix (v[2], v[7], v[8], v[13], message[s[12]], message[s[13]]);
+		mix (v[3], v[4], v[9], v[14], message[s[14]], message[s[15]]);
+	}
+	vector_t const result = (zero + h0) ^ v[0] ^ v[8];
+	std::memcpy (values, &result, sizeof (result));
+}
+
+template <std::size_t width>
+[[gnu::always_inline]] inline void values_vector (nano::root const * roots, std::size_t stride, nano::work_kernel::lanes_t const & nonces, nano::work_kernel::lanes_t & values)
+{
+	static_assert (nano::work_kernel::lanes % width == 0);
+	for (std::size_t lane = 0; lane < nano::work_kernel::lanes; lane += width)
+	{
+		values_batch<width> (roots + lane * stride, stride, nonces.data () + lane, values.data () + lane);
+	}
+}
+#endif
+
+#if defined(NANO_WORK_KERNEL_VECTOR) && defined(__x86_64__)
+[[gnu::target ("avx512f")]] void values_avx512 (nano::root const * roots, std::size_t stride, nano::work_kernel::lanes_t const & nonces, nano::work_kernel::lanes_t & values)
+{
+	values_vector<8> (roots, stride, nonces, values);
+}
+
+[[gnu::target ("avx2")]] void values_avx2 (nano::root const * roots, std::size_t stride, nano::work_kernel::lanes_t const & nonces, nano::work_kernel::lanes_t & values)
+{
+	values_vector<4> (roots, stride, nonces, values);
+}
+#endif
+
+#if defined(NANO_WORK_KERNEL_VECTOR) && defined(__aarch64__)
+// Advanced SIMD is part of the aarch64 baseline
+void values_neon (nano::root const * roots, std::size_t stride, nano::work_kernel::lanes_t const & nonces, nano::work_kernel::lanes_t & values)
+{
+	values_vector<2> (roots, stride, nonces, values);
+}
+#endif
+}
+
+std::vector<nano::work_kernel> const & nano::work_kernel::all ()
+{
+	static std::vector<nano::work_kernel> const kernels{ [] () {
+		std::vector<nano::work_kernel> result;
+#if defined(NANO_WORK_KERNEL_VECTOR) && defined(__x86_64__)
+		result.push_back ({ "avx512", values_avx512 });
+		result.push_back ({ "avx2", values_avx2 });
+#endif
+#if defined(NANO_WORK_KERNEL_VECTOR) && defined(__aarch64__)
+		result.push_back ({ "neon", values_neon });
+#endif
+		result.push_back ({ "scalar", values_scalar });
+		return result;
+	}() };
+	return kernels;
+}
+
+std::vector<nano::work_kernel const *> nano::work_kernel::supported ()
+{
+	std::vector<nano::work_kernel const *> result;
+	for (auto const & kernel : all ())
+	{
+		bool supported = true;
+#if defined(NANO_WORK_KERNEL_VECTOR) && defined(__x86_64__)
+		if (kernel.name == "avx512")
+		{
+			supported = __builtin_cpu_supports ("avx512f");
+		}
+		else if (kernel.name == "avx2")
+		{
+			supported = __builtin_cpu_supports ("avx2");
+		}
+#endif
+		if (supported)
+		{
+			result.push_back (&kernel);
+		}
+	}
+	return result;
+}
+
+nano::work_kernel const & nano::work_kernel::select ()
+{
+	static nano::work_kernel const & selected = *supported ().front ();
+	return selected;
+}
+
+nano::work_kernel const & nano::work_kernel::scalar ()
+{
+	return all ().back ();
+}
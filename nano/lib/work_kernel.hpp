@@ -0,0 +1,57 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace nano
+{
+/**
+ * CPU kernel computing work_1 values, several nonces for the same root at a time
+ * Vectorized kernels hash one nonce per vector lane and are selected at runtime from the instruction sets supported by the CPU.
+ * The scalar kernel hashes one nonce at a time with the reference blake2b implementation and is used when no vector kernel is available.
+ */
+class work_kernel final
+{
+public:
+	static std::size_t constexpr lanes = 8;
+	using lanes_t = std::array<uint64_t, lanes>;
+	using roots_t = std::array<nano::root, lanes>;
+
+	/** Computes the work values of all \p nonces for \p root */
+	void values (nano::root const & root, lanes_t const & nonces, lanes_t & values) const
+	{
+		function (&root, 0, nonces, values);
+	}
+	/** Computes the work value of each nonce for the root in the same lane */
+	void values (roots_t const & roots, lanes_t const & nonces, lanes_t & values) const
+	{
+		function (roots.data (), 1, nonces, values);
+	}
+
+	std::string_view name;
+
+public:
+	/** Fastest kernel supported by this CPU */
+	static nano::work_kernel const & select ();
+	static nano::work_kernel const & scalar ();
+	/** All kernels supported by this CPU, fastest first */
+	static std::vector<nano::work_kernel const *> supported ();
+
+private:
+	// Roots are read with a stride of 0 when all lanes share the same root
+	using function_t = void (*) (nano::root const * roots, std::size_t stride, lanes_t const &, lanes_t &);
+	function_t function;
+
+	work_kernel (std::string_view name, function_t function) :
+		name{ name },
+		function{ function }
+	{
+	}
+
+	static std::vector<nano::work_kernel> const & all ();
+};
+}
@@ -86,6 +86,24 @@ void nano::daemon::run (std::filesystem::path const & data_path, nano::node_flag
 
 	nano::set_use_memory_pools (config.node.use_memory_pools);
 
+	// Applied before any node threads are started, threads are placed when they take their role
+	try
+	{
+		nano::thread_placement::apply (config.thread_placement);
+	}
+	catch (std::invalid_argument const & ex)
+	{
+		logger.critical (nano::log::type::daemon, "Error applying thread placement: {}", ex.what ());
+		std::exit (1);
+	}
+	for (auto const & [role, spec] : config.thread_placement.roles)
+	{
+		if (auto cpus = nano::thread_placement::cpus (role); !cpus.empty ())
+		{
+			logger.info (nano::log::type::daemon, "Thread placement: {} on CPUs {}", nano::thread_role::to_string (role), nano::thread_placement::format_cpus (cpus));
+		}
+	}
+
 	std::shared_ptr<boost::asio::io_context> io_ctx = std::make_shared<boost::asio::io_context> ();
 
 	auto opencl = nano::opencl_work::create (config.opencl_enable, config.opencl, logger, config.node.network_params.work);
@@ -5,6 +5,7 @@
 #include <nano/lib/files.hpp>
 #include <nano/lib/thread_runner.hpp>
 #include <nano/lib/utility.hpp>
+#include <nano/lib/work_kernel.hpp>
 #include <nano/lib/work_version.hpp>
 #include <nano/nano_node/daemon.hpp>
 #include <nano/node/active_elections.hpp>
@@ -550,10 +551,32 @@ int main (int argc, char * const * argv)
 				pow_rate_limiter = std::chrono::nanoseconds (boost::lexical_cast<uint64_t> (pow_sleep_interval_it->second.as<std::string> ()));
 			}
 
+			// Single thread hash rate of every CPU kernel supported by this machine
+			for (auto kernel : nano::work_kernel::supported ())
+			{
+				nano::root root{ 1 };
+				nano::work_kernel::lanes_t nonces{};
+				nano::work_kernel::lanes_t values{};
+				uint64_t hashes{ 0 };
+				auto begin1 (std::chrono::steady_clock::now ());
+				while (std::chrono::steady_clock::now () - begin1 < std::chrono::seconds (1))
+				{
+					for (auto i (0); i < 1024; ++i)
+					{
+						nonces[0] = hashes;
+						kernel->values (root, nonces, values);
+						hashes += nano::work_kernel::lanes;
+					}
+				}
+				auto elapsed (std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now () - begin1));
+				std::cerr << boost::str (boost::format ("Kernel %1%: %2% MH/s per thread\n") % kernel->name % nano::to_string (static_cast<double> (hashes) / elapsed.count (), 2));
+			}
+
 			nano::work_pool work{ network_params.network, std::numeric_limits<unsigned>::max (), pow_rate_limiter };
 			nano::change_block block (0, 0, nano::keypair ().prv, 0, 0);
 			if (!result)
 			{
+				std::cerr << boost::str (boost::format ("Using %1% kernel on %2% threads\n") % work.kernel.name % work.threads.size ());
 				std::cerr << boost::str (boost::format ("Starting generation profiling. Difficulty: %1$#x (%2%x from base difficulty %3$#x)\n") % difficulty % nano::to_string (nano::difficulty::to_multiplier (difficulty, nano::work_thresholds::publish_full.base), 4) % nano::work_thresholds::publish_full.base);
 				while (!result)
 				{
@@ -581,6 +604,30 @@ int main (int argc, char * const * argv)
 			auto total_time (std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - start).count ());
 			uint64_t average (total_time / count);
 			std::cout << "Average validation time: " << std::to_string (average) << " ns (" << std::to_string (static_cast<unsigned> (count * 1e9 / total_time)) << " validations/s)" << std::endl;
+
+			// Batched validation of distinct roots, as done for blocks received together
+			std::cerr << "Starting batched validation profile (" << nano::work_kernel::select ().name << " kernel)" << std::endl;
+			std::size_t const batch_size{ 1024 };
+			std::vector<nano::root> roots (batch_size);
+			std::vector<uint64_t> works (batch_size);
+			std::vector<uint64_t> values (batch_size);
+			for (uint64_t i (0); i < batch_size; ++i)
+			{
+				roots[i] = nano::root{ i };
+			}
+			uint64_t valid_count{ 0 };
+			count = count / batch_size * batch_size;
+			start = std::chrono::steady_clock::now ();
+			for (uint64_t i (0); i < count; i += batch_size)
+			{
+				std::fill (works.begin (), works.end (), i);
+				network_params.work.values (roots, works, values);
+				valid_count += std::count_if (values.begin (), values.end (), [difficulty] (uint64_t value) { return value > difficulty; });
+			}
+			std::ostringstream oss_batched (std::to_string (valid_count)); // IO forces compiler to not dismiss the variable
+			total_time = std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now () - start).count ();
+			average = total_time / count;
+			std::cout << "Average batched validation time: " << std::to_string (average) << " ns (" << std::to_string (static_cast<unsigned> (count * 1e9 / total_time)) << " validations/s)" << std::endl;
 		}
 		else if (vm.count ("debug_opencl"))
 		{
@@ -1,6 +1,9 @@
+#include <nano/lib/blocks.hpp>
 #include <nano/lib/thread_roles.hpp>
 #include <nano/lib/threading.hpp>
 #include <nano/node/backlog_scan.hpp>
+#include <nano/node/confirming_set.hpp>
+#include <nano/node/ledger_notifications.hpp>
 #include <nano/node/nodeconfig.hpp>
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/secure/ledger.hpp>
@@ -8,12 +11,52 @@
 #include <nano/store/component.hpp>
 #include <nano/store/confirmation_height.hpp>
 
-nano::backlog_scan::backlog_scan (backlog_scan_config const & config_a, nano::ledger & ledger_a, nano::stats & stats_a) :
+nano::backlog_scan::backlog_scan (backlog_scan_config const & config_a, nano::ledger & ledger_a, nano::ledger_notifications & ledger_notifications_a, nano::confirming_set & confirming_set_a, nano::stats & stats_a) :
 	config{ config_a },
 	ledger{ ledger_a },
+	ledger_notifications{ ledger_notifications_a },
+	confirming_set{ confirming_set_a },
 	stats{ stats_a },
 	limiter{ config.rate_limit }
 {
+	// Track accounts with fresh blocks, bulk ingested chains are deferred until the bulk ingestion settles
+	ledger_notifications.blocks_processed.add ([this] (auto const & batch) {
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		for (auto const & [result, context] : batch)
+		{
+			if (result == nano::block_status::progress)
+			{
+				release_assert (context.block != nullptr);
+				if (context.source == nano::block_source::bootstrap_bulk)
+				{
+					defer (context.block->account ());
+				}
+				else
+				{
+					track (context.block->account ());
+				}
+			}
+		}
+	});
+
+	// Rescan accounts with rolled back blocks, they may have become fully confirmed
+	ledger_notifications.blocks_rolled_back.add ([this] (auto const & blocks, auto const & rollback_root) {
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		for (auto const & block : blocks)
+		{
+			track (block->account ());
+		}
+	});
+
+	// Rescan accounts with cemented blocks, so fully confirmed accounts are reported as scanned and dropped
+	confirming_set.batch_cemented.add ([this] (auto const & batch) {
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		for (auto const & context : batch)
+		{
+			release_assert (context.block != nullptr);
+			track (context.block->account ());
+		}
+	});
 }
 
 nano::backlog_scan::~backlog_scan ()
@@ -61,6 +104,70 @@ bool nano::backlog_scan::predicate () const
 	return triggered || config.enable;
 }
 
+size_t nano::backlog_scan::tracked_size () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return tracked.size ();
+}
+
+void nano::backlog_scan::track (nano::account const & account)
+{
+	debug_assert (!mutex.try_lock ());
+
+	auto existing = tracked.find (account);
+	if (existing != tracked.end ())
+	{
+		existing->second = ++tracked_sequence;
+		return;
+	}
+	if (tracked.size () >= config.max_tracked)
+	{
+		// Tracked set no longer covers all unconfirmed accounts, fall back to a full scan
+		stats.inc (nano::stat::type::backlog_scan, nano::stat::detail::tracked_overflow);
+		full_scan_pending = true;
+		return;
+	}
+	tracked.emplace (account, ++tracked_sequence);
+}
+
+void nano::backlog_scan::defer (nano::account const & account)
+{
+	debug_assert (!mutex.try_lock ());
+
+	deferred_last = std::chrono::steady_clock::now ();
+	if (deferred.size () >= config.max_tracked)
+	{
+		// Deferred accounts are covered by a full scan once the bulk ingestion settles
+		deferred_overflow = true;
+		return;
+	}
+	if (deferred.insert (account).second)
+	{
+		stats.inc (nano::stat::type::backlog_scan, nano::stat::detail::deferred);
+	}
+}
+
+void nano::backlog_scan::release_deferred ()
+{
+	debug_assert (!mutex.try_lock ());
+
+	if ((deferred.empty () && !deferred_overflow) || std::chrono::steady_clock::now () - deferred_last < config.deferred_settle)
+	{
+		return;
+	}
+	stats.add (nano::stat::type::backlog_scan, nano::stat::detail::deferred_released, deferred.size ());
+	for (auto const & account : deferred)
+	{
+		track (account);
+	}
+	deferred.clear ();
+	if (deferred_overflow)
+	{
+		full_scan_pending = true;
+		deferred_overflow = false;
+	}
+}
+
 void nano::backlog_scan::run ()
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
@@ -69,8 +176,21 @@ void nano::backlog_scan::run ()
 		if (predicate ())
 		{
 			stats.inc (nano::stat::type::backlog_scan, nano::stat::detail::loop);
-			triggered = false;
-			populate_backlog (lock); // Does a single iteration over all accounts
+			release_deferred ();
+			if (triggered || full_scan_pending || full_scan_interval.elapse (config.full_scan_interval))
+			{
+				stats.inc (nano::stat::type::backlog_scan, nano::stat::detail::full_scan);
+				triggered = false;
+				full_scan_pending = false;
+				populate_backlog (lock); // Does a single iteration over all accounts
+			}
+			else
+			{
+				populate_tracked (lock); // Does a single iteration over tracked accounts
+				condition.wait_for (lock, config.tracked_interval, [this] () {
+					return stopped || triggered || full_scan_pending;
+				});
+			}
 			debug_assert (lock.owns_lock ());
 		}
 		else
@@ -82,6 +202,21 @@ void nano::backlog_scan::run ()
 	}
 }
 
+// Returns true if stopped while waiting
+bool nano::backlog_scan::wait_limiter (nano::unique_lock<nano::mutex> & lock)
+{
+	while (!limiter.should_pass (config.batch_size))
+	{
+		std::chrono::milliseconds const wait_time{ 1000 / std::max ((config.rate_limit / config.batch_size), size_t{ 1 }) / 2 };
+		condition.wait_for (lock, std::max (wait_time, 10ms));
+		if (stopped)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 void nano::backlog_scan::populate_backlog (nano::unique_lock<nano::mutex> & lock)
 {
 	uint64_t total = 0;
@@ -90,15 +225,9 @@ void nano::backlog_scan::populate_backlog (nano::unique_lock<nano::mutex> & lock
 	bool done = false;
 	while (!stopped && !done)
 	{
-		// Wait for the rate limiter
-		while (!limiter.should_pass (config.batch_size))
+		if (wait_limiter (lock))
 		{
-			std::chrono::milliseconds const wait_time{ 1000 / std::max ((config.rate_limit / config.batch_size), size_t{ 1 }) / 2 };
-			condition.wait_for (lock, std::max (wait_time, 10ms));
-			if (stopped)
-			{
-				return;
-			}
+			return;
 		}
 
 		lock.unlock ();
@@ -141,6 +270,93 @@ void nano::backlog_scan::populate_backlog (nano::unique_lock<nano::mutex> & lock
 		batch_activated.notify (activated);
 
 		lock.lock ();
+
+		for (auto const & info : activated)
+		{
+			track (info.account);
+		}
+	}
+}
+
+void nano::backlog_scan::populate_tracked (nano::unique_lock<nano::mutex> & lock)
+{
+	nano::account next = 0;
+	bool done = false;
+	while (!stopped && !done && !full_scan_pending)
+	{
+		if (wait_limiter (lock))
+		{
+			return;
+		}
+
+		// Copy the batch, accounts can be tracked again while the lock is released
+		std::vector<std::pair<nano::account, uint64_t>> batch;
+		for (auto it = tracked.lower_bound (next); it != tracked.end () && batch.size () < config.batch_size; ++it)
+		{
+			batch.push_back (*it);
+		}
+		done = batch.size () < config.batch_size;
+		if (batch.empty ())
+		{
+			break;
+		}
+		next = inc_sat (batch.back ().first.number ());
+		done |= next == std::numeric_limits<nano::uint256_t>::max ();
+
+		lock.unlock ();
+
+		std::deque<activated_info> scanned;
+		std::deque<activated_info> activated;
+		std::vector<std::pair<nano::account, uint64_t>> confirmed;
+		{
+			auto transaction = ledger.tx_begin_read ();
+
+			for (auto const & [account, sequence] : batch)
+			{
+				stats.inc (nano::stat::type::backlog_scan, nano::stat::detail::total);
+
+				auto const maybe_account_info = ledger.store.account.get (transaction, account);
+				if (!maybe_account_info)
+				{
+					confirmed.emplace_back (account, sequence); // Account was rolled back entirely
+					continue;
+				}
+				auto const & account_info = *maybe_account_info;
+				auto const conf_info = ledger.store.confirmation_height.get (transaction, account).value_or (nano::confirmation_height_info{});
+
+				activated_info info{ account, account_info, conf_info };
+
+				scanned.push_back (info);
+				if (conf_info.height < account_info.block_count)
+				{
+					activated.push_back (info);
+				}
+				else
+				{
+					confirmed.emplace_back (account, sequence);
+				}
+			}
+		}
+
+		stats.add (nano::stat::type::backlog_scan, nano::stat::detail::scanned, scanned.size ());
+		stats.add (nano::stat::type::backlog_scan, nano::stat::detail::activated, activated.size ());
+
+		// Notify about scanned and activated accounts without holding database transaction
+		batch_scanned.notify (scanned);
+		batch_activated.notify (activated);
+
+		lock.lock ();
+
+		// Accounts tracked again after being read may have new unconfirmed blocks, those are kept
+		for (auto const & [account, sequence] : confirmed)
+		{
+			auto existing = tracked.find (account);
+			if (existing != tracked.end () && existing->second == sequence)
+			{
+				tracked.erase (existing);
+				stats.inc (nano::stat::type::backlog_scan, nano::stat::detail::untracked);
+			}
+		}
 	}
 }
 
@@ -149,6 +365,8 @@ nano::container_info nano::backlog_scan::container_info () const
 	nano::lock_guard<nano::mutex> guard{ mutex };
 	nano::container_info info;
 	info.put ("limiter", limiter.size ());
+	info.put ("tracked", tracked.size (), sizeof (decltype (tracked)::value_type));
+	info.put ("deferred", deferred.size (), sizeof (decltype (deferred)::value_type));
 	return info;
 }
 
@@ -161,6 +379,10 @@ nano::error nano::backlog_scan_config::serialize (nano::tomlconfig & toml) const
 	toml.put ("enable", enable, "Control if ongoing backlog population is enabled. If not, backlog population can still be triggered by RPC \ntype:bool");
 	toml.put ("batch_size", batch_size, "Size of a single batch. Larger batches reduce overhead, but may put more pressure on other node components. \ntype:uint");
 	toml.put ("rate_limit", rate_limit, "Number of accounts per second to process when doing backlog population scan. Increasing this value will help unconfirmed frontiers get into election prioritization queue faster. Use 0 to process as fast as possible, but be aware that it may consume a lot of resources. \ntype:uint");
+	toml.put ("max_tracked", max_tracked, "Maximum number of possibly unconfirmed accounts tracked between full scans of the accounts table. When exceeded, the scan falls back to iterating all accounts. \ntype:uint");
+	toml.put ("tracked_interval", tracked_interval.count (), "Minimum interval between scans of tracked accounts. \ntype:seconds");
+	toml.put ("full_scan_interval", full_scan_interval.count (), "Interval between full scans of the accounts table. Accounts with new, cemented or rolled back blocks are tracked and scanned without waiting for a full scan. \ntype:seconds");
+	toml.put ("deferred_settle", deferred_settle.count (), "Accounts with blocks ingested in bulk by the bootstrap are tracked once no bulk blocks arrived for this long. \ntype:seconds");
 
 	return toml.get_error ();
 }
@@ -170,6 +392,19 @@ nano::error nano::backlog_scan_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("enable", enable);
 	toml.get ("batch_size", batch_size);
 	toml.get ("rate_limit", rate_limit);
+	toml.get ("max_tracked", max_tracked);
+
+	auto tracked_interval_l = tracked_interval.count ();
+	toml.get ("tracked_interval", tracked_interval_l);
+	tracked_interval = std::chrono::seconds{ tracked_interval_l };
+
+	auto full_scan_interval_l = full_scan_interval.count ();
+	toml.get ("full_scan_interval", full_scan_interval_l);
+	full_scan_interval = std::chrono::seconds{ full_scan_interval_l };
+
+	auto deferred_settle_l = deferred_settle.count ();
+	toml.get ("deferred_settle", deferred_settle_l);
+	deferred_settle = std::chrono::seconds{ deferred_settle_l };
 
 	return toml.get_error ();
 }
@@ -1,22 +1,37 @@
 #pragma once
 
+#include <nano/lib/interval.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/numbers_templ.hpp>
 #include <nano/lib/observer_set.hpp>
 #include <nano/lib/rate_limiting.hpp>
 #include <nano/node/fwd.hpp>
 #include <nano/secure/account_info.hpp>
 #include <nano/secure/common.hpp>
 
+#include <chrono>
 #include <condition_variable>
 #include <deque>
+#include <map>
 #include <thread>
+#include <unordered_set>
 
 namespace nano
 {
 class backlog_scan_config final
 {
 public:
+	explicit backlog_scan_config (nano::network_constants const & network)
+	{
+		if (network.is_dev_network ())
+		{
+			// Tests often write to the ledger directly, without block notifications
+			full_scan_interval = 1s;
+			deferred_settle = 1s;
+		}
+	}
+
 	nano::error deserialize (nano::tomlconfig &);
 	nano::error serialize (nano::tomlconfig &) const;
 
@@ -27,12 +42,26 @@ public:
 	size_t rate_limit{ 10000 };
 	/** Number of accounts per second to process. */
 	size_t batch_size{ 1000 };
+	/** Maximum number of possibly unconfirmed accounts tracked between full scans. When exceeded, the next pass iterates the whole accounts table. */
+	size_t max_tracked{ 1024 * 1024 };
+	/** Minimum interval between passes over the tracked accounts */
+	std::chrono::seconds tracked_interval{ 1 };
+	/** Interval between full scans of the accounts table, covering accounts modified without block notifications */
+	std::chrono::seconds full_scan_interval{ 60 * 60 };
+	/** Accounts with bulk ingested blocks are tracked once no bulk blocks arrived for this long */
+	std::chrono::seconds deferred_settle{ 10 };
 };
 
+/**
+ * Periodically notifies about accounts with unconfirmed blocks.
+ * The whole accounts table is scanned at startup, on manual trigger, when too many accounts are tracked and rarely on a timer. Otherwise only accounts that
+ * received, cemented or rolled back blocks since the last pass are scanned, so reaction time does not depend on the size of the ledger.
+ * Accounts of chains ingested in bulk during the initial sync are held back and only tracked once the bulk ingestion settles.
+ */
 class backlog_scan final
 {
 public:
-	backlog_scan (backlog_scan_config const &, nano::ledger &, nano::stats &);
+	backlog_scan (backlog_scan_config const &, nano::ledger &, nano::ledger_notifications &, nano::confirming_set &, nano::stats &);
 	~backlog_scan ();
 
 	void start ();
@@ -44,6 +73,9 @@ public:
 	/** Notify about AEC vacancy */
 	void notify ();
 
+	/** Number of accounts tracked as possibly having unconfirmed blocks */
+	size_t tracked_size () const;
+
 	nano::container_info container_info () const;
 
 public:
@@ -61,12 +93,22 @@ public:
 private: // Dependencies
 	backlog_scan_config const & config;
 	nano::ledger & ledger;
+	nano::ledger_notifications & ledger_notifications;
+	nano::confirming_set & confirming_set;
 	nano::stats & stats;
 
 private:
 	void run ();
 	bool predicate () const;
+	/** Iterates over all accounts, seeding the tracked set */
 	void populate_backlog (nano::unique_lock<nano::mutex> & lock);
+	/** Iterates over the tracked accounts only, dropping those that are fully confirmed */
+	void populate_tracked (nano::unique_lock<nano::mutex> & lock);
+	bool wait_limiter (nano::unique_lock<nano::mutex> & lock);
+	void track (nano::account const &);
+	void defer (nano::account const &);
+	/** Tracks the deferred accounts once no bulk blocks arrived for the settle time */
+	void release_deferred ();
 
 private:
 	nano::rate_limiter limiter;
@@ -75,6 +117,18 @@ private:
 	 *  It can be triggered even when backlog population (frontiers confirmation) is disabled. */
 	bool triggered{ false };
 
+	/** Possibly unconfirmed accounts, mapped to a sequence number updated each time the account is tracked again */
+	std::map<nano::account, uint64_t> tracked;
+	uint64_t tracked_sequence{ 0 };
+	/** Tracked set is incomplete, either not seeded yet or it overflowed */
+	bool full_scan_pending{ true };
+	nano::interval full_scan_interval;
+
+	/** Accounts with bulk ingested blocks, waiting for the bulk ingestion to settle */
+	std::unordered_set<nano::account> deferred;
+	std::chrono::steady_clock::time_point deferred_last{};
+	bool deferred_overflow{ false };
+
 	bool stopped{ false };
 	nano::condition_variable condition;
 	mutable nano::mutex mutex;
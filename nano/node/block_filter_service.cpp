@@ -0,0 +1,211 @@
+#include <nano/lib/logging.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/timer.hpp>
+#include <nano/lib/tomlconfig.hpp>
+#include <nano/node/block_filter_service.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/store/block.hpp>
+#include <nano/store/component.hpp>
+
+#include <boost/container_hash/hash.hpp>
+
+nano::block_filter_service::block_filter_service (nano::block_filter_config const & config_a, std::filesystem::path const & application_path_a, nano::ledger & ledger_a, nano::stats & stats_a, nano::logger & logger_a) :
+	config{ config_a },
+	ledger{ ledger_a },
+	stats{ stats_a },
+	logger{ logger_a },
+	path{ application_path_a / "block_filter.dat" },
+	filter{ ledger_a.store.block_filter }
+{
+}
+
+nano::block_filter_service::~block_filter_service ()
+{
+	debug_assert (!thread.joinable ());
+}
+
+void nano::block_filter_service::start ()
+{
+	debug_assert (!thread.joinable ());
+
+	if (!config.enable)
+	{
+		return;
+	}
+
+	// Sizing the filter must happen before any other component starts writing blocks
+	filter.reset (ledger.block_count () + config.headroom, config.bits_per_block);
+
+	thread = std::thread ([this] {
+		nano::thread_role::set (nano::thread_role::name::block_filter);
+		run ();
+	});
+}
+
+void nano::block_filter_service::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+
+		// Blocks can no longer be written, the saved filter matches the ledger
+		if (!filter.save (path, ledger_tag ()))
+		{
+			stats.inc (nano::stat::type::block_filter, nano::stat::detail::saved);
+			logger.info (nano::log::type::block_filter, "Saved block filter ({} blocks)", ledger.block_count ());
+		}
+	}
+}
+
+void nano::block_filter_service::run ()
+{
+	populate ();
+
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		condition.wait_for (lock, report_interval, [this] { return stopped.load (); });
+		if (!stopped)
+		{
+			stats.inc (nano::stat::type::block_filter, nano::stat::detail::loop);
+
+			lock.unlock ();
+			report ();
+			if (ledger.block_count () > filter.capacity ())
+			{
+				grow ();
+			}
+			lock.lock ();
+		}
+	}
+}
+
+void nano::block_filter_service::populate ()
+{
+	nano::timer<std::chrono::milliseconds> timer{ nano::timer_state::started };
+
+	auto const block_count = ledger.block_count ();
+	bool const loaded = !filter.load (path, ledger_tag ());
+	// A stale file must never be loaded after an unclean shutdown, it is written again on stop
+	std::error_code ec;
+	std::filesystem::remove (path, ec);
+
+	if (loaded)
+	{
+		stats.inc (nano::stat::type::block_filter, nano::stat::detail::loaded);
+		logger.info (nano::log::type::block_filter, "Loaded block filter ({} blocks, {} ms)", block_count, timer.since_start ().count ());
+	}
+	else
+	{
+		stats.inc (nano::stat::type::block_filter, nano::stat::detail::load_failed);
+		logger.info (nano::log::type::block_filter, "Rebuilding block filter ({} blocks)...", block_count);
+		if (rebuild ())
+		{
+			return;
+		}
+		stats.inc (nano::stat::type::block_filter, nano::stat::detail::rebuild);
+		logger.info (nano::log::type::block_filter, "Rebuilt block filter ({} ms)", timer.since_start ().count ());
+	}
+	filter.ready_set ();
+}
+
+bool nano::block_filter_service::rebuild ()
+{
+	ledger.store.block.for_each_par (
+	[this] (nano::store::read_transaction const &, auto i, auto n) {
+		for (; i != n && !stopped; ++i)
+		{
+			filter.insert (i->first);
+		}
+	});
+	return stopped;
+}
+
+/** Refills the filter into a table with twice the capacity, so the false positive rate stays bounded as the ledger grows */
+void nano::block_filter_service::grow ()
+{
+	nano::timer<std::chrono::milliseconds> timer{ nano::timer_state::started };
+
+	auto const block_count = ledger.block_count ();
+	auto const capacity = block_count + std::max<uint64_t> (block_count, config.headroom);
+	logger.info (nano::log::type::block_filter, "Growing block filter ({} blocks, capacity {} -> {})...", block_count, filter.capacity (), capacity);
+
+	filter.grow_begin (capacity);
+	{
+		// Blocks inserted before the new table was published are committed once the write lock is acquired, so the scan sees them
+		auto transaction = ledger.tx_begin_write ();
+	}
+	if (rebuild ())
+	{
+		filter.grow_abort ();
+		return;
+	}
+	filter.grow_end ();
+	stats.inc (nano::stat::type::block_filter, nano::stat::detail::grow);
+	logger.info (nano::log::type::block_filter, "Grew block filter ({} ms)", timer.since_start ().count ());
+}
+
+void nano::block_filter_service::report ()
+{
+	auto const current = filter.counters_get ();
+	stats.add (nano::stat::type::block_filter, nano::stat::detail::filtered, current.filtered - reported.filtered);
+	stats.add (nano::stat::type::block_filter, nano::stat::detail::false_positive, current.false_positives - reported.false_positives);
+
+	// False positive rate of lookups for missing blocks since the last report
+	auto const negatives = (current.filtered - reported.filtered) + (current.false_positives - reported.false_positives);
+	if (negatives > 0)
+	{
+		auto const rate_ppm = (current.false_positives - reported.false_positives) * 1000000 / negatives;
+		stats.sample (nano::stat::sample::block_filter_false_positive_ppm, rate_ppm, { 0, 1000000 });
+	}
+	reported = current;
+}
+
+/** Identifies the ledger state, a saved filter is discarded if blocks were added or removed while the node was offline */
+uint64_t nano::block_filter_service::ledger_tag () const
+{
+	uint64_t result = ledger.block_count ();
+	boost::hash_combine (result, ledger.account_count ());
+	boost::hash_combine (result, ledger.cemented_count ());
+	return result;
+}
+
+nano::container_info nano::block_filter_service::container_info () const
+{
+	nano::container_info info;
+	info.add ("filter", filter.container_info ());
+	return info;
+}
+
+/*
+ * block_filter_config
+ */
+
+nano::error nano::block_filter_config::serialize (nano::tomlconfig & toml) const
+{
+	toml.put ("enable", enable, "Enable the in-memory bloom filter used to skip database lookups for blocks that do not exist in the ledger. \ntype:bool");
+	toml.put ("bits_per_block", bits_per_block, "Filter bits per block in the ledger. More bits reduce false positives at the cost of memory, 10 bits give a false positive rate of about 1%. \ntype:uint64");
+	toml.put ("headroom", headroom, "Number of blocks the filter is sized for on top of the current ledger size. The filter grows in the background once the ledger exceeds its capacity. \ntype:uint64");
+
+	return toml.get_error ();
+}
+
+nano::error nano::block_filter_config::deserialize (nano::tomlconfig & toml)
+{
+	toml.get ("enable", enable);
+	toml.get ("bits_per_block", bits_per_block);
+	toml.get ("headroom", headroom);
+
+	if (bits_per_block < 1 || bits_per_block > 64)
+	{
+		toml.get_error ().set ("bits_per_block must be between 1 and 64");
+	}
+
+	return toml.get_error ();
+}
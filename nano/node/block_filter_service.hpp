@@ -0,0 +1,71 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/node/fwd.hpp>
+#include <nano/store/block_filter.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
+namespace nano
+{
+class block_filter_config final
+{
+public:
+	nano::error deserialize (nano::tomlconfig &);
+	nano::error serialize (nano::tomlconfig &) const;
+
+public:
+	/** Enable the in-memory filter answering negative block existence checks */
+	bool enable{ true };
+	/** Filter size per block in the ledger, 10 bits give a false positive rate of about 1% */
+	size_t bits_per_block{ 10 };
+	/** Additional capacity reserved for blocks added after startup */
+	size_t headroom{ 1024 * 1024 };
+};
+
+/**
+ * Sizes and populates the store's block filter, persisting it across restarts.
+ * The filter is loaded from disk if it was saved for the same ledger, otherwise it is rebuilt from the blocks table in the background.
+ * Once the ledger outgrows the capacity the filter was sized for, it is refilled into a larger table in the background.
+ */
+class block_filter_service final
+{
+public:
+	block_filter_service (block_filter_config const &, std::filesystem::path const & application_path, nano::ledger &, nano::stats &, nano::logger &);
+	~block_filter_service ();
+
+	void start ();
+	void stop ();
+
+	nano::container_info container_info () const;
+
+private:
+	void run ();
+	void populate ();
+	bool rebuild ();
+	void grow ();
+	void report ();
+	uint64_t ledger_tag () const;
+
+private: // Dependencies
+	block_filter_config const & config;
+	nano::ledger & ledger;
+	nano::stats & stats;
+	nano::logger & logger;
+
+private:
+	std::filesystem::path const path;
+	nano::store::block_filter & filter;
+	nano::store::block_filter::counters reported{};
+
+	std::atomic<bool> stopped{ false };
+	mutable nano::mutex mutex;
+	nano::condition_variable condition;
+	std::thread thread;
+
+	static std::chrono::seconds constexpr report_interval{ 15 };
+};
+}
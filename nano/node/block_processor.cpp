@@ -13,6 +13,7 @@
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/store/component.hpp>
 
+#include <algorithm>
 #include <utility>
 
 /*
@@ -95,12 +96,16 @@ void nano::block_processor::stop ()
 std::size_t nano::block_processor::size () const
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
-	return queue.size ();
+	return queue.size () + chains_size;
 }
 
 std::size_t nano::block_processor::size (nano::block_source source) const
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
+	if (source == nano::block_source::bootstrap_bulk)
+	{
+		return chains_size;
+	}
 	return queue.size ({ source });
 }
 
@@ -121,6 +126,106 @@ bool nano::block_processor::add (std::shared_ptr<nano::block> const & block, blo
 	return add_impl ({ block, source, std::move (callback) }, channel);
 }
 
+std::size_t nano::block_processor::add (std::deque<std::shared_ptr<nano::block>> const & blocks, nano::block_source const source, std::function<void (nano::block_status)> callback)
+{
+	auto const valid = sufficient_work (blocks);
+
+	std::size_t added = 0;
+	for (std::size_t i = 0; i < blocks.size (); ++i)
+	{
+		auto const & block = blocks[i];
+		if (!valid[i])
+		{
+			stats.inc (nano::stat::type::block_processor, nano::stat::detail::insufficient_work);
+			continue;
+		}
+
+		stats.inc (nano::stat::type::block_processor, nano::stat::detail::process);
+		bool const last = i + 1 == blocks.size ();
+		if (add_impl ({ block, source, last ? std::move (callback) : nullptr }))
+		{
+			++added;
+		}
+	}
+	stats.add (nano::stat::type::block_processor, nano::stat::detail::work_batched, blocks.size ());
+	return added;
+}
+
+std::optional<std::size_t> nano::block_processor::add_chain (std::deque<std::shared_ptr<nano::block>> const & blocks, std::function<void (nano::block_status)> callback)
+{
+	if (blocks.empty ())
+	{
+		return std::nullopt;
+	}
+
+	// Only contiguous chains are ingested in bulk, every block must build on the one before it
+	for (std::size_t i = 1; i < blocks.size (); ++i)
+	{
+		if (blocks[i]->previous () != blocks[i - 1]->hash ())
+		{
+			return std::nullopt;
+		}
+	}
+
+	// Capacity is checked before validating work, so a chain handed back to the caller has not been validated yet
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		if (chains_size + blocks.size () > config.max_bulk_queue)
+		{
+			stats.inc (nano::stat::type::block_processor, nano::stat::detail::overfill);
+			stats.inc (nano::stat::type::block_processor_overfill, to_stat_detail (nano::block_source::bootstrap_bulk));
+			return std::nullopt;
+		}
+	}
+
+	// Blocks following one with insufficient work cannot be inserted either, they are dropped like blocks failing validation in add ()
+	auto const valid = sufficient_work (blocks);
+	auto const count = static_cast<std::size_t> (std::find (valid.begin (), valid.end (), false) - valid.begin ());
+	stats.add (nano::stat::type::block_processor, nano::stat::detail::work_batched, blocks.size ());
+	if (count < blocks.size ())
+	{
+		stats.inc (nano::stat::type::block_processor, nano::stat::detail::insufficient_work);
+	}
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		chains_size += count;
+		chains.push_back ({ { blocks.begin (), blocks.begin () + count }, std::move (callback) });
+	}
+	condition.notify_all ();
+
+	stats.add (nano::stat::type::block_processor, nano::stat::detail::process, count);
+	logger.debug (nano::log::type::block_processor, "Processing chain (bulk): {} blocks starting with: {}", count, blocks.front ()->hash ().to_string ());
+
+	return count;
+}
+
+std::vector<bool> nano::block_processor::sufficient_work (std::deque<std::shared_ptr<nano::block>> const & blocks) const
+{
+	std::vector<nano::root> roots;
+	std::vector<uint64_t> works;
+	roots.reserve (blocks.size ());
+	works.reserve (blocks.size ());
+	for (auto const & block : blocks)
+	{
+		roots.push_back (block->root ());
+		works.push_back (block->block_work ());
+	}
+	std::vector<uint64_t> values (blocks.size ());
+	network_params.work.values (roots, works, values);
+
+	std::vector<bool> result (blocks.size ());
+	for (std::size_t i = 0; i < blocks.size (); ++i)
+	{
+		result[i] = values[i] >= network_params.work.threshold_entry (blocks[i]->work_version (), blocks[i]->type ());
+	}
+	return result;
+}
+
 std::optional<nano::block_status> nano::block_processor::add_blocking (std::shared_ptr<nano::block> const & block, block_source const source)
 {
 	stats.inc (nano::stat::type::block_processor, nano::stat::detail::process_blocking);
@@ -211,7 +316,7 @@ void nano::block_processor::run ()
 	while (!stopped)
 	{
 		condition.wait (lock, [this] {
-			return stopped || !queue.empty ();
+			return stopped || !queue.empty () || !chains.empty ();
 		});
 
 		if (stopped)
@@ -228,15 +333,24 @@ void nano::block_processor::run ()
 
 		lock.lock ();
 
-		if (!queue.empty ())
+		if (log_interval.elapse (15s))
 		{
-			if (log_interval.elapse (15s))
-			{
-				logger.info (nano::log::type::block_processor, "{} blocks (+ {} forced) in processing queue",
-				queue.size (),
-				queue.size ({ nano::block_source::forced }));
-			}
+			logger.info (nano::log::type::block_processor, "{} blocks (+ {} forced, {} bulk) in processing queue",
+			queue.size (),
+			queue.size ({ nano::block_source::forced }),
+			chains_size);
+		}
 
+		// Bulk chains and the fair queue take turns, so live blocks are not held back during initial sync
+		if (!chains.empty ())
+		{
+			process_chains (lock);
+			debug_assert (!lock.owns_lock ());
+			lock.lock ();
+		}
+
+		if (!queue.empty ())
+		{
 			process_batch (lock);
 			debug_assert (!lock.owns_lock ());
 			lock.lock ();
@@ -294,6 +408,8 @@ void nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 	size_t number_of_forced_processed = 0;
 
 	std::deque<std::pair<nano::block_status, nano::block_context>> processed;
+	// Unchecked dependencies are triggered once the whole batch is committed
+	std::vector<nano::hash_or_account> satisfied_dependencies;
 
 	for (auto & ctx : batch)
 	{
@@ -310,7 +426,7 @@ void nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 
 		number_of_blocks_processed++;
 
-		auto result = process_one (transaction, ctx, force);
+		auto result = process_one (transaction, ctx, satisfied_dependencies, force);
 		processed.emplace_back (result, std::move (ctx));
 	}
 
@@ -323,9 +439,80 @@ void nano::block_processor::process_batch (nano::unique_lock<nano::mutex> & lock
 	ledger_notifications.notify_processed (transaction, std::move (processed), [this] {
 		stats.inc (nano::stat::type::block_processor, nano::stat::detail::notify_processed);
 	});
+
+	transaction.commit ();
+	unchecked.trigger (satisfied_dependencies);
+}
+
+void nano::block_processor::process_chains (nano::unique_lock<nano::mutex> & lock)
+{
+	debug_assert (lock.owns_lock ());
+	debug_assert (!mutex.try_lock ());
+	debug_assert (!chains.empty ());
+
+	// Whole chains are taken, at least one even if it exceeds the batch size
+	std::deque<chain_entry> batch;
+	std::size_t count = 0;
+	while (!chains.empty () && (batch.empty () || count + chains.front ().blocks.size () <= config.bulk_batch_size))
+	{
+		auto & chain = chains.front ();
+		count += chain.blocks.size ();
+		chains_size -= chain.blocks.size ();
+		batch.push_back (std::move (chain));
+		chains.pop_front ();
+	}
+
+	lock.unlock ();
+
+	auto transaction = ledger.tx_begin_write (nano::store::writer::block_processor);
+
+	nano::timer<std::chrono::milliseconds> timer;
+	timer.start ();
+
+	std::deque<std::pair<nano::block_status, nano::block_context>> processed;
+	std::vector<nano::hash_or_account> satisfied_dependencies;
+
+	for (auto & chain : batch)
+	{
+		debug_assert (!chain.blocks.empty ());
+		stats.inc (nano::stat::type::block_processor, nano::stat::detail::chain);
+
+		std::size_t index = 0;
+		while (index < chain.blocks.size ())
+		{
+			nano::block_context ctx{ chain.blocks[index++], nano::block_source::bootstrap_bulk };
+			auto result = process_one (transaction, ctx, satisfied_dependencies);
+			processed.emplace_back (result, std::move (ctx));
+
+			// Blocks already in the ledger are skipped, any other failure leaves the rest of the chain without its predecessor
+			if (result != nano::block_status::progress && result != nano::block_status::old)
+			{
+				break;
+			}
+		}
+		if (index < chain.blocks.size ())
+		{
+			stats.add (nano::stat::type::block_processor, nano::stat::detail::chain_truncated, chain.blocks.size () - index);
+		}
+
+		// Callback of the chain is invoked with the result of its last processed block
+		processed.back ().second.callback = std::move (chain.callback);
+	}
+
+	if (timer.stop () > std::chrono::milliseconds (100))
+	{
+		logger.debug (nano::log::type::block_processor, "Processed {} chains with {} blocks in {} {}", batch.size (), processed.size (), timer.value ().count (), timer.unit ());
+	}
+
+	ledger_notifications.notify_processed (transaction, std::move (processed), [this] {
+		stats.inc (nano::stat::type::block_processor, nano::stat::detail::notify_processed);
+	});
+
+	transaction.commit ();
+	unchecked.trigger (satisfied_dependencies);
 }
 
-nano::block_status nano::block_processor::process_one (secure::write_transaction const & transaction_a, nano::block_context const & context, bool const forced_a)
+nano::block_status nano::block_processor::process_one (secure::write_transaction const & transaction_a, nano::block_context const & context, std::vector<nano::hash_or_account> & satisfied_dependencies, bool const forced_a)
 {
 	auto block = context.block;
 	auto const hash = block->hash ();
@@ -345,7 +532,7 @@ nano::block_status nano::block_processor::process_one (secure::write_transaction
 	{
 		case nano::block_status::progress:
 		{
-			unchecked.trigger (hash);
+			satisfied_dependencies.push_back (hash);
 
 			/*
 			 * For send blocks check epoch open unchecked (gap pending).
@@ -354,7 +541,7 @@ nano::block_status nano::block_processor::process_one (secure::write_transaction
 			 */
 			if (block->type () == nano::block_type::send || (block->type () == nano::block_type::state && block->is_send () && std::underlying_type_t<nano::epoch> (block->sideband ().details.epoch) < std::underlying_type_t<nano::epoch> (nano::epoch::max)))
 			{
-				unchecked.trigger (block->destination ());
+				satisfied_dependencies.push_back (block->destination ());
 			}
 			break;
 		}
@@ -440,6 +627,8 @@ nano::container_info nano::block_processor::container_info () const
 	nano::container_info info;
 	info.put ("blocks", queue.size ());
 	info.put ("forced", queue.size ({ nano::block_source::forced }));
+	info.put ("bulk", chains_size);
+	info.put ("chains", chains.size ());
 	info.add ("queue", queue.container_info ());
 	return info;
 }
@@ -459,6 +648,8 @@ nano::error nano::block_processor_config::serialize (nano::tomlconfig & toml) co
 	toml.put ("priority_live", priority_live, "Priority for live network blocks. Higher priority gets processed more frequently. \ntype:uint64");
 	toml.put ("priority_bootstrap", priority_bootstrap, "Priority for bootstrap blocks. Higher priority gets processed more frequently. \ntype:uint64");
 	toml.put ("priority_local", priority_local, "Priority for local RPC blocks. Higher priority gets processed more frequently. \ntype:uint64");
+	toml.put ("max_bulk_queue", max_bulk_queue, "Maximum number of blocks queued as account chains for bulk ingestion during bootstrap. \ntype:uint64");
+	toml.put ("bulk_batch_size", bulk_batch_size, "Maximum number of account chain blocks inserted per write transaction. \ntype:uint64");
 
 	return toml.get_error ();
 }
@@ -470,6 +661,8 @@ nano::error nano::block_processor_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("priority_live", priority_live);
 	toml.get ("priority_bootstrap", priority_bootstrap);
 	toml.get ("priority_local", priority_local);
+	toml.get ("max_bulk_queue", max_bulk_queue);
+	toml.get ("bulk_batch_size", bulk_batch_size);
 
 	return toml.get_error ();
 }
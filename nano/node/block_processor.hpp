@@ -37,6 +37,11 @@ public:
 	size_t priority_bootstrap{ 8 };
 	size_t priority_local{ 16 };
 	size_t priority_system{ 32 };
+
+	// Maximum number of blocks queued as account chains for bulk ingestion
+	size_t max_bulk_queue{ 16 * 1024 };
+	// Maximum number of chain blocks inserted per write transaction
+	size_t bulk_batch_size{ 4 * 1024 };
 };
 
 /**
@@ -55,6 +60,20 @@ public:
 	std::size_t size () const;
 	std::size_t size (nano::block_source) const;
 	bool add (std::shared_ptr<nano::block> const &, nano::block_source = nano::block_source::live, std::shared_ptr<nano::transport::channel> const & channel = nullptr, std::function<void (nano::block_status)> callback = {});
+	/**
+	 * Queues blocks received together, their work is validated in a single batch
+	 * @param callback invoked with the processing result of the last block
+	 * @return number of blocks added
+	 */
+	std::size_t add (std::deque<std::shared_ptr<nano::block>> const &, nano::block_source, std::function<void (nano::block_status)> callback = {});
+	/**
+	 * Queues a contiguous account chain for bulk ingestion, bypassing the fair queue
+	 * The chain is inserted in a single write transaction and notified with the `bootstrap_bulk` source, so schedulers can defer the blocks
+	 * Blocks starting with the first one with insufficient work are dropped
+	 * @param callback invoked with the processing result of the last inserted block
+	 * @return number of blocks added, empty if the chain is not contiguous or the bulk queue is full and the caller may queue the blocks with add () instead
+	 */
+	std::optional<std::size_t> add_chain (std::deque<std::shared_ptr<nano::block>> const &, std::function<void (nano::block_status)> callback = {});
 	std::optional<nano::block_status> add_blocking (std::shared_ptr<nano::block> const & block, nano::block_source);
 	void force (std::shared_ptr<nano::block> const &);
 
@@ -75,8 +94,11 @@ private:
 	void run ();
 	// Roll back block in the ledger that conflicts with 'block'
 	void rollback_competitor (secure::write_transaction &, nano::block const & block);
-	nano::block_status process_one (secure::write_transaction const &, nano::block_context const &, bool forced = false);
+	nano::block_status process_one (secure::write_transaction const &, nano::block_context const &, std::vector<nano::hash_or_account> & satisfied_dependencies, bool forced = false);
 	void process_batch (nano::unique_lock<nano::mutex> &);
+	void process_chains (nano::unique_lock<nano::mutex> &);
+	/** Validates the work of all blocks in a single batch, true for blocks with sufficient work */
+	std::vector<bool> sufficient_work (std::deque<std::shared_ptr<nano::block>> const &) const;
 	std::deque<nano::block_context> next_batch (size_t max_count);
 	nano::block_context next ();
 	bool add_impl (nano::block_context, std::shared_ptr<nano::transport::channel> const & channel = nullptr);
@@ -84,6 +106,14 @@ private:
 private:
 	nano::fair_queue<nano::block_context, nano::block_source> queue;
 
+	struct chain_entry
+	{
+		std::deque<std::shared_ptr<nano::block>> blocks;
+		nano::block_context::callback_t callback;
+	};
+	std::deque<chain_entry> chains;
+	std::size_t chains_size{ 0 }; // Number of blocks in all queued chains
+
 	bool stopped{ false };
 	nano::condition_variable condition;
 	mutable nano::mutex mutex{ mutex_identifier (mutexes::block_processor) };
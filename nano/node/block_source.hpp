@@ -13,6 +13,7 @@ enum class block_source
 	live_originator,
 	bootstrap,
 	bootstrap_legacy,
+	bootstrap_bulk, // Contiguous account chains ingested in bulk, scheduling is deferred until the bulk ingestion settles
 	unchecked,
 	local,
 	forced,
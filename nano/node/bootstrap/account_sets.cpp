@@ -219,13 +219,13 @@ void nano::bootstrap::account_sets::dependency_update (nano::block_hash const &
 
 void nano::bootstrap::account_sets::trim_overflow ()
 {
-	while (!priorities.empty () && priorities.size () > config.priorities_max)
+	while (!priorities.empty () && priorities.size () > priorities_max ())
 	{
 		// Erase the lowest priority entry
 		stats.inc (nano::stat::type::bootstrap_account_sets, nano::stat::detail::priority_overflow);
 		priorities.get<tag_priority> ().erase (std::prev (priorities.get<tag_priority> ().end ()));
 	}
-	while (!blocking.empty () && blocking.size () > config.blocking_max)
+	while (!blocking.empty () && blocking.size () > blocking_max ())
 	{
 		// Erase the lowest priority entry
 		stats.inc (nano::stat::type::bootstrap_account_sets, nano::stat::detail::blocking_overflow);
@@ -296,7 +296,7 @@ void nano::bootstrap::account_sets::sync_dependencies ()
 	{
 		debug_assert (!entry.dependency_account.is_zero ());
 
-		if (priorities.size () >= config.priorities_max)
+		if (priorities.size () >= priorities_max ())
 		{
 			break;
 		}
@@ -311,6 +311,23 @@ void nano::bootstrap::account_sets::sync_dependencies ()
 	trim_overflow ();
 }
 
+void nano::bootstrap::account_sets::capacity_scale (double scale_a)
+{
+	debug_assert (scale_a > 0.0 && scale_a <= 1.0);
+	scale = scale_a;
+	trim_overflow ();
+}
+
+std::size_t nano::bootstrap::account_sets::priorities_max () const
+{
+	return std::max<std::size_t> (1, static_cast<std::size_t> (config.priorities_max * scale));
+}
+
+std::size_t nano::bootstrap::account_sets::blocking_max () const
+{
+	return std::max<std::size_t> (1, static_cast<std::size_t> (config.blocking_max * scale));
+}
+
 bool nano::bootstrap::account_sets::blocked (nano::account const & account) const
 {
 	return blocking.get<tag_account> ().contains (account);
@@ -333,12 +350,12 @@ std::size_t nano::bootstrap::account_sets::blocked_size () const
 
 bool nano::bootstrap::account_sets::priority_half_full () const
 {
-	return priorities.size () > config.priorities_max / 2;
+	return priorities.size () > priorities_max () / 2;
 }
 
 bool nano::bootstrap::account_sets::blocked_half_full () const
 {
-	return blocking.size () > config.blocking_max / 2;
+	return blocking.size () > blocking_max () / 2;
 }
 
 double nano::bootstrap::account_sets::priority (nano::account const & account) const
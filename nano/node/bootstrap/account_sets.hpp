@@ -78,6 +78,11 @@ public:
 	bool priority_half_full () const;
 	bool blocked_half_full () const;
 
+	/**
+	 * Limits both sets to a fraction of their configured maximum size, evicting the lowest priority entries if needed
+	 */
+	void capacity_scale (double);
+
 	nano::container_info container_info () const;
 
 private: // Dependencies
@@ -86,6 +91,8 @@ private: // Dependencies
 
 private:
 	void trim_overflow ();
+	std::size_t priorities_max () const;
+	std::size_t blocking_max () const;
 
 private:
 	struct priority_entry
@@ -143,6 +150,7 @@ private:
 
 	ordered_priorities priorities;
 	ordered_blocking blocking;
+	double scale{ 1.0 };
 
 public:
 	using info_t = std::tuple<decltype (blocking), decltype (priorities)>; // <blocking, priorities>
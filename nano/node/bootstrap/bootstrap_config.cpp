@@ -37,6 +37,8 @@ nano::error nano::bootstrap_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("enable_frontier_scan", enable_frontier_scan);
 
 	toml.get ("channel_limit", channel_limit);
+	toml.get ("channel_limit_min", channel_limit_min);
+	toml.get ("channel_limit_max", channel_limit_max);
 	toml.get ("rate_limit", rate_limit);
 	toml.get ("database_rate_limit", database_rate_limit);
 	toml.get ("database_warmup_ratio", database_warmup_ratio);
@@ -47,6 +49,7 @@ nano::error nano::bootstrap_config::deserialize (nano::tomlconfig & toml)
 	toml.get ("block_processor_threshold", block_processor_threshold);
 	toml.get ("max_requests", max_requests);
 	toml.get ("optimistic_request_percentage", optimistic_request_percentage);
+	toml.get ("bulk_ingestion_threshold", bulk_ingestion_threshold);
 
 	if (toml.has_key ("account_sets"))
 	{
@@ -64,7 +67,9 @@ nano::error nano::bootstrap_config::serialize (nano::tomlconfig & toml) const
 	toml.put ("enable_dependency_walker", enable_dependency_walker, "Enable or disable the 'dependency walker` strategy for the ascending bootstrap.\ntype:bool");
 	toml.put ("enable_frontier_scan", enable_frontier_scan, "Enable or disable the 'frontier scan` strategy for the ascending bootstrap.\ntype:bool");
 
-	toml.put ("channel_limit", channel_limit, "Maximum number of un-responded requests per channel.\nNote: changing to unlimited (0) is not recommended.\ntype:uint64");
+	toml.put ("channel_limit", channel_limit, "Initial number of un-responded requests per channel.\nNote: changing to unlimited (0) is not recommended.\ntype:uint64");
+	toml.put ("channel_limit_min", channel_limit_min, "Minimum number of un-responded requests per channel. The limit of each channel starts at channel_limit and adapts between this value and channel_limit_max based on response latency.\ntype:uint64");
+	toml.put ("channel_limit_max", channel_limit_max, "Maximum number of un-responded requests per channel. The limit of a channel grows up to this value while responses show no queueing at the peer.\ntype:uint64");
 	toml.put ("rate_limit", rate_limit, "Rate limit on requests.\nNote: changing to unlimited (0) is not recommended as this operation competes for resources with realtime traffic.\ntype:uint64");
 	toml.put ("database_rate_limit", database_rate_limit, "Rate limit on scanning accounts and pending entries from database.\nNote: changing to unlimited (0) is not recommended as this operation competes for resources on querying the database.\ntype:uint64");
 	toml.put ("database_warmup_ratio", database_warmup_ratio, "Ratio of the database rate limit to use for the initial warmup.\ntype:uint64");
@@ -75,6 +80,7 @@ nano::error nano::bootstrap_config::serialize (nano::tomlconfig & toml) const
 	toml.put ("block_processor_threshold", block_processor_threshold, "Bootstrap will wait while block processor has more than this many blocks queued.\ntype:uint64");
 	toml.put ("max_requests", max_requests, "Maximum total number of in flight requests.\ntype:uint64");
 	toml.put ("optimistic_request_percentage", optimistic_request_percentage, "Percentage of requests that will be optimistic. Optimistic requests start from the (possibly unconfirmed) account frontier and are vulnerable to bootstrap poisoning. Safe requests start from the confirmed frontier and given enough time will eventually resolve forks.\ntype:uint64");
+	toml.put ("bulk_ingestion_threshold", bulk_ingestion_threshold, "Responses with at least this many blocks are inserted into the ledger as a whole account chain, deferring elections and backlog scanning of those blocks until the bulk ingestion settles. Speeds up the initial sync.\nNote: set to 0 to disable.\ntype:uint64");
 
 	nano::tomlconfig account_sets_l;
 	account_sets.serialize (account_sets_l);
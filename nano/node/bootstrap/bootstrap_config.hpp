@@ -31,6 +31,10 @@ public:
 	std::size_t candidates{ 1000 };
 	std::chrono::milliseconds cooldown{ 1000 * 5 };
 	std::size_t max_pending{ 16 };
+	// Maximum number of ranges requested at once, each from a different peer with a free in-flight window
+	std::size_t max_dispatch{ 8 };
+	// How often the scan progress of each range is written to disk, so a restarted node resumes where it left off
+	std::chrono::seconds checkpoint_interval{ 60 };
 };
 
 class bootstrap_config final
@@ -48,8 +52,13 @@ public:
 
 	// Maximum number of un-responded requests per channel, should be lower or equal to bootstrap server max queue size
 	std::size_t channel_limit{ 16 };
+	// Minimum number of un-responded requests per channel, the limit starts at channel_limit and adapts between this value and channel_limit_max based on response latency
+	std::size_t channel_limit_min{ 2 };
+	// Maximum number of un-responded requests per channel reachable by the adaptive limit, lets high latency links fill their bandwidth-delay product
+	std::size_t channel_limit_max{ 64 };
 	std::size_t rate_limit{ 500 };
 	std::size_t database_rate_limit{ 250 };
+	// Frontier requests per second for each peer available for dispatch, up to frontier_scan.max_dispatch peers
 	std::size_t frontier_rate_limit{ 8 };
 	std::size_t database_warmup_ratio{ 10 };
 	std::size_t max_pull_count{ nano::bootstrap_server::max_blocks };
@@ -59,6 +68,8 @@ public:
 	std::size_t block_processor_threshold{ 1000 };
 	std::size_t max_requests{ 1024 };
 	unsigned optimistic_request_percentage{ 75 };
+	// Responses with at least this many blocks are ingested as a whole account chain, deferring their scheduling until the sync settles, 0 disables
+	std::size_t bulk_ingestion_threshold{ 32 };
 
 	account_sets_config account_sets;
 	frontier_scan_config frontier_scan;
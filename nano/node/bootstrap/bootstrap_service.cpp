@@ -20,7 +20,7 @@
 using namespace std::chrono_literals;
 
 nano::bootstrap_service::bootstrap_service (nano::node_config const & node_config_a, nano::ledger & ledger_a, nano::ledger_notifications & ledger_notifications_a,
-nano::block_processor & block_processor_a, nano::network & network_a, nano::stats & stat_a, nano::logger & logger_a) :
+nano::block_processor & block_processor_a, nano::network & network_a, nano::stats & stat_a, nano::logger & logger_a, std::filesystem::path const & frontiers_checkpoint_path_a) :
 	config{ node_config_a.bootstrap },
 	network_constants{ node_config_a.network_params.network },
 	ledger{ ledger_a },
@@ -33,10 +33,11 @@ nano::block_processor & block_processor_a, nano::network & network_a, nano::stat
 	database_scan{ ledger },
 	frontiers{ config.frontier_scan, stats },
 	throttle{ compute_throttle_size () },
-	scoring{ config, node_config_a.network_params.network },
+	scoring{ config, node_config_a.network_params.network, stats },
 	limiter{ config.rate_limit },
 	database_limiter{ config.database_rate_limit },
 	frontiers_limiter{ config.frontier_rate_limit },
+	frontiers_checkpoint_path{ frontiers_checkpoint_path_a },
 	workers{ 1, nano::thread_role::name::bootstrap_worker }
 {
 	// Inspect all processed blocks
@@ -120,6 +121,8 @@ void nano::bootstrap_service::start ()
 
 	if (config.enable_frontier_scan)
 	{
+		load_frontiers_checkpoint ();
+
 		frontiers_thread = std::thread ([this] () {
 			nano::thread_role::set (nano::thread_role::name::bootstrap_frontier_scan);
 			run_frontiers ();
@@ -143,10 +146,17 @@ void nano::bootstrap_service::stop ()
 	nano::join_or_pass (priorities_thread);
 	nano::join_or_pass (database_thread);
 	nano::join_or_pass (dependencies_thread);
+	// A service that was never started did not load the checkpoint, saving would overwrite it with an empty scan
+	bool const frontiers_started = frontiers_thread.joinable ();
 	nano::join_or_pass (frontiers_thread);
 	nano::join_or_pass (cleanup_thread);
 
 	workers.stop ();
+
+	if (frontiers_started)
+	{
+		save_frontiers_checkpoint ();
+	}
 }
 
 bool nano::bootstrap_service::send (std::shared_ptr<nano::transport::channel> const & channel, async_tag tag)
@@ -159,6 +169,7 @@ bool nano::bootstrap_service::send (std::shared_ptr<nano::transport::channel> co
 		debug_assert (tags.get<tag_id> ().count (tag.id) == 0);
 		// Give extra time for the request to be processed by the channel
 		tag.cutoff = std::chrono::steady_clock::now () + config.request_timeout * 4;
+		tag.channel = channel;
 		tags.get<tag_id> ().insert (tag);
 	}
 
@@ -304,7 +315,7 @@ void nano::bootstrap_service::inspect (secure::transaction const & tx, nano::blo
 		case nano::block_status::gap_source:
 		{
 			// Prevent malicious live traffic from filling up the blocked set
-			if (source == nano::block_source::bootstrap)
+			if (source == nano::block_source::bootstrap || source == nano::block_source::bootstrap_bulk)
 			{
 				const auto account = block.previous ().is_zero () ? block.account_field ().value () : ledger.any.block_account (tx, block.previous ()).value_or (0);
 				const auto source_hash = block.source_field ().value_or (block.link_field ().value_or (0).as_block_hash ());
@@ -358,7 +369,7 @@ void nano::bootstrap_service::wait (std::function<bool ()> const & predicate) co
 void nano::bootstrap_service::wait_block_processor () const
 {
 	wait ([this] () {
-		return block_processor.size (nano::block_source::bootstrap) < config.block_processor_threshold;
+		return block_processor.size (nano::block_source::bootstrap) + block_processor.size (nano::block_source::bootstrap_bulk) < config.block_processor_threshold;
 	});
 }
 
@@ -509,6 +520,40 @@ nano::account nano::bootstrap_service::wait_frontier ()
 	return result;
 }
 
+auto nano::bootstrap_service::next_frontiers (std::shared_ptr<nano::transport::channel> const & exclude) -> std::deque<std::pair<std::shared_ptr<nano::transport::channel>, nano::account>>
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+
+	std::deque<std::pair<std::shared_ptr<nano::transport::channel>, nano::account>> result;
+	for (auto const & channel : scoring.available_channels (config.frontier_scan.max_dispatch))
+	{
+		// The excluded channel already got the first range of this round
+		if (result.size () + 1 >= config.frontier_scan.max_dispatch || tags.size () + result.size () >= config.max_requests)
+		{
+			break;
+		}
+		if (channel == exclude)
+		{
+			continue;
+		}
+		if (!frontiers_limiter.should_pass (1) || !limiter.should_pass (1))
+		{
+			break;
+		}
+		auto start = frontiers.next ();
+		if (start.is_zero ())
+		{
+			break;
+		}
+		[[maybe_unused]] auto limited = scoring.try_send_message (channel);
+		debug_assert (!limited);
+		result.emplace_back (channel, start);
+	}
+
+	stats.add (nano::stat::type::bootstrap_frontier_scan, nano::stat::detail::dispatch, result.size ());
+	return result;
+}
+
 bool nano::bootstrap_service::request (nano::account account, size_t count, std::shared_ptr<nano::transport::channel> const & channel, query_source source)
 {
 	debug_assert (count > 0);
@@ -721,7 +766,7 @@ void nano::bootstrap_service::run_one_frontier ()
 		return frontiers_limiter.should_pass (1);
 	});
 	wait ([this] () {
-		return workers.queued_tasks () < config.frontier_scan.max_pending;
+		return frontiers_pending.size () < config.frontier_scan.max_pending;
 	});
 	auto channel = wait_channel ();
 	if (!channel)
@@ -734,6 +779,12 @@ void nano::bootstrap_service::run_one_frontier ()
 		return;
 	}
 	request_frontiers (frontier, channel, query_source::frontiers);
+
+	// Spread more ranges over other peers, so the scan is not held back by the latency of a single peer
+	for (auto const & [other, start] : next_frontiers (channel))
+	{
+		request_frontiers (start, other, query_source::frontiers);
+	}
 }
 
 void nano::bootstrap_service::run_frontiers ()
@@ -748,6 +799,58 @@ void nano::bootstrap_service::run_frontiers ()
 	}
 }
 
+void nano::bootstrap_service::run_frontiers_processing ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	debug_assert (frontiers_processing);
+	while (!stopped && !frontiers_pending.empty ())
+	{
+		stats.inc (nano::stat::type::bootstrap, nano::stat::detail::loop_frontiers_processing);
+
+		std::deque<frontiers_t> batch;
+		batch.swap (frontiers_pending);
+
+		lock.unlock ();
+		condition.notify_all ();
+		process_frontiers (batch);
+		lock.lock ();
+	}
+	frontiers_processing = false;
+}
+
+void nano::bootstrap_service::load_frontiers_checkpoint ()
+{
+	if (frontiers_checkpoint_path.empty () || !std::filesystem::exists (frontiers_checkpoint_path))
+	{
+		return;
+	}
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	if (frontiers.load (frontiers_checkpoint_path))
+	{
+		stats.inc (nano::stat::type::bootstrap_frontier_scan, nano::stat::detail::checkpoint_failed);
+		logger.warn (nano::log::type::bootstrap, "Unable to read frontier scan checkpoints from: {}", frontiers_checkpoint_path.string ());
+		return;
+	}
+	stats.inc (nano::stat::type::bootstrap_frontier_scan, nano::stat::detail::checkpoint_load);
+	logger.info (nano::log::type::bootstrap, "Resumed frontier scan from: {}", frontiers_checkpoint_path.string ());
+}
+
+void nano::bootstrap_service::save_frontiers_checkpoint ()
+{
+	if (frontiers_checkpoint_path.empty ())
+	{
+		return;
+	}
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	if (frontiers.save (frontiers_checkpoint_path))
+	{
+		stats.inc (nano::stat::type::bootstrap_frontier_scan, nano::stat::detail::checkpoint_failed);
+		logger.warn (nano::log::type::bootstrap, "Unable to write frontier scan checkpoints to: {}", frontiers_checkpoint_path.string ());
+		return;
+	}
+	stats.inc (nano::stat::type::bootstrap_frontier_scan, nano::stat::detail::checkpoint_save);
+}
+
 void nano::bootstrap_service::cleanup_and_sync ()
 {
 	debug_assert (!mutex.try_lock ());
@@ -755,6 +858,14 @@ void nano::bootstrap_service::cleanup_and_sync ()
 	scoring.sync (network.list (/* all */ 0, network_constants.bootstrap_protocol_version_min));
 	scoring.timeout ();
 
+	// The frontier rate limit applies per peer, ranges are dispatched to several peers at once
+	auto const dispatch_peers = std::clamp<std::size_t> (scoring.available (), 1, std::max<std::size_t> (config.frontier_scan.max_dispatch, 1));
+	if (dispatch_peers != frontiers_dispatch_peers)
+	{
+		frontiers_dispatch_peers = dispatch_peers;
+		frontiers_limiter.reset (config.frontier_rate_limit * dispatch_peers);
+	}
+
 	throttle.resize (compute_throttle_size ());
 
 	auto const now = std::chrono::steady_clock::now ();
@@ -768,6 +879,10 @@ void nano::bootstrap_service::cleanup_and_sync ()
 		auto tag = tags_by_order.front ();
 		stats.inc (nano::stat::type::bootstrap, nano::stat::detail::timeout);
 		stats.inc (nano::stat::type::bootstrap_timeout, to_stat_detail (tag.type));
+		if (auto channel = tag.channel.lock ())
+		{
+			scoring.timed_out (channel);
+		}
 		tags_by_order.pop_front ();
 	}
 
@@ -785,10 +900,45 @@ void nano::bootstrap_service::run_timeouts ()
 	{
 		stats.inc (nano::stat::type::bootstrap, nano::stat::detail::loop_cleanup);
 		cleanup_and_sync ();
+
+		if (config.enable_frontier_scan && frontiers_checkpoint_interval.elapse (config.frontier_scan.checkpoint_interval))
+		{
+			lock.unlock ();
+			save_frontiers_checkpoint ();
+			lock.lock ();
+		}
 		condition.wait_for (lock, 5s, [this] () { return stopped; });
 	}
 }
 
+namespace
+{
+/** Number of useful entries carried by a response, used for per peer goodput */
+std::size_t payload_items (decltype (nano::asc_pull_ack::payload) const & payload)
+{
+	struct visitor
+	{
+		std::size_t operator() (nano::asc_pull_ack::blocks_payload const & response) const
+		{
+			return response.blocks.size ();
+		}
+		std::size_t operator() (nano::asc_pull_ack::account_info_payload const & response) const
+		{
+			return response.account.is_zero () ? 0 : 1;
+		}
+		std::size_t operator() (nano::asc_pull_ack::frontiers_payload const & response) const
+		{
+			return response.frontiers.size ();
+		}
+		std::size_t operator() (nano::empty_payload const & response) const
+		{
+			return 0;
+		}
+	};
+	return std::visit (visitor{}, payload);
+}
+}
+
 void nano::bootstrap_service::process (nano::asc_pull_ack const & message, std::shared_ptr<nano::transport::channel> const & channel)
 {
 	nano::unique_lock<nano::mutex> lock{ mutex };
@@ -836,9 +986,10 @@ void nano::bootstrap_service::process (nano::asc_pull_ack const & message, std::
 		return;
 	}
 
-	// Track bootstrap request response time
+	// Track bootstrap request response time, measured on arrival so the time spent processing the payload does not count towards peer latency
+	auto const latency = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - tag.timestamp);
 	stats.inc (nano::stat::type::bootstrap_reply, to_stat_detail (tag.type));
-	stats.sample (nano::stat::sample::bootstrap_tag_duration, nano::log::milliseconds_delta (tag.timestamp), { 0, config.request_timeout.count () });
+	stats.sample (nano::stat::sample::bootstrap_tag_duration, latency.count (), { 0, config.request_timeout.count () });
 
 	lock.unlock ();
 
@@ -847,7 +998,7 @@ void nano::bootstrap_service::process (nano::asc_pull_ack const & message, std::
 	if (ok)
 	{
 		lock.lock ();
-		scoring.received_message (channel);
+		scoring.received_message (channel, latency, payload_items (message.payload));
 		lock.unlock ();
 	}
 	else
@@ -881,24 +1032,22 @@ bool nano::bootstrap_service::process (const nano::asc_pull_ack::blocks_payload
 				blocks.pop_front ();
 			}
 
-			for (auto const & block : blocks)
-			{
-				if (block == blocks.back ())
+			// Work of the whole response is validated in one batch
+			// Once the last block submitted for this account chain is processed, reset timestamp to allow more requests
+			auto processed = [this, account = tag.account] (auto result) {
+				stats.inc (nano::stat::type::bootstrap, nano::stat::detail::timestamp_reset);
 				{
-					// It's the last block submitted for this account chain, reset timestamp to allow more requests
-					block_processor.add (block, nano::block_source::bootstrap, nullptr, [this, account = tag.account] (auto result) {
-						stats.inc (nano::stat::type::bootstrap, nano::stat::detail::timestamp_reset);
-						{
-							nano::lock_guard<nano::mutex> guard{ mutex };
-							accounts.timestamp_reset (account);
-						}
-						condition.notify_all ();
-					});
-				}
-				else
-				{
-					block_processor.add (block, nano::block_source::bootstrap);
+					nano::lock_guard<nano::mutex> guard{ mutex };
+					accounts.timestamp_reset (account);
 				}
+				condition.notify_all ();
+			};
+
+			// Long chains are typical for the initial sync, inserting them as a whole skips the per block scheduling overhead
+			bool const bulk = config.bulk_ingestion_threshold > 0 && blocks.size () >= config.bulk_ingestion_threshold;
+			if (!bulk || !block_processor.add_chain (blocks, processed))
+			{
+				block_processor.add (blocks, nano::block_source::bootstrap, processed);
 			}
 
 			if (tag.source == query_source::database)
@@ -979,22 +1128,30 @@ bool nano::bootstrap_service::process (const nano::asc_pull_ack::frontiers_paylo
 			stats.inc (nano::stat::type::bootstrap_verify_frontiers, nano::stat::detail::ok);
 			stats.add (nano::stat::type::bootstrap, nano::stat::detail::frontiers, nano::stat::dir::in, response.frontiers.size ());
 
+			bool schedule = false;
 			{
 				nano::lock_guard<nano::mutex> lock{ mutex };
 				frontiers.process (tag.start.as_account (), response.frontiers);
+
+				// Allow some overfill to avoid unnecessarily dropping responses
+				if (frontiers_pending.size () < config.frontier_scan.max_pending * 4)
+				{
+					frontiers_pending.push_back (response.frontiers);
+					schedule = !std::exchange (frontiers_processing, true);
+				}
+				else
+				{
+					stats.add (nano::stat::type::bootstrap, nano::stat::detail::frontiers_dropped, response.frontiers.size ());
+				}
 			}
 
-			// Allow some overfill to avoid unnecessarily dropping responses
-			if (workers.queued_tasks () < config.frontier_scan.max_pending * 4)
+			// Responses arriving while a batch is processed are picked up by the same task
+			if (schedule)
 			{
-				workers.post ([this, frontiers = response.frontiers] {
-					process_frontiers (frontiers);
+				workers.post ([this] () {
+					run_frontiers_processing ();
 				});
 			}
-			else
-			{
-				stats.add (nano::stat::type::bootstrap, nano::stat::detail::frontiers_dropped, response.frontiers.size ());
-			}
 		}
 		break;
 		case verify_result::nothing_new:
@@ -1019,18 +1176,39 @@ bool nano::bootstrap_service::process (const nano::empty_payload & response, con
 	return false; // Invalid
 }
 
-void nano::bootstrap_service::process_frontiers (std::deque<std::pair<nano::account, nano::block_hash>> const & frontiers)
+void nano::bootstrap_service::process_frontiers (std::deque<frontiers_t> const & responses)
 {
-	release_assert (!frontiers.empty ());
+	release_assert (!responses.empty ());
 
 	// Accounts must be passed in ascending order
-	debug_assert (std::adjacent_find (frontiers.begin (), frontiers.end (), [] (auto const & lhs, auto const & rhs) {
-		return lhs.first.number () >= rhs.first.number ();
-	})
-	== frontiers.end ());
+	debug_assert (std::all_of (responses.begin (), responses.end (), [] (auto const & response) {
+		return std::adjacent_find (response.begin (), response.end (), [] (auto const & lhs, auto const & rhs) {
+			return lhs.first.number () >= rhs.first.number ();
+		})
+		== response.end ();
+	}));
 
 	stats.inc (nano::stat::type::bootstrap, nano::stat::detail::processing_frontiers);
 
+	// Merge the responses, overlapping ranges from different peers are deduplicated
+	std::vector<std::pair<nano::account, nano::block_hash>> frontiers;
+	for (auto const & response : responses)
+	{
+		frontiers.insert (frontiers.end (), response.begin (), response.end ());
+	}
+	std::sort (frontiers.begin (), frontiers.end ());
+	frontiers.erase (std::unique (frontiers.begin (), frontiers.end ()), frontiers.end ());
+
+	std::vector<nano::account> lookup;
+	lookup.reserve (frontiers.size ());
+	for (auto const & [account, frontier] : frontiers)
+	{
+		if (lookup.empty () || lookup.back () != account)
+		{
+			lookup.push_back (account);
+		}
+	}
+
 	size_t outdated = 0;
 	size_t pending = 0;
 
@@ -1039,23 +1217,21 @@ void nano::bootstrap_service::process_frontiers (std::deque<std::pair<nano::acco
 	{
 		auto transaction = ledger.tx_begin_read ();
 
-		auto const start = frontiers.front ().first;
-		nano::bootstrap::account_database_crawler account_crawler{ ledger.store, transaction, start };
-		nano::bootstrap::pending_database_crawler pending_crawler{ ledger.store, transaction, start };
+		auto const infos = ledger.store.account.get_sorted (transaction, lookup);
+		release_assert (infos.size () == lookup.size ());
+
+		nano::bootstrap::pending_database_crawler pending_crawler{ ledger.store, transaction, lookup.front () };
 
 		auto block_exists = [&] (nano::block_hash const & hash) {
 			return ledger.any.block_exists_or_pruned (transaction, hash);
 		};
 
-		auto should_prioritize = [&] (nano::account const & account, nano::block_hash const & frontier) {
-			account_crawler.advance_to (account);
-			pending_crawler.advance_to (account);
-
+		auto should_prioritize = [&] (std::optional<nano::account_info> const & info, nano::account const & account, nano::block_hash const & frontier) {
 			// Check if account exists in our ledger
-			if (account_crawler.current && account_crawler.current->first == account)
+			if (info)
 			{
 				// Check for frontier mismatch
-				if (account_crawler.current->second.head != frontier)
+				if (info->head != frontier)
 				{
 					// Check if frontier block exists in our ledger
 					if (!block_exists (frontier))
@@ -1068,6 +1244,7 @@ void nano::bootstrap_service::process_frontiers (std::deque<std::pair<nano::acco
 			}
 
 			// Check if account has pending blocks in our ledger
+			pending_crawler.advance_to (account);
 			if (pending_crawler.current && pending_crawler.current->first.account == account)
 			{
 				pending++;
@@ -1077,9 +1254,14 @@ void nano::bootstrap_service::process_frontiers (std::deque<std::pair<nano::acco
 			return false; // Account doesn't exist in the ledger and has no pending blocks, can't be prioritized right now
 		};
 
+		std::size_t index = 0;
 		for (auto const & [account, frontier] : frontiers)
 		{
-			if (should_prioritize (account, frontier))
+			while (lookup[index] != account)
+			{
+				++index;
+			}
+			if ((result.empty () || result.back () != account) && should_prioritize (infos[index], account, frontier))
 			{
 				result.push_back (account);
 			}
@@ -1204,6 +1386,12 @@ std::size_t nano::bootstrap_service::compute_throttle_size () const
 	return std::max (target, min_size);
 }
 
+void nano::bootstrap_service::capacity_scale (double scale)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	accounts.capacity_scale (scale);
+}
+
 nano::container_info nano::bootstrap_service::container_info () const
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
@@ -21,6 +21,7 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <filesystem>
 #include <thread>
 
 namespace mi = boost::multi_index;
@@ -30,7 +31,8 @@ namespace nano
 class bootstrap_service
 {
 public:
-	bootstrap_service (nano::node_config const &, nano::ledger &, nano::ledger_notifications &, nano::block_processor &, nano::network &, nano::stats &, nano::logger &);
+	/** Frontier scan progress is checkpointed to \p frontiers_checkpoint_path , an empty path disables checkpoints */
+	bootstrap_service (nano::node_config const &, nano::ledger &, nano::ledger_notifications &, nano::block_processor &, nano::network &, nano::stats &, nano::logger &, std::filesystem::path const & frontiers_checkpoint_path = {});
 	~bootstrap_service ();
 
 	void start ();
@@ -50,6 +52,9 @@ public:
 
 	nano::container_info container_info () const;
 
+	/** Limits the account sets to a fraction of their configured size */
+	void capacity_scale (double);
+
 	nano::bootstrap::account_sets::info_t info () const;
 
 private: // Dependencies
@@ -94,6 +99,7 @@ public: // Tag
 		std::chrono::steady_clock::time_point cutoff{};
 		std::chrono::steady_clock::time_point timestamp{ std::chrono::steady_clock::now () };
 		id_t id{ nano::bootstrap::generate_id () };
+		std::weak_ptr<nano::transport::channel> channel;
 	};
 
 private:
@@ -108,6 +114,7 @@ private:
 	void run_one_dependency ();
 	void run_frontiers ();
 	void run_one_frontier ();
+	void run_frontiers_processing ();
 	void run_timeouts ();
 	void cleanup_and_sync ();
 
@@ -130,6 +137,8 @@ private:
 	nano::block_hash wait_blocking ();
 	/* Waits for next available frontier scan range */
 	nano::account wait_frontier ();
+	/* Assigns further frontier scan ranges to peers with a free window, without waiting */
+	std::deque<std::pair<std::shared_ptr<nano::transport::channel>, nano::account>> next_frontiers (std::shared_ptr<nano::transport::channel> const & exclude);
 
 	bool request (nano::account, size_t count, std::shared_ptr<nano::transport::channel> const &, query_source);
 	bool request_info (nano::block_hash, std::shared_ptr<nano::transport::channel> const &, query_source);
@@ -141,7 +150,12 @@ private:
 	bool process (nano::asc_pull_ack::frontiers_payload const & response, async_tag const & tag);
 	bool process (nano::empty_payload const & response, async_tag const & tag);
 
-	void process_frontiers (std::deque<std::pair<nano::account, nano::block_hash>> const & frontiers);
+	using frontiers_t = std::deque<std::pair<nano::account, nano::block_hash>>;
+	/* Compares frontiers from a batch of responses against the ledger with a single sorted lookup */
+	void process_frontiers (std::deque<frontiers_t> const & responses);
+
+	void load_frontiers_checkpoint ();
+	void save_frontiers_checkpoint ();
 
 	enum class verify_result
 	{
@@ -198,8 +212,16 @@ private:
 	nano::rate_limiter database_limiter;
 	// Rate limiter for frontier requests
 	nano::rate_limiter frontiers_limiter;
+	// Number of peers the frontier rate limit is currently scaled to
+	std::size_t frontiers_dispatch_peers{ 1 };
 
 	nano::interval sync_dependencies_interval;
+	nano::interval frontiers_checkpoint_interval;
+	std::filesystem::path const frontiers_checkpoint_path;
+
+	// Frontier responses waiting to be compared against the ledger, processed in batches on the workers pool
+	std::deque<frontiers_t> frontiers_pending;
+	bool frontiers_processing{ false };
 
 	bool stopped{ false };
 	mutable nano::mutex mutex;
@@ -3,6 +3,8 @@
 #include <boost/multiprecision/cpp_dec_float.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 
+#include <fstream>
+
 nano::bootstrap::frontier_scan::frontier_scan (frontier_scan_config const & config_a, nano::stats & stats_a) :
 	config{ config_a },
 	stats{ stats_a }
@@ -124,6 +126,100 @@ bool nano::bootstrap::frontier_scan::process (nano::account start, std::deque<st
 	return done;
 }
 
+auto nano::bootstrap::frontier_scan::checkpoints () const -> std::vector<checkpoint>
+{
+	std::vector<checkpoint> result;
+	for (auto const & head : heads)
+	{
+		if (head.next != head.start)
+		{
+			result.emplace_back (head.start, head.next);
+		}
+	}
+	return result;
+}
+
+std::size_t nano::bootstrap::frontier_scan::restore (std::vector<checkpoint> const & checkpoints)
+{
+	std::size_t result = 0;
+	auto & heads_by_start = heads.get<tag_start> ();
+	for (auto const & [start, next] : checkpoints)
+	{
+		auto it = heads_by_start.find (start);
+		// The layout changes with head_parallelism, progress of ranges that no longer exist is dropped
+		if (it != heads_by_start.end () && next.number () > it->start.number () && next.number () < it->end.number ())
+		{
+			heads_by_start.modify (it, [&next] (frontier_head & entry) {
+				entry.next = next;
+				entry.candidates.clear ();
+				entry.requests = 0;
+				entry.completed = 0;
+			});
+			++result;
+		}
+	}
+	return result;
+}
+
+/*
+ * Checkpoint file: a header line followed by one "<start> <next>" line per range, accounts are hex encoded
+ */
+
+namespace
+{
+char const * const checkpoint_header = "frontier_scan 1";
+}
+
+bool nano::bootstrap::frontier_scan::save (std::filesystem::path const & path) const
+{
+	// Write to a temporary file first, so a crash while writing leaves the previous checkpoints intact
+	auto temp_path = path;
+	temp_path += ".tmp";
+	{
+		std::ofstream stream{ temp_path, std::ofstream::out | std::ofstream::trunc };
+		stream << checkpoint_header << '\n';
+		for (auto const & [start, next] : checkpoints ())
+		{
+			stream << start.to_string () << ' ' << next.to_string () << '\n';
+		}
+		stream.flush ();
+		if (stream.fail ())
+		{
+			return true;
+		}
+	}
+	std::error_code ec;
+	std::filesystem::rename (temp_path, path, ec);
+	return static_cast<bool> (ec);
+}
+
+bool nano::bootstrap::frontier_scan::load (std::filesystem::path const & path)
+{
+	std::ifstream stream{ path };
+	std::string line;
+	if (!stream.good () || !std::getline (stream, line) || line != checkpoint_header)
+	{
+		return true;
+	}
+	std::vector<checkpoint> result;
+	std::string start_text, next_text;
+	while (stream >> start_text >> next_text)
+	{
+		nano::account start, next;
+		if (start.decode_hex (start_text) || next.decode_hex (next_text))
+		{
+			return true;
+		}
+		result.emplace_back (start, next);
+	}
+	if (!stream.eof ())
+	{
+		return true;
+	}
+	restore (result);
+	return false;
+}
+
 nano::container_info nano::bootstrap::frontier_scan::container_info () const
 {
 	auto collect_progress = [&] () {
@@ -12,8 +12,10 @@
 #include <boost/multi_index_container.hpp>
 
 #include <chrono>
+#include <filesystem>
 #include <map>
 #include <set>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -21,7 +23,7 @@ namespace nano::bootstrap
 {
 /*
  * Frontier scan divides the account space into ranges and scans each range for outdated frontiers in parallel.
- * This class is used to track the progress of each range.
+ * This class is used to track the progress of each range, which is checkpointed to disk so a restarted node resumes the scan.
  */
 class frontier_scan
 {
@@ -31,6 +33,19 @@ public:
 	nano::account next ();
 	bool process (nano::account start, std::deque<std::pair<nano::account, nano::block_hash>> const & response);
 
+	// Range start and the next account to scan in that range
+	using checkpoint = std::pair<nano::account, nano::account>;
+
+	/** Scan progress of every range that moved past its start */
+	std::vector<checkpoint> checkpoints () const;
+	/** Resumes ranges from \p checkpoints, entries not matching a range of the current layout are ignored. Returns the number of resumed ranges */
+	std::size_t restore (std::vector<checkpoint> const & checkpoints);
+
+	/** Replaces the checkpoint file at \p path with the current progress. Returns true on error */
+	bool save (std::filesystem::path const & path) const;
+	/** Resumes the scan from the checkpoint file at \p path . Returns true on error */
+	bool load (std::filesystem::path const & path);
+
 	nano::container_info container_info () const;
 
 private: // Dependencies
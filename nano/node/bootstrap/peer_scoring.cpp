@@ -1,14 +1,18 @@
+#include <nano/lib/stats.hpp>
 #include <nano/node/bootstrap/bootstrap_config.hpp>
 #include <nano/node/bootstrap/peer_scoring.hpp>
 #include <nano/node/transport/channel.hpp>
 
+#include <numeric>
+
 /*
  * peer_scoring
  */
 
-nano::bootstrap::peer_scoring::peer_scoring (bootstrap_config const & config_a, nano::network_constants const & network_constants_a) :
+nano::bootstrap::peer_scoring::peer_scoring (bootstrap_config const & config_a, nano::network_constants const & network_constants_a, nano::stats & stats_a) :
 	config{ config_a },
-	network_constants{ network_constants_a }
+	network_constants{ network_constants_a },
+	stats{ stats_a }
 {
 }
 
@@ -17,7 +21,7 @@ bool nano::bootstrap::peer_scoring::limit_exceeded (std::shared_ptr<nano::transp
 	auto & index = scoring.get<tag_channel> ();
 	if (auto existing = index.find (channel.get ()); existing != index.end ())
 	{
-		return existing->outstanding >= config.channel_limit;
+		return existing->outstanding >= existing->limit ();
 	}
 	return false;
 }
@@ -28,11 +32,12 @@ bool nano::bootstrap::peer_scoring::try_send_message (std::shared_ptr<nano::tran
 	auto existing = index.find (channel.get ());
 	if (existing == index.end ())
 	{
-		index.emplace (channel, 1, 1, 0);
+		// New peers start with the configured window, it grows until responses show requests queueing at the peer
+		index.emplace (channel, 1, 1, 0, static_cast<double> (config.channel_limit));
 	}
 	else
 	{
-		if (existing->outstanding < config.channel_limit)
+		if (existing->outstanding < existing->limit ())
 		{
 			[[maybe_unused]] auto success = index.modify (existing, [] (auto & score) {
 				++score.outstanding;
@@ -48,22 +53,56 @@ bool nano::bootstrap::peer_scoring::try_send_message (std::shared_ptr<nano::tran
 	return false;
 }
 
-void nano::bootstrap::peer_scoring::received_message (std::shared_ptr<nano::transport::channel> const & channel)
+void nano::bootstrap::peer_scoring::received_message (std::shared_ptr<nano::transport::channel> const & channel, std::chrono::milliseconds latency, std::size_t items)
 {
 	auto & index = scoring.get<tag_channel> ();
 	if (auto existing = index.find (channel.get ()); existing != index.end ())
 	{
-		if (existing->outstanding > 1)
-		{
-			[[maybe_unused]] auto success = index.modify (existing, [] (auto & score) {
+		auto const window_before = existing->limit ();
+		[[maybe_unused]] auto success = index.modify (existing, [this, latency, items] (auto & score) {
+			if (score.outstanding > 1)
+			{
 				--score.outstanding;
 				++score.response_count_total;
-			});
-			debug_assert (success);
+			}
+			score.update (latency, items, static_cast<double> (std::min (config.channel_limit_min, config.channel_limit)), static_cast<double> (std::max (config.channel_limit_max, config.channel_limit)));
+		});
+		debug_assert (success);
+
+		if (existing->limit () > window_before)
+		{
+			stats.inc (nano::stat::type::bootstrap_peer, nano::stat::detail::window_increase);
+		}
+		if (existing->limit () < window_before)
+		{
+			stats.inc (nano::stat::type::bootstrap_peer, nano::stat::detail::window_decrease);
 		}
 	}
 }
 
+void nano::bootstrap::peer_scoring::timed_out (std::shared_ptr<nano::transport::channel> const & channel)
+{
+	auto & index = scoring.get<tag_channel> ();
+	if (auto existing = index.find (channel.get ()); existing != index.end ())
+	{
+		[[maybe_unused]] auto success = index.modify (existing, [this] (auto & score) {
+			score.window = std::max (score.window / 2, static_cast<double> (std::min (config.channel_limit_min, config.channel_limit)));
+		});
+		debug_assert (success);
+		stats.inc (nano::stat::type::bootstrap_peer, nano::stat::detail::window_timeout);
+	}
+}
+
+std::size_t nano::bootstrap::peer_scoring::window (std::shared_ptr<nano::transport::channel> const & channel) const
+{
+	auto & index = scoring.get<tag_channel> ();
+	if (auto existing = index.find (channel.get ()); existing != index.end ())
+	{
+		return existing->limit ();
+	}
+	return 0;
+}
+
 std::shared_ptr<nano::transport::channel> nano::bootstrap::peer_scoring::channel ()
 {
 	for (auto const & channel : channels)
@@ -79,6 +118,23 @@ std::shared_ptr<nano::transport::channel> nano::bootstrap::peer_scoring::channel
 	return nullptr;
 }
 
+std::deque<std::shared_ptr<nano::transport::channel>> nano::bootstrap::peer_scoring::available_channels (std::size_t count) const
+{
+	std::deque<std::shared_ptr<nano::transport::channel>> result;
+	for (auto const & channel : channels)
+	{
+		if (result.size () >= count)
+		{
+			break;
+		}
+		if (!channel->max (traffic_type) && !limit_exceeded (channel))
+		{
+			result.push_back (channel);
+		}
+	}
+	return result;
+}
+
 std::size_t nano::bootstrap::peer_scoring::size () const
 {
 	return scoring.size ();
@@ -104,9 +160,19 @@ void nano::bootstrap::peer_scoring::timeout ()
 		return true;
 	});
 
+	auto const now = std::chrono::steady_clock::now ();
 	for (auto score = scoring.begin (), n = scoring.end (); score != n; ++score)
 	{
-		scoring.modify (score, [] (auto & score_a) {
+		scoring.modify (score, [this, now] (auto & score_a) {
+			// Goodput counts useful entries only, empty or invalid responses do not contribute
+			auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (now - score_a.items_start).count ();
+			if (elapsed > 0)
+			{
+				stats.sample (nano::stat::sample::bootstrap_peer_goodput, static_cast<int64_t> (score_a.items * 1000 / elapsed), { 0, 100000 });
+			}
+			stats.sample (nano::stat::sample::bootstrap_peer_window, static_cast<int64_t> (score_a.limit ()), { 0, static_cast<int64_t> (config.channel_limit) });
+			score_a.items = 0;
+			score_a.items_start = now;
 			score_a.decay ();
 		});
 	}
@@ -123,6 +189,9 @@ nano::container_info nano::bootstrap::peer_scoring::container_info () const
 	info.put ("scores", size ());
 	info.put ("available", available ());
 	info.put ("channels", channels.size ());
+	info.put ("window", std::accumulate (scoring.begin (), scoring.end (), uint64_t{ 0 }, [] (uint64_t total, auto const & score) {
+		return total + score.limit ();
+	}));
 	return info;
 }
 
@@ -130,11 +199,34 @@ nano::container_info nano::bootstrap::peer_scoring::container_info () const
  * peer_score
  */
 
-nano::bootstrap::peer_scoring::peer_score::peer_score (std::shared_ptr<nano::transport::channel> const & channel_a, uint64_t outstanding_a, uint64_t request_count_total_a, uint64_t response_count_total_a) :
+nano::bootstrap::peer_scoring::peer_score::peer_score (std::shared_ptr<nano::transport::channel> const & channel_a, uint64_t outstanding_a, uint64_t request_count_total_a, uint64_t response_count_total_a, double window_a) :
 	channel{ channel_a },
 	channel_ptr{ channel_a.get () },
 	outstanding{ outstanding_a },
 	request_count_total{ request_count_total_a },
-	response_count_total{ response_count_total_a }
+	response_count_total{ response_count_total_a },
+	window{ window_a }
+{
+}
+
+void nano::bootstrap::peer_scoring::peer_score::update (std::chrono::milliseconds latency, std::size_t items_a, double window_min, double window_max)
 {
+	items += items_a;
+
+	// Latency below a millisecond is counted as one, so ratios stay defined
+	auto const sample = std::max (static_cast<double> (latency.count ()), 1.0);
+	latency_min = latency_min > 0 ? std::min (latency_min, sample) : sample;
+	latency_average = latency_average > 0 ? (latency_average * 7 + sample) / 8 : sample;
+
+	// Number of requests estimated to be waiting in the peer's queue, as in delay based congestion control
+	// The window fills the bandwidth-delay product when responses arrive close to the lowest latency, so it keeps growing until requests start to queue
+	auto const queued = window * (1.0 - latency_min / latency_average);
+	if (queued < window_queued_low)
+	{
+		window = std::min (window + 1, window_max);
+	}
+	else if (queued > window_queued_high)
+	{
+		window = std::max (window - 1, window_min);
+	}
 }
@@ -8,6 +8,7 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <chrono>
 #include <deque>
 #include <memory>
 
@@ -15,21 +16,32 @@ namespace mi = boost::multi_index;
 
 namespace nano::bootstrap
 {
-// Container for tracking and scoring peers with respect to bootstrapping
+/**
+ * Container for tracking and scoring peers with respect to bootstrapping
+ * Each peer has an in-flight window adapted to its response latency: the window grows while responses arrive close to the lowest latency observed
+ * and shrinks when latency rises, which indicates requests queueing at the peer, or when requests time out.
+ */
 class peer_scoring
 {
 public:
 	static nano::transport::traffic_type constexpr traffic_type = nano::transport::traffic_type::bootstrap_requests;
 
 public:
-	peer_scoring (bootstrap_config const &, nano::network_constants const &);
+	peer_scoring (bootstrap_config const &, nano::network_constants const &, nano::stats &);
 
 	// Returns true if channel limit has been exceeded
 	bool limit_exceeded (std::shared_ptr<nano::transport::channel> const & channel) const;
 	bool try_send_message (std::shared_ptr<nano::transport::channel> const & channel);
-	void received_message (std::shared_ptr<nano::transport::channel> const & channel);
+	/** Records a response that took \p latency to arrive and carried \p items useful entries (blocks, frontiers or account info) */
+	void received_message (std::shared_ptr<nano::transport::channel> const & channel, std::chrono::milliseconds latency = {}, std::size_t items = 0);
+	/** Shrinks the window of a peer that did not respond in time */
+	void timed_out (std::shared_ptr<nano::transport::channel> const & channel);
+	/** Current in-flight window of the channel, zero if not scored yet */
+	std::size_t window (std::shared_ptr<nano::transport::channel> const & channel) const;
 
 	std::shared_ptr<nano::transport::channel> channel ();
+	/** Up to \p count distinct channels with a free in-flight window, requests are accounted for with try_send_message */
+	std::deque<std::shared_ptr<nano::transport::channel>> available_channels (std::size_t count) const;
 
 	// Synchronize channels with the network, passed channels should be shuffled
 	void sync (std::deque<std::shared_ptr<nano::transport::channel>> const & list);
@@ -46,12 +58,13 @@ public:
 private:
 	bootstrap_config const & config;
 	nano::network_constants const & network_constants;
+	nano::stats & stats;
 
 private:
 	class peer_score
 	{
 	public:
-		explicit peer_score (std::shared_ptr<nano::transport::channel> const &, uint64_t, uint64_t, uint64_t);
+		explicit peer_score (std::shared_ptr<nano::transport::channel> const &, uint64_t, uint64_t, uint64_t, double window);
 		std::weak_ptr<nano::transport::channel> channel;
 		// std::weak_ptr does not provide ordering so the naked pointer is also tracked and used for ordering channels
 		// This pointer may be invalid if the channel has been destroyed
@@ -69,11 +82,29 @@ private:
 		void decay ()
 		{
 			outstanding = outstanding > 0 ? outstanding - 1 : 0;
+			// Let the lowest latency drift towards the average, so a changed path to the peer is picked up
+			latency_min = (latency_min + latency_average) / 2;
 		}
+		uint64_t limit () const
+		{
+			return std::max (static_cast<uint64_t> (window), uint64_t{ 1 });
+		}
+		void update (std::chrono::milliseconds latency, std::size_t items, double window_min, double window_max);
+		// Bounds on the estimated number of requests queued at the peer, the window grows below and shrinks above
+		static double constexpr window_queued_low = 1.0;
+		static double constexpr window_queued_high = 3.0;
 		// Number of outstanding requests to a peer
 		uint64_t outstanding{ 0 };
 		uint64_t request_count_total{ 0 };
 		uint64_t response_count_total{ 0 };
+		// Adaptive limit of outstanding requests
+		double window{ 0 };
+		// Response latency in milliseconds, lowest observed and moving average
+		double latency_min{ 0 };
+		double latency_average{ 0 };
+		// Useful entries received since the last goodput sample
+		uint64_t items{ 0 };
+		std::chrono::steady_clock::time_point items_start{ std::chrono::steady_clock::now () };
 	};
 
 	// clang-format off
@@ -6,8 +6,10 @@
 #include <nano/node/daemonconfig.hpp>
 #include <nano/node/endpoint.hpp>
 #include <nano/node/inactive_node.hpp>
+#include <nano/node/make_store.hpp>
 #include <nano/node/node.hpp>
 #include <nano/secure/ledger.hpp>
+#include <nano/store/snapshot.hpp>
 
 #include <boost/format.hpp>
 
@@ -60,6 +62,9 @@ void nano::add_node_options (boost::program_options::options_description & descr
 	("final_vote_clear", "Clear final votes")
 	("rebuild_database", "Rebuild LMDB database with vacuum for best compaction")
 	("migrate_database_lmdb_to_rocksdb", "Migrates LMDB database to RocksDB")
+	("migrate_database_rocksdb_block_encoding", "Rewrites the RocksDB blocks table in the compact block encoding")
+	("export_ledger", boost::program_options::value<std::string> (), "Exports the ledger to a snapshot in the supplied directory, which must not exist or be empty")
+	("import_ledger", boost::program_options::value<std::string> (), "Imports a ledger snapshot from the supplied directory into an empty database in the data directory")
 	("diagnostics", "Run internal diagnostics")
 	("generate_config", boost::program_options::value<std::string> (), "Write configuration to stdout, populated with defaults suitable for this system. Pass the configuration type node, rpc or log. See also use_defaults.")
 	("update_config", "Reads the current node configuration and updates it with missing keys and values and delete keys that are no longer used. Updated configuration is written to stdout.")
@@ -114,6 +119,7 @@ void nano::add_node_flag_options (boost::program_options::options_description &
 		("disable_block_processor_republishing", "Disables block republishing by disabling the local_block_broadcaster component")
 		("disable_search_pending", "Disables the periodic search for pending transactions")
 		("enable_pruning", "Enable experimental ledger pruning")
+		("enable_receivable_cache", "Maintain per-account receivable totals in memory to speed up receivable and balance queries")
 		("allow_bootstrap_peers_duplicates", "Allow multiple connections to same peer in bootstrap attempts")
 		("fast_bootstrap", "Increase bootstrap speed for high end nodes with higher limits")
 		("block_processor_batch_size", boost::program_options::value<std::size_t>(), "Increase block processor transaction batch write size, default 0 (limited by config block_processor_batch_max_time), 256k for fast_bootstrap")
@@ -152,6 +158,7 @@ std::error_code nano::update_flags (nano::node_flags & flags_a, boost::program_o
 	flags_a.disable_providing_telemetry_metrics = (vm.count ("disable_providing_telemetry_metrics") > 0);
 	flags_a.disable_block_processor_unchecked_deletion = (vm.count ("disable_block_processor_unchecked_deletion") > 0);
 	flags_a.enable_pruning = (vm.count ("enable_pruning") > 0);
+	flags_a.generate_cache.receivable = (vm.count ("enable_receivable_cache") > 0);
 	flags_a.allow_bootstrap_peers_duplicates = (vm.count ("allow_bootstrap_peers_duplicates") > 0);
 	flags_a.fast_bootstrap = (vm.count ("fast_bootstrap") > 0);
 	if (flags_a.fast_bootstrap)
@@ -501,6 +508,84 @@ std::error_code nano::handle_node_options (boost::program_options::variables_map
 			std::cerr << "There was an error migrating" << std::endl;
 		}
 	}
+	else if (vm.count ("migrate_database_rocksdb_block_encoding"))
+	{
+		auto data_path = vm.count ("data_path") ? std::filesystem::path (vm["data_path"].as<std::string> ()) : nano::working_path ();
+		nano::logger::initialize (nano::log_config::daemon_default (), data_path);
+
+		auto node_flags = nano::inactive_node_flag_defaults ();
+		node_flags.read_only = false;
+		node_flags.config_overrides.push_back ("node.rocksdb.enable=true");
+		nano::update_flags (node_flags, vm);
+		nano::inactive_node node (data_path, node_flags);
+		auto error (false);
+		if (!node.node->init_error ())
+		{
+			error = node.node->ledger.migrate_rocksdb_block_encoding ();
+		}
+		else
+		{
+			error = true;
+		}
+
+		if (error)
+		{
+			std::cerr << "There was an error migrating" << std::endl;
+		}
+	}
+	else if (vm.count ("export_ledger"))
+	{
+		auto data_path = vm.count ("data_path") ? std::filesystem::path (vm["data_path"].as<std::string> ()) : nano::working_path ();
+		nano::logger::initialize (nano::log_config::daemon_default (), data_path);
+
+		auto node_flags = nano::inactive_node_flag_defaults ();
+		nano::update_flags (node_flags, vm);
+		nano::inactive_node node (data_path, node_flags);
+		auto error (false);
+		if (!node.node->init_error ())
+		{
+			nano::logger logger;
+			error = nano::store::snapshot::write (node.node->store, node.node->network_params.ledger.genesis->hash (), vm["export_ledger"].as<std::string> (), logger);
+		}
+		else
+		{
+			error = true;
+		}
+
+		if (error)
+		{
+			std::cerr << "There was an error exporting the ledger" << std::endl;
+		}
+	}
+	else if (vm.count ("import_ledger"))
+	{
+		auto data_path = vm.count ("data_path") ? std::filesystem::path (vm["data_path"].as<std::string> ()) : nano::working_path ();
+		nano::logger::initialize (nano::log_config::daemon_default (), data_path);
+
+		// The store is opened directly, a node would initialize the empty ledger with the genesis block
+		nano::network_params network_params{ nano::network_constants::active_network };
+		nano::daemon_config config{ data_path, network_params };
+		std::vector<std::string> config_overrides;
+		auto config_arg (vm.find ("config"));
+		if (config_arg != vm.end ())
+		{
+			config_overrides = nano::config_overrides (config_arg->second.as<std::vector<nano::config_key_value_pair>> ());
+		}
+		if (!nano::read_node_config_toml (data_path, config, config_overrides))
+		{
+			nano::logger logger;
+			auto store = nano::make_store (logger, data_path, network_params.ledger, false, true, config.node);
+			auto error = store->init_error () || nano::store::snapshot::read (vm["import_ledger"].as<std::string> (), network_params.ledger.genesis->hash (), *store, logger);
+			if (error)
+			{
+				std::cerr << "There was an error importing the ledger" << std::endl;
+			}
+		}
+		else
+		{
+			ec = nano::error_cli::reading_config;
+		}
+	}
 	else if (vm.count ("unchecked_clear"))
 	{
 		std::filesystem::path data_path = vm.count ("data_path") ? std::filesystem::path (vm["data_path"].as<std::string> ()) : nano::working_path ();
@@ -31,6 +31,10 @@ nano::error nano::daemon_config::serialize_toml (nano::tomlconfig & toml)
 	opencl_l.put ("enable", opencl_enable);
 	toml.put_child ("opencl", opencl_l);
 
+	nano::tomlconfig thread_placement_l;
+	thread_placement.serialize_toml (thread_placement_l);
+	toml.put_child ("thread_placement", thread_placement_l);
+
 	return toml.get_error ();
 }
 
@@ -56,6 +60,12 @@ nano::error nano::daemon_config::deserialize_toml (nano::tomlconfig & toml)
 		opencl.deserialize_toml (*opencl_l);
 	}
 
+	auto thread_placement_l (toml.get_optional_child ("thread_placement"));
+	if (!toml.get_error () && thread_placement_l)
+	{
+		thread_placement.deserialize_toml (*thread_placement_l);
+	}
+
 	return toml.get_error ();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/lib/errors.hpp>
+#include <nano/lib/thread_placement.hpp>
 #include <nano/node/node_rpc_config.hpp>
 #include <nano/node/nodeconfig.hpp>
 #include <nano/node/openclconfig.hpp>
@@ -22,6 +23,7 @@ public:
 	nano::node_config node;
 	bool opencl_enable{ false };
 	nano::opencl_config opencl;
+	nano::thread_placement_config thread_placement;
 	std::filesystem::path data_path;
 };
 
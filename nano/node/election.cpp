@@ -1,5 +1,6 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/enum_util.hpp>
+#include <nano/lib/uint128.hpp>
 #include <nano/node/active_elections.hpp>
 #include <nano/node/confirmation_solicitor.hpp>
 #include <nano/node/election.hpp>
@@ -402,21 +403,24 @@ nano::tally_t nano::election::tally () const
 
 nano::tally_t nano::election::tally_impl () const
 {
-	std::unordered_map<nano::block_hash, nano::uint128_t> block_weights;
-	std::unordered_map<nano::block_hash, nano::uint128_t> final_weights_l;
+	// Weights are summed with fixed width arithmetic and only converted once per block
+	std::unordered_map<nano::block_hash, nano::uint128_fast_t> block_weights;
+	std::unordered_map<nano::block_hash, nano::uint128_fast_t> final_weights_l;
 	for (auto const & [account, info] : last_votes)
 	{
-		auto rep_weight (node.ledger.weight (account));
+		nano::uint128_fast_t const rep_weight{ node.ledger.weight (account) };
 		block_weights[info.hash] += rep_weight;
 		if (info.timestamp == std::numeric_limits<uint64_t>::max ())
 		{
 			final_weights_l[info.hash] += rep_weight;
 		}
 	}
-	last_tally = block_weights;
+	last_tally.clear ();
 	nano::tally_t result;
-	for (auto const & [hash, amount] : block_weights)
+	for (auto const & [hash, weight] : block_weights)
 	{
+		auto const amount = weight.number ();
+		last_tally.emplace (hash, amount);
 		auto block (last_blocks.find (hash));
 		if (block != last_blocks.end ())
 		{
@@ -430,7 +434,7 @@ nano::tally_t nano::election::tally_impl () const
 		auto find_final (final_weights_l.find (winner_hash));
 		if (find_final != final_weights_l.end ())
 		{
-			final_weight = find_final->second;
+			final_weight = find_final->second.number ();
 		}
 	}
 	return result;
@@ -10,6 +10,7 @@ namespace nano
 class account_sets_config;
 class active_elections;
 class backlog_scan;
+class block_filter_service;
 class block_processor;
 class bounded_backlog;
 class bucketing;
@@ -23,6 +24,7 @@ class ledger_notifications;
 class local_block_broadcaster;
 class local_vote_history;
 class logger;
+class memory_budget;
 class network;
 class network_params;
 class node;
@@ -6,11 +6,35 @@
 #include <nano/node/ipc/ipc_server.hpp>
 #include <nano/node/node.hpp>
 
+#include <boost/endian/conversion.hpp>
+
 nano::ipc::broker::broker (nano::node & node_a) :
 	node (node_a)
 {
 }
 
+nano::ipc::event::event (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a) :
+	length{ boost::endian::native_to_big (static_cast<uint32_t> (flatbuffer_a->GetSize ())) },
+	flatbuffer{ flatbuffer_a }
+{
+}
+
+nano::ipc::event::event (std::shared_ptr<std::string> const & json_a) :
+	length{ boost::endian::native_to_big (static_cast<uint32_t> (json_a->size ())) },
+	json{ json_a }
+{
+}
+
+uint8_t const * nano::ipc::event::data () const
+{
+	return flatbuffer ? flatbuffer->GetBufferPointer () : reinterpret_cast<uint8_t const *> (json->data ());
+}
+
+std::size_t nano::ipc::event::size () const
+{
+	return flatbuffer ? flatbuffer->GetSize () : json->size ();
+}
+
 std::shared_ptr<flatbuffers::Parser> nano::ipc::subscriber::get_parser (nano::ipc::ipc_config const & ipc_config_a)
 {
 	if (!parser)
@@ -112,10 +136,13 @@ void nano::ipc::broker::subscribe (std::weak_ptr<nano::ipc::subscriber> const &
 void nano::ipc::broker::broadcast (std::shared_ptr<nanoapi::EventConfirmationT> const & confirmation_a)
 {
 	using Filter = nanoapi::TopicConfirmationTypeFilter;
-	decltype (confirmation_a->election_info) election_info;
-	nanoapi::BlockUnion block;
-	auto itr (confirmation_subscribers->begin ());
-	while (itr != confirmation_subscribers->end ())
+
+	// Encoded events indexed by [include_block][include_election_info][json], shared by all subscribers with the same options
+	std::shared_ptr<nano::ipc::event const> encoded[2][2][2];
+
+	auto subscribers = confirmation_subscribers.lock ();
+	auto itr (subscribers->begin ());
+	while (itr != subscribers->end ())
 	{
 		if (auto subscriber_l = itr->subscriber.lock ())
 		{
@@ -165,61 +192,79 @@ void nano::ipc::broker::broadcast (std::shared_ptr<nanoapi::EventConfirmationT>
 
 				return should_filter_conf_type_l || should_filter_account_l;
 			};
-			// Apply any filters
+
 			auto & options (itr->topic->options);
-			if (options)
-			{
-				if (!options->include_election_info)
-				{
-					election_info = std::move (confirmation_a->election_info);
-					confirmation_a->election_info = nullptr;
-				}
-				if (!options->include_block)
-				{
-					block = confirmation_a->block;
-					confirmation_a->block.Reset ();
-				}
-			}
 			if (!options || !should_filter ())
 			{
-				auto fb (nano::ipc::flatbuffer_producer::make_buffer (*confirmation_a));
+				bool const include_block = !options || options->include_block;
+				bool const include_election_info = !options || options->include_election_info;
+				bool const json = subscriber_l->get_active_encoding () == nano::ipc::payload_encoding::flatbuffers_json;
 
-				if (subscriber_l->get_active_encoding () == nano::ipc::payload_encoding::flatbuffers_json)
+				auto & payload = encoded[include_block][include_election_info][json];
+				if (!payload)
 				{
-					auto parser (subscriber_l->get_parser (node.config.ipc_config));
-
-					// Convert response to JSON
-					auto json (std::make_shared<std::string> ());
-					if (!flatbuffers::GenerateText (*parser, fb->GetBufferPointer (), json.get ()))
-					{
-						throw nano::error ("Couldn't serialize response to JSON");
-					}
-
-					subscriber_l->async_send_message (reinterpret_cast<uint8_t const *> (json->data ()), json->size (), [json] (nano::error const & err) {});
+					payload = encode (*confirmation_a, include_block, include_election_info, subscriber_l);
+				}
+				if (subscriber_l->stream_event (payload))
+				{
+					node.stats.inc (nano::stat::type::ipc, nano::stat::detail::event_dropped);
 				}
 				else
 				{
-					subscriber_l->async_send_message (fb->GetBufferPointer (), fb->GetSize (), [fb] (nano::error const & err) {});
+					node.stats.inc (nano::stat::type::ipc, nano::stat::detail::event_stream);
 				}
 			}
 
-			// Restore full object, the next subscriber may request it
-			if (election_info)
-			{
-				confirmation_a->election_info = std::move (election_info);
-			}
-			if (block.type != nanoapi::Block::Block_NONE)
-			{
-				confirmation_a->block = block;
-			}
-
 			++itr;
 		}
 		else
 		{
-			itr = confirmation_subscribers->erase (itr);
+			itr = subscribers->erase (itr);
+		}
+	}
+}
+
+std::shared_ptr<nano::ipc::event const> nano::ipc::broker::encode (nanoapi::EventConfirmationT & confirmation_a, bool include_block_a, bool include_election_info_a, std::shared_ptr<nano::ipc::subscriber> const & subscriber_a)
+{
+	node.stats.inc (nano::stat::type::ipc, nano::stat::detail::event_encode);
+
+	// Temporarily detach the excluded parts, the full object is restored for the next encoding
+	decltype (confirmation_a.election_info) election_info;
+	nanoapi::BlockUnion block;
+	if (!include_election_info_a)
+	{
+		election_info = std::move (confirmation_a.election_info);
+	}
+	if (!include_block_a)
+	{
+		block = confirmation_a.block;
+		confirmation_a.block.Reset ();
+	}
+
+	auto fb (nano::ipc::flatbuffer_producer::make_buffer (confirmation_a));
+
+	if (election_info)
+	{
+		confirmation_a.election_info = std::move (election_info);
+	}
+	if (block.type != nanoapi::Block::Block_NONE)
+	{
+		confirmation_a.block = block;
+	}
+
+	if (subscriber_a->get_active_encoding () == nano::ipc::payload_encoding::flatbuffers_json)
+	{
+		auto parser (subscriber_a->get_parser (node.config.ipc_config));
+
+		// Convert response to JSON
+		auto json (std::make_shared<std::string> ());
+		if (!flatbuffers::GenerateText (*parser, fb->GetBufferPointer (), json.get ()))
+		{
+			throw nano::error ("Couldn't serialize response to JSON");
 		}
+		return std::make_shared<nano::ipc::event> (json);
 	}
+	return std::make_shared<nano::ipc::event> (fb);
 }
 
 std::size_t nano::ipc::broker::confirmation_subscriber_count () const
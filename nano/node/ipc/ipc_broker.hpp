@@ -17,6 +17,28 @@ class error;
 namespace ipc
 {
 	class ipc_config;
+
+	/**
+	 * Encoded event payload, shared by reference by every subscriber receiving the same encoding.
+	 * The big endian length is stored alongside the payload, so sessions can write the frame without copying.
+	 */
+	class event final
+	{
+	public:
+		explicit event (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & flatbuffer_a);
+		explicit event (std::shared_ptr<std::string> const & json_a);
+
+		uint8_t const * data () const;
+		std::size_t size () const;
+
+		/** Payload length in big endian byte order */
+		uint32_t const length;
+
+	private:
+		std::shared_ptr<flatbuffers::FlatBufferBuilder> flatbuffer;
+		std::shared_ptr<std::string> json;
+	};
+
 	/**
 	 * A subscriber represents a live session, and is weakly referenced nano::ipc::subscription whenever a subscription is made.
 	 * This construction helps making the session implementation opaque to clients.
@@ -33,6 +55,12 @@ namespace ipc
 		 * @param broadcast_completion_handler_a Called once sending is completed
 		 */
 		virtual void async_send_message (uint8_t const * data_a, std::size_t length_a, std::function<void (nano::error const &)> broadcast_completion_handler_a) = 0;
+		/**
+		 * Queue an event in the session's bounded stream buffer. Pending events are written back to back as length prefixed frames,
+		 * with a single write per batch. The buffer only drains as fast as the client reads.
+		 * @return true if the event was dropped because the stream buffer is full
+		 */
+		virtual bool stream_event (std::shared_ptr<nano::ipc::event const> const & event_a) = 0;
 		/** Returns the unique id of the associated session */
 		virtual uint64_t get_id () const = 0;
 		/** Returns the service name associated with the session */
@@ -90,8 +118,10 @@ namespace ipc
 		void service_stop (std::string const & service_name_a);
 
 	private:
-		/** Broadcast block confirmations */
+		/** Broadcast block confirmations. Each distinct combination of options and encoding is serialized at most once. */
 		void broadcast (std::shared_ptr<nanoapi::EventConfirmationT> const & confirmation_a);
+		/** Serialize \p confirmation_a, leaving out the parts excluded by the subscription options */
+		std::shared_ptr<nano::ipc::event const> encode (nanoapi::EventConfirmationT & confirmation_a, bool include_block_a, bool include_election_info_a, std::shared_ptr<nano::ipc::subscriber> const & subscriber_a);
 
 		nano::node & node;
 		mutable nano::locked<std::vector<subscription<nanoapi::TopicConfirmationT>>> confirmation_subscribers;
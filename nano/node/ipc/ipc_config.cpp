@@ -3,18 +3,26 @@
 #include <nano/lib/tomlconfig.hpp>
 #include <nano/node/ipc/ipc_config.hpp>
 
+#include <bit>
+
 nano::ipc::ipc_config_tcp_socket::ipc_config_tcp_socket (nano::network_constants & network_constants) :
 	network_constants{ network_constants },
 	port{ network_constants.default_ipc_port }
 {
 }
 
+nano::ipc::ipc_config_shared_memory::ipc_config_shared_memory (nano::network_constants & network_constants) :
+	name{ "nano_ipc_" + std::string{ network_constants.get_current_network_as_string () } }
+{
+}
+
 nano::error nano::ipc::ipc_config::serialize_toml (nano::tomlconfig & toml) const
 {
 	nano::tomlconfig tcp_l;
 	tcp_l.put ("enable", transport_tcp.enabled, "Enable or disable IPC via TCP server.\ntype:bool");
 	tcp_l.put ("port", transport_tcp.port, "Server listening port.\ntype:uint16");
 	tcp_l.put ("io_timeout", transport_tcp.io_timeout, "Timeout for requests.\ntype:seconds");
+	tcp_l.put ("stream_buffer_size", transport_tcp.stream_buffer_size, "Maximum number of subscription events buffered per session while the client reads slower than events are produced. Further events are dropped until the buffer drains.\ntype:uint64");
 	// Only write out experimental config values if they're previously set explicitly in the config file
 	if (transport_tcp.io_threads >= 0)
 	{
@@ -31,8 +39,17 @@ nano::error nano::ipc::ipc_config::serialize_toml (nano::tomlconfig & toml) cons
 	domain_l.put ("allow_unsafe", transport_domain.allow_unsafe, "If enabled, certain unsafe RPCs can be used. Not recommended for production systems.\ntype:bool");
 	domain_l.put ("path", transport_domain.path, "Path to the local domain socket.\ntype:string");
 	domain_l.put ("io_timeout", transport_domain.io_timeout, "Timeout for requests.\ntype:seconds");
+	domain_l.put ("stream_buffer_size", transport_domain.stream_buffer_size, "Maximum number of subscription events buffered per session while the client reads slower than events are produced. Further events are dropped until the buffer drains.\ntype:uint64");
 	toml.put_child ("local", domain_l);
 
+	nano::tomlconfig shared_memory_l;
+	shared_memory_l.put ("enable", transport_shared_memory.enabled, "Enable or disable IPC via shared memory ring buffers, for clients on the same host.\ntype:bool");
+	shared_memory_l.put ("allow_unsafe", transport_shared_memory.allow_unsafe, "If enabled, certain unsafe RPCs can be used. Not recommended for production systems.\ntype:bool");
+	shared_memory_l.put ("name", transport_shared_memory.name, "Name of the shared memory segment, defaults to one per network. Nodes on the same host and network need distinct names, a segment created by a running node is not replaced.\ntype:string");
+	shared_memory_l.put ("capacity", transport_shared_memory.capacity, "Size in bytes of each of the request and reply ring buffers. Must be a power of two.\ntype:uint64");
+	shared_memory_l.put ("io_timeout", transport_shared_memory.io_timeout, "Timeout for requests.\ntype:seconds");
+	toml.put_child ("shared_memory", shared_memory_l);
+
 	nano::tomlconfig flatbuffers_l;
 	flatbuffers_l.put ("skip_unexpected_fields_in_json", flatbuffers.skip_unexpected_fields_in_json, "Allow client to send unknown fields in json messages. These will be ignored.\ntype:bool");
 	flatbuffers_l.put ("verify_buffers", flatbuffers.verify_buffers, "Verify that the buffer is valid before parsing. This is recommended when receiving data from untrusted sources.\ntype:bool");
@@ -51,6 +68,7 @@ nano::error nano::ipc::ipc_config::deserialize_toml (nano::tomlconfig & toml)
 		tcp_l->get<bool> ("enable", transport_tcp.enabled);
 		tcp_l->get<uint16_t> ("port", transport_tcp.port);
 		tcp_l->get<std::size_t> ("io_timeout", transport_tcp.io_timeout);
+		tcp_l->get<std::size_t> ("stream_buffer_size", transport_tcp.stream_buffer_size);
 	}
 
 	auto domain_l (toml.get_optional_child ("local"));
@@ -61,6 +79,22 @@ nano::error nano::ipc::ipc_config::deserialize_toml (nano::tomlconfig & toml)
 		domain_l->get<bool> ("enable", transport_domain.enabled);
 		domain_l->get<std::string> ("path", transport_domain.path);
 		domain_l->get<std::size_t> ("io_timeout", transport_domain.io_timeout);
+		domain_l->get<std::size_t> ("stream_buffer_size", transport_domain.stream_buffer_size);
+	}
+
+	auto shared_memory_l (toml.get_optional_child ("shared_memory"));
+	if (shared_memory_l)
+	{
+		shared_memory_l->get<bool> ("allow_unsafe", transport_shared_memory.allow_unsafe);
+		shared_memory_l->get<bool> ("enable", transport_shared_memory.enabled);
+		shared_memory_l->get<std::string> ("name", transport_shared_memory.name);
+		shared_memory_l->get<std::size_t> ("capacity", transport_shared_memory.capacity);
+		shared_memory_l->get<std::size_t> ("io_timeout", transport_shared_memory.io_timeout);
+
+		if (!std::has_single_bit (transport_shared_memory.capacity))
+		{
+			toml.get_error ().set ("shared_memory.capacity must be a power of two");
+		}
 	}
 
 	auto flatbuffers_l (toml.get_optional_child ("flatbuffers"));
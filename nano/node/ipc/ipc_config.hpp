@@ -19,6 +19,8 @@ namespace ipc
 		bool allow_unsafe{ false };
 		std::size_t io_timeout{ 15 };
 		long io_threads{ -1 };
+		/** Maximum number of events buffered per subscriber before new events are dropped */
+		std::size_t stream_buffer_size{ 16 * 1024 };
 	};
 
 	/**
@@ -52,18 +54,31 @@ namespace ipc
 		uint16_t port;
 	};
 
+	/** Shared memory transport config, for consumers running on the same host */
+	class ipc_config_shared_memory : public ipc_config_transport
+	{
+	public:
+		ipc_config_shared_memory (nano::network_constants & network_constants);
+		/** Name of the shared memory segment, defaults to one per network so nodes of different networks can share a host */
+		std::string name;
+		/** Size in bytes of each ring buffer, must be a power of two */
+		std::size_t capacity{ 16 * 1024 * 1024 };
+	};
+
 	/** IPC configuration */
 	class ipc_config
 	{
 	public:
 		ipc_config (nano::network_constants & network_constants) :
-			transport_tcp{ network_constants }
+			transport_tcp{ network_constants },
+			transport_shared_memory{ network_constants }
 		{
 		}
 		nano::error deserialize_toml (nano::tomlconfig & toml_a);
 		nano::error serialize_toml (nano::tomlconfig & toml) const;
 		ipc_config_domain_socket transport_domain;
 		ipc_config_tcp_socket transport_tcp;
+		ipc_config_shared_memory transport_shared_memory;
 		ipc_config_flatbuffers flatbuffers;
 	};
 }
@@ -4,6 +4,7 @@
 #include <nano/boost/asio/strand.hpp>
 #include <nano/lib/config.hpp>
 #include <nano/lib/ipc.hpp>
+#include <nano/lib/ipc_shared_memory.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/thread_runner.hpp>
 #include <nano/lib/threading.hpp>
@@ -15,11 +16,14 @@
 #include <nano/node/node.hpp>
 
 #include <boost/array.hpp>
+#include <boost/circular_buffer.hpp>
 #include <boost/endian/conversion.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
 #include <atomic>
 #include <chrono>
+#include <future>
+#include <thread>
 
 #include <flatbuffers/flatbuffers.h>
 
@@ -35,7 +39,8 @@ public:
 	session (nano::ipc::ipc_server & server_a, boost::asio::io_context & io_ctx_a, nano::ipc::ipc_config_transport & config_transport_a) :
 		socket_base (io_ctx_a),
 		server (server_a), node (server_a.node), session_id (server_a.id_dispenser.fetch_add (1)),
-		io_ctx (io_ctx_a), strand (io_ctx_a.get_executor ()), socket (io_ctx_a), config_transport (config_transport_a)
+		io_ctx (io_ctx_a), strand (io_ctx_a.get_executor ()), socket (io_ctx_a), config_transport (config_transport_a),
+		stream (config_transport_a.stream_buffer_size)
 	{
 		node.logger.debug (nano::log::type::ipc, "Creating session with id: {}", session_id.load ());
 	}
@@ -79,6 +84,16 @@ public:
 				}
 			}
 
+			bool stream_event (std::shared_ptr<nano::ipc::event const> const & event_a) override
+			{
+				bool dropped{ true };
+				if (auto session_l = session_m.lock ())
+				{
+					dropped = session_l->stream_event (event_a);
+				}
+				return dropped;
+			}
+
 			uint64_t get_id () const override
 			{
 				uint64_t id{ 0 };
@@ -177,13 +192,69 @@ public:
 		}));
 	}
 
+	/**
+	 * Buffer an event for streaming to the client. Only one batch of stream frames is queued for writing at a time,
+	 * the next batch is taken once the previous one has been written, so a slow client fills the bounded buffer instead of the send queue.
+	 * @return true if the event was dropped because the stream buffer is full
+	 */
+	bool stream_event (std::shared_ptr<nano::ipc::event const> const & event_a)
+	{
+		nano::unique_lock<nano::mutex> lock{ stream_mutex };
+		if (stream.full ())
+		{
+			return true;
+		}
+		stream.push_back (event_a);
+		if (!stream_writing)
+		{
+			stream_writing = true;
+			lock.unlock ();
+			boost::asio::post (strand, boost::asio::bind_executor (strand, [this_l = this->shared_from_this ()] () {
+				this_l->write_stream ();
+			}));
+		}
+		return false;
+	}
+
+	/** Queues all buffered stream events as a single write, must be called on the strand */
+	void write_stream ()
+	{
+		std::vector<std::shared_ptr<nano::ipc::event const>> frames;
+		{
+			nano::lock_guard<nano::mutex> guard{ stream_mutex };
+			debug_assert (stream_writing);
+			if (stream.empty ())
+			{
+				stream_writing = false;
+				return;
+			}
+			frames.assign (stream.begin (), stream.end ());
+			stream.clear ();
+		}
+
+		// The next batch is taken once this one is written, buffering further events in the meantime
+		std::weak_ptr<session> this_w (this->shared_from_this ());
+		auto written = [this_w] (boost::system::error_code const & ec_a, std::size_t size_a) {
+			if (auto this_l = this_w.lock (); this_l && !ec_a)
+			{
+				this_l->write_stream ();
+			}
+		};
+
+		bool write_in_progress = !send_queue.empty ();
+		send_queue.emplace_back (queue_item{ {}, written, std::move (frames) });
+		if (!write_in_progress)
+		{
+			write_queued_messages ();
+		}
+	}
+
 	void write_queued_messages ()
 	{
 		std::weak_ptr<session> this_w (this->shared_from_this ());
 		auto msg (send_queue.front ());
 		timer_start (std::chrono::seconds (config_transport.io_timeout));
-		nano::unsafe_async_write (socket, msg.buffer,
-		boost::asio::bind_executor (strand,
+		auto handler = boost::asio::bind_executor (strand,
 		[msg, this_w] (boost::system::error_code ec, std::size_t size_a) {
 			if (auto this_l = this_w.lock ())
 			{
@@ -200,7 +271,24 @@ public:
 					this_l->write_queued_messages ();
 				}
 			}
-		}));
+		});
+
+		if (msg.frames.empty ())
+		{
+			nano::unsafe_async_write (socket, msg.buffer, std::move (handler));
+		}
+		else
+		{
+			// Gather write of all frames, each is a big endian length followed by the shared payload
+			std::vector<boost::asio::const_buffer> buffers;
+			buffers.reserve (msg.frames.size () * 2);
+			for (auto const & frame : msg.frames)
+			{
+				buffers.push_back (boost::asio::buffer (&frame->length, sizeof (frame->length)));
+				buffers.push_back (boost::asio::buffer (frame->data (), frame->size ()));
+			}
+			nano::unsafe_async_write (socket, buffers, std::move (handler));
+		}
 	}
 
 	/**
@@ -407,12 +495,14 @@ public:
 	}
 
 private:
-	/** Holds the buffer and callback for queued writes */
+	/** Holds the buffer and callback for queued writes, or a batch of stream frames */
 	class queue_item
 	{
 	public:
 		boost::asio::const_buffer buffer;
 		std::function<void (boost::system::error_code const &, std::size_t)> callback;
+		/** Stream events, written instead of the buffer when not empty. The queue item keeps the shared payloads alive. */
+		std::vector<std::shared_ptr<nano::ipc::event const>> frames;
 	};
 	std::size_t const queue_size_max = 64 * 1024;
 
@@ -463,6 +553,12 @@ private:
 
 	/** Session subscriber */
 	std::shared_ptr<nano::ipc::subscriber> subscriber;
+
+	/** Bounded buffer of events waiting to be streamed, filled by the broker and drained by write_stream () */
+	boost::circular_buffer<std::shared_ptr<nano::ipc::event const>> stream;
+	/** Set while a batch of stream frames is queued or being written */
+	bool stream_writing{ false };
+	nano::mutex stream_mutex;
 };
 
 /** Domain and TCP socket transport */
@@ -562,6 +658,253 @@ std::optional<std::uint16_t> socket_transport<ACCEPTOR_TYPE, SOCKET_TYPE, ENDPOI
 	return std::nullopt;
 }
 
+/**
+ * Shared memory transport for clients on the same host, see nano::ipc::shm_channel.
+ * Requests are read and handled in order on a dedicated thread, the same way socket sessions read the next request only after replying.
+ * Replies and subscription events are written to the reply ring without a syscall or socket copy. One client is served at a time,
+ * all session state, including subscriptions, is dropped when a new client attaches.
+ */
+class shared_memory_transport final : public nano::ipc::transport, public std::enable_shared_from_this<shared_memory_transport>
+{
+public:
+	class client_session final : public nano::ipc::subscriber, public std::enable_shared_from_this<client_session>
+	{
+	public:
+		client_session (std::weak_ptr<shared_memory_transport> const & transport_a) :
+			transport{ transport_a }
+		{
+		}
+
+		void async_send_message (uint8_t const * data_a, std::size_t length_a, std::function<void (nano::error const &)> broadcast_completion_handler_a) override
+		{
+			bool error{ true };
+			if (auto transport_l = transport.lock ())
+			{
+				error = transport_l->write_reply (data_a, length_a);
+			}
+			if (broadcast_completion_handler_a)
+			{
+				broadcast_completion_handler_a (error ? nano::error ("Shared memory write failed") : nano::error{});
+			}
+		}
+
+		bool stream_event (std::shared_ptr<nano::ipc::event const> const & event_a) override
+		{
+			// The reply ring is the stream buffer, events are dropped while the client is not keeping up
+			bool dropped{ true };
+			if (auto transport_l = transport.lock ())
+			{
+				nano::lock_guard<nano::mutex> guard{ transport_l->write_mutex };
+				dropped = transport_l->channel->replies ().write (event_a->data (), event_a->size ());
+			}
+			return dropped;
+		}
+
+		uint64_t get_id () const override
+		{
+			return id;
+		}
+
+		std::string get_service_name () const override
+		{
+			return *service_name.lock ();
+		}
+
+		void set_service_name (std::string const & service_name_a) override
+		{
+			*service_name.lock () = service_name_a;
+		}
+
+		nano::ipc::payload_encoding get_active_encoding () const override
+		{
+			return active_encoding;
+		}
+
+		std::weak_ptr<shared_memory_transport> const transport;
+		uint64_t id{ 0 };
+		nano::locked<std::string> service_name;
+		std::atomic<nano::ipc::payload_encoding> active_encoding{ nano::ipc::payload_encoding::flatbuffers };
+		std::shared_ptr<nano::ipc::flatbuffers_handler> flatbuffers_handler;
+	};
+
+	shared_memory_transport (nano::ipc::ipc_server & server_a, nano::ipc::ipc_config_shared_memory & config_transport_a) :
+		server{ server_a },
+		config_transport{ config_transport_a }
+	{
+		try
+		{
+			channel = nano::ipc::shm_channel::create (config_transport.name, config_transport.capacity);
+		}
+		catch (boost::interprocess::interprocess_exception const & ex)
+		{
+			throw std::runtime_error (std::string ("Could not create shared memory segment: ") + ex.what ());
+		}
+		generation = channel->generation ();
+	}
+
+	~shared_memory_transport ()
+	{
+		debug_assert (!thread.joinable ());
+	}
+
+	void start ()
+	{
+		thread = std::thread ([this] () {
+			nano::thread_role::set (nano::thread_role::name::ipc_shared_memory);
+			run ();
+		});
+	}
+
+	void stop () override
+	{
+		stopped = true;
+		channel->requests ().notify ();
+		if (thread.joinable ())
+		{
+			thread.join ();
+		}
+	}
+
+	/**
+	 * Writes a reply frame, waiting for the client to free up space in the ring for at most the configured io timeout
+	 * @return true if the reply could not be written
+	 */
+	bool write_reply (uint8_t const * data_a, std::size_t size_a)
+	{
+		auto const deadline = std::chrono::steady_clock::now () + std::chrono::seconds (config_transport.io_timeout);
+		while (true)
+		{
+			{
+				nano::lock_guard<nano::mutex> guard{ write_mutex };
+				if (!channel->replies ().write (data_a, size_a))
+				{
+					return false;
+				}
+			}
+			if (stopped || std::chrono::steady_clock::now () > deadline)
+			{
+				server.node.logger.error (nano::log::type::ipc, "Shared memory reply ring is full, reply dropped");
+				return true;
+			}
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+		}
+	}
+
+private:
+	void run ()
+	{
+		std::vector<uint8_t> request;
+		while (!stopped)
+		{
+			if (channel->requests ().read (request, std::chrono::milliseconds (100)))
+			{
+				if (auto const corruptions_l = channel->requests ().corruptions (); corruptions_l != corruptions)
+				{
+					corruptions = corruptions_l;
+					server.node.stats.inc (nano::stat::type::ipc, nano::stat::detail::shared_memory_corrupt);
+					server.node.logger.warn (nano::log::type::ipc, "Shared memory request ring is inconsistent, pending requests dropped");
+				}
+				continue;
+			}
+			// Clients register before sending their first request
+			if (!current || channel->generation () != generation)
+			{
+				generation = channel->generation ();
+				current = std::make_shared<client_session> (weak_from_this ());
+				current->id = server.id_dispenser.fetch_add (1);
+				server.node.logger.debug (nano::log::type::ipc, "Shared memory client attached, session id: {}", current->id);
+			}
+			process (request);
+		}
+	}
+
+	/** Requests are framed as the preamble followed by the payload, the ring already provides the length */
+	void process (std::vector<uint8_t> const & request_a)
+	{
+		if (request_a.size () < 4 || request_a[nano::ipc::preamble_offset::lead] != 'N' || request_a[nano::ipc::preamble_offset::reserved_1] != 0 || request_a[nano::ipc::preamble_offset::reserved_2] != 0)
+		{
+			server.node.logger.error (nano::log::type::ipc, "Invalid preamble");
+			return;
+		}
+
+		auto const encoding = static_cast<nano::ipc::payload_encoding> (request_a[nano::ipc::preamble_offset::encoding]);
+		auto const payload = request_a.data () + 4;
+		auto const payload_size = request_a.size () - 4;
+		current->active_encoding = encoding;
+
+		switch (encoding)
+		{
+			case nano::ipc::payload_encoding::json_v1:
+			case nano::ipc::payload_encoding::json_v1_unsafe:
+			{
+				server.node.stats.inc (nano::stat::type::ipc, nano::stat::detail::invocations);
+				auto done = std::make_shared<std::promise<void>> ();
+				auto completed = done->get_future ();
+				auto response_handler = [this_w = weak_from_this (), done] (std::string const & body) {
+					if (auto this_l = this_w.lock ())
+					{
+						this_l->write_reply (reinterpret_cast<uint8_t const *> (body.data ()), body.size ());
+					}
+					done->set_value ();
+				};
+				auto handler (std::make_shared<nano::json_handler> (server.node, server.node_rpc_config, std::string (reinterpret_cast<char const *> (payload), payload_size), response_handler, [server_w = server.weak_from_this ()] () {
+					// Stopping joins this thread, so it is done from a separate one
+					std::thread ([server_w] () {
+						std::this_thread::sleep_for (std::chrono::seconds (1));
+						if (auto server = server_w.lock ())
+						{
+							server->stop ();
+						}
+					})
+					.detach ();
+				}));
+				// For unsafe actions to be allowed, the unsafe encoding must be used AND the transport config must allow it
+				handler->process_request (encoding == nano::ipc::payload_encoding::json_v1_unsafe && config_transport.allow_unsafe);
+				completed.wait_for (std::chrono::seconds (config_transport.io_timeout));
+				break;
+			}
+			case nano::ipc::payload_encoding::flatbuffers:
+			case nano::ipc::payload_encoding::flatbuffers_json:
+			{
+				// Lazily create one Flatbuffers handler instance per session
+				if (!current->flatbuffers_handler)
+				{
+					current->flatbuffers_handler = std::make_shared<nano::ipc::flatbuffers_handler> (server.node, server, current, server.node.config.ipc_config);
+				}
+				if (encoding == nano::ipc::payload_encoding::flatbuffers_json)
+				{
+					current->flatbuffers_handler->process_json (payload, payload_size, [this] (std::shared_ptr<std::string> const & body) {
+						write_reply (reinterpret_cast<uint8_t const *> (body->data ()), body->size ());
+					});
+				}
+				else
+				{
+					current->flatbuffers_handler->process (payload, payload_size, [this] (std::shared_ptr<flatbuffers::FlatBufferBuilder> const & fbb) {
+						write_reply (fbb->GetBufferPointer (), fbb->GetSize ());
+					});
+				}
+				break;
+			}
+			default:
+				server.node.logger.error (nano::log::type::ipc, "Unsupported payload encoding");
+				break;
+		}
+	}
+
+	nano::ipc::ipc_server & server;
+	nano::ipc::ipc_config_shared_memory & config_transport;
+	std::unique_ptr<nano::ipc::shm_channel> channel;
+	/** Serializes writers of the reply ring, which is single producer */
+	nano::mutex write_mutex;
+	/** Session of the attached client, only accessed by the request thread */
+	std::shared_ptr<client_session> current;
+	uint64_t generation{ 0 };
+	/** Corruptions of the request ring already reported, only accessed by the request thread */
+	uint64_t corruptions{ 0 };
+	std::atomic<bool> stopped{ false };
+	std::thread thread;
+};
+
 }
 
 nano::ipc::ipc_server::ipc_server (nano::node & node_a, nano::node_rpc_config const & node_rpc_config_a) :
@@ -594,6 +937,13 @@ nano::ipc::ipc_server::ipc_server (nano::node & node_a, nano::node_rpc_config co
 			transports.push_back (std::make_shared<tcp_socket_transport> (*this, boost::asio::ip::tcp::endpoint (boost::asio::ip::tcp::v6 (), node_a.config.ipc_config.transport_tcp.port), node_a.config.ipc_config.transport_tcp, threads));
 		}
 
+		if (node_a.config.ipc_config.transport_shared_memory.enabled)
+		{
+			auto transport = std::make_shared<shared_memory_transport> (*this, node_a.config.ipc_config.transport_shared_memory);
+			transport->start ();
+			transports.push_back (transport);
+		}
+
 		node.logger.debug (nano::log::type::ipc_server, "Server started");
 
 		if (!transports.empty ())
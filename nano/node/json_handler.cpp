@@ -3,6 +3,7 @@
 #include <nano/lib/config.hpp>
 #include <nano/lib/json_error_response.hpp>
 #include <nano/lib/jsonconfig.hpp>
+#include <nano/lib/locks.hpp>
 #include <nano/lib/stats_sinks.hpp>
 #include <nano/lib/timer.hpp>
 #include <nano/lib/work_version.hpp>
@@ -19,6 +20,7 @@
 #include <nano/secure/ledger.hpp>
 #include <nano/secure/ledger_set_any.hpp>
 #include <nano/secure/ledger_set_confirmed.hpp>
+#include <nano/secure/receivable_batch_iterator.hpp>
 #include <nano/secure/transaction.hpp>
 
 #include <boost/property_tree/json_parser.hpp>
@@ -26,6 +28,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -1022,65 +1025,82 @@ void nano::json_handler::accounts_receivable ()
 	bool const include_only_confirmed = request.get<bool> ("include_only_confirmed", true);
 	bool const sorting = request.get<bool> ("sorting", false);
 	auto simple (threshold.is_zero () && !source && !sorting); // if simple, response is a list of hashes for each account
-	boost::property_tree::ptree pending;
+	std::vector<nano::account> accounts;
+	for (auto & accounts_l : request.get_child ("accounts"))
+	{
+		auto account (account_impl (accounts_l.second.data ()));
+		if (ec)
+		{
+			break;
+		}
+		accounts.push_back (account);
+	}
+	// Receivable entries of all accounts are collected in a single pass and reported in request order
+	std::unordered_map<nano::account, boost::property_tree::ptree> results;
 	auto transaction = node.ledger.tx_begin_read ();
-	for (auto & accounts : request.get_child ("accounts"))
+	for (nano::receivable_batch_iterator i{ node.ledger, transaction, accounts }; !ec && !i.end ();)
 	{
-		auto account (account_impl (accounts.second.data ()));
-		if (!ec)
+		nano::pending_key const & key (i->first);
+		auto & peers_l = results[key.account];
+		if (peers_l.size () >= count)
 		{
-			boost::property_tree::ptree peers_l;
-			for (auto i (node.store.pending.begin (transaction, nano::pending_key (account, 0))), n (node.store.pending.end (transaction)); i != n && nano::pending_key (i->first).account == account && peers_l.size () < count; ++i)
+			i.next_account ();
+			continue;
+		}
+		if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+		{
+			if (simple)
+			{
+				boost::property_tree::ptree entry;
+				entry.put ("", key.hash.to_string ());
+				peers_l.push_back (std::make_pair ("", entry));
+			}
+			else
 			{
-				nano::pending_key const & key (i->first);
-				if (block_confirmed (node, transaction, key.hash, include_active, include_only_confirmed))
+				nano::pending_info const & info (i->second);
+				if (info.amount.number () >= threshold.number ())
 				{
-					if (simple)
+					if (source)
 					{
-						boost::property_tree::ptree entry;
-						entry.put ("", key.hash.to_string ());
-						peers_l.push_back (std::make_pair ("", entry));
+						boost::property_tree::ptree pending_tree;
+						pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
+						pending_tree.put ("source", info.source.to_account ());
+						peers_l.add_child (key.hash.to_string (), pending_tree);
 					}
 					else
 					{
-						nano::pending_info const & info (i->second);
-						if (info.amount.number () >= threshold.number ())
-						{
-							if (source)
-							{
-								boost::property_tree::ptree pending_tree;
-								pending_tree.put ("amount", info.amount.number ().convert_to<std::string> ());
-								pending_tree.put ("source", info.source.to_account ());
-								peers_l.add_child (key.hash.to_string (), pending_tree);
-							}
-							else
-							{
-								peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
-							}
-						}
+						peers_l.put (key.hash.to_string (), info.amount.number ().convert_to<std::string> ());
 					}
 				}
 			}
-			if (sorting && !simple)
+		}
+		++i;
+	}
+	boost::property_tree::ptree pending;
+	for (auto const & account : accounts)
+	{
+		auto existing = results.find (account);
+		if (existing == results.end () || existing->second.empty ())
+		{
+			continue;
+		}
+		auto & peers_l = existing->second;
+		if (sorting && !simple)
+		{
+			if (source)
 			{
-				if (source)
-				{
-					peers_l.sort ([] (auto const & child1, auto const & child2) -> bool {
-						return child1.second.template get<nano::uint128_t> ("amount") > child2.second.template get<nano::uint128_t> ("amount");
-					});
-				}
-				else
-				{
-					peers_l.sort ([] (auto const & child1, auto const & child2) -> bool {
-						return child1.second.template get<nano::uint128_t> ("") > child2.second.template get<nano::uint128_t> ("");
-					});
-				}
+				peers_l.sort ([] (auto const & child1, auto const & child2) -> bool {
+					return child1.second.template get<nano::uint128_t> ("amount") > child2.second.template get<nano::uint128_t> ("amount");
+				});
 			}
-			if (!peers_l.empty ())
+			else
 			{
-				pending.add_child (account.to_account (), peers_l);
+				peers_l.sort ([] (auto const & child1, auto const & child2) -> bool {
+					return child1.second.template get<nano::uint128_t> ("") > child2.second.template get<nano::uint128_t> ("");
+				});
 			}
 		}
+		pending.add_child (account.to_account (), peers_l);
 	}
 	response_l.add_child ("blocks", pending);
 	response_errors ();
@@ -4678,9 +4698,7 @@ void nano::json_handler::wallet_lock ()
 	auto wallet (wallet_impl ());
 	if (!ec)
 	{
-		nano::raw_key empty;
-		empty.clear ();
-		wallet->store.password.value_set (empty);
+		wallet->store.lock ();
 		response_l.put ("locked", "1");
 
 		node.logger.warn (nano::log::type::rpc, "Wallet locked");
@@ -5188,6 +5206,41 @@ void nano::json_handler::debug_bootstrap_priority_info ()
 	response_errors ();
 }
 
+void nano::json_handler::debug_lock_contention ()
+{
+	if (!ec)
+	{
+		if (auto enable = request.get_optional<bool> ("enable"))
+		{
+			nano::lock_profiler::enable (*enable);
+		}
+		if (request.get_optional<bool> ("reset") == true)
+		{
+			nano::lock_profiler::reset ();
+		}
+		response_l.put ("enabled", nano::lock_profiler::enabled ());
+
+		auto to_us = [] (std::chrono::nanoseconds duration) {
+			return std::chrono::duration_cast<std::chrono::microseconds> (duration).count ();
+		};
+		boost::property_tree::ptree response_locks;
+		for (auto const & entry : nano::lock_profiler::collect ())
+		{
+			boost::property_tree::ptree response_lock;
+			response_lock.put ("acquisitions", entry.acquisitions);
+			response_lock.put ("contended", entry.contended);
+			response_lock.put ("wait_us", to_us (entry.wait));
+			response_lock.put ("wait_max_us", to_us (entry.wait_max));
+			response_lock.put ("hold_samples", entry.hold_samples);
+			response_lock.put ("hold_average_us", entry.hold_samples > 0 ? to_us (entry.hold) / entry.hold_samples : 0);
+			response_lock.put ("hold_max_us", to_us (entry.hold_max));
+			response_locks.add_child (entry.name, response_lock);
+		}
+		response_l.add_child ("locks", response_locks);
+	}
+	response_errors ();
+}
+
 void nano::inprocess_rpc_handler::process_request (std::string const &, std::string const & body_a, std::function<void (std::string const &)> response_a)
 {
 	// Note that if the rpc action is async, the shared_ptr<json_handler> lifetime will be extended by the action handler
@@ -5354,6 +5407,7 @@ ipc_json_handler_no_arg_func_map create_ipc_json_handler_no_arg_func_map ()
 	no_arg_funcs.emplace ("work_peers_clear", &nano::json_handler::work_peers_clear);
 	no_arg_funcs.emplace ("populate_backlog", &nano::json_handler::populate_backlog);
 	no_arg_funcs.emplace ("debug_bootstrap_priority_info", &nano::json_handler::debug_bootstrap_priority_info);
+	no_arg_funcs.emplace ("debug_lock_contention", &nano::json_handler::debug_lock_contention);
 	return no_arg_funcs;
 }
 
@@ -91,13 +91,22 @@ bool nano::local_vote_history::exists (nano::root const & root_a) const
 void nano::local_vote_history::clean ()
 {
 	debug_assert (constants.max_cache > 0);
+	auto const capacity = std::max<std::size_t> (1, static_cast<std::size_t> (constants.max_cache * scale));
 	auto & history_by_sequence (history.get<tag_sequence> ());
-	while (history_by_sequence.size () > constants.max_cache)
+	while (history_by_sequence.size () > capacity)
 	{
 		history_by_sequence.erase (history_by_sequence.begin ());
 	}
 }
 
+void nano::local_vote_history::capacity_scale (double scale_a)
+{
+	debug_assert (scale_a > 0.0 && scale_a <= 1.0);
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	scale = scale_a;
+	clean ();
+}
+
 std::size_t nano::local_vote_history::size () const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
@@ -50,6 +50,9 @@ public:
 	bool exists (nano::root const &) const;
 	std::size_t size () const;
 
+	/** Limits the history to a fraction of the configured maximum size, evicting the oldest votes if needed */
+	void capacity_scale (double);
+
 	nano::container_info container_info () const;
 
 private:
@@ -63,6 +66,7 @@ private:
 	// clang-format on
 
 	nano::voting_constants const & constants;
+	double scale{ 1.0 };
 	void clean ();
 	std::vector<std::shared_ptr<nano::vote>> votes (nano::root const & root_a) const;
 	// Only used in Debug
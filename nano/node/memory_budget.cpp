@@ -0,0 +1,175 @@
+#include <nano/lib/logging.hpp>
+#include <nano/lib/memory.hpp>
+#include <nano/lib/stats.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/tomlconfig.hpp>
+#include <nano/node/memory_budget.hpp>
+
+#include <algorithm>
+
+nano::memory_budget::memory_budget (nano::memory_budget_config const & config_a, nano::stats & stats_a, nano::logger & logger_a) :
+	resident_memory_query{ [] () { return nano::resident_memory (); } },
+	config{ config_a },
+	stats{ stats_a },
+	logger{ logger_a }
+{
+}
+
+nano::memory_budget::~memory_budget ()
+{
+	debug_assert (!thread.joinable ());
+}
+
+void nano::memory_budget::start ()
+{
+	debug_assert (!thread.joinable ());
+
+	if (config.target == 0)
+	{
+		return;
+	}
+
+	thread = std::thread ([this] () {
+		nano::thread_role::set (nano::thread_role::name::memory_budget);
+		run ();
+	});
+}
+
+void nano::memory_budget::stop ()
+{
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		stopped = true;
+	}
+	condition.notify_all ();
+	if (thread.joinable ())
+	{
+		thread.join ();
+	}
+}
+
+void nano::memory_budget::add (std::string const & name, usage_query usage, scale_action action)
+{
+	debug_assert (!thread.joinable ());
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	containers.push_back ({ name, std::move (usage), std::move (action) });
+}
+
+void nano::memory_budget::run ()
+{
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	while (!stopped)
+	{
+		condition.wait_for (lock, config.interval, [this] { return stopped; });
+		if (!stopped)
+		{
+			stats.inc (nano::stat::type::memory_budget, nano::stat::detail::loop);
+
+			lock.unlock ();
+			adjust ();
+			lock.lock ();
+		}
+	}
+}
+
+void nano::memory_budget::adjust ()
+{
+	auto const resident = resident_memory_query ();
+	if (resident == 0)
+	{
+		stats.inc (nano::stat::type::memory_budget, nano::stat::detail::unsupported);
+		return;
+	}
+
+	// Querying containers locks them, do it without holding our own mutex
+	std::vector<tracked> containers_l;
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		containers_l = containers;
+	}
+	size_t tracked_usage = 0;
+	for (auto const & container : containers_l)
+	{
+		tracked_usage += container.usage ().memory_usage ();
+	}
+
+	auto const target = config.target * 1024 * 1024;
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	auto const previous = scale_m;
+	if (resident > target && tracked_usage > 0)
+	{
+		// Shed the excess from the tracked containers
+		auto const reduction = std::min (max_shrink, static_cast<double> (resident - target) / static_cast<double> (tracked_usage));
+		scale_m = std::max (config.min_scale, scale_m * (1.0 - reduction));
+	}
+	else if (resident < target * grow_threshold)
+	{
+		scale_m = std::min (1.0, scale_m * grow_step);
+	}
+	resident_last = resident;
+	tracked_last = tracked_usage;
+	auto const scale_l = scale_m;
+	lock.unlock ();
+
+	if (scale_l != previous)
+	{
+		stats.inc (nano::stat::type::memory_budget, scale_l < previous ? nano::stat::detail::shrink : nano::stat::detail::grow);
+		logger.debug (nano::log::type::memory_budget, "Scaling container limits to {:.2f} (resident: {} MB, target: {} MB, tracked: {} MB)",
+		scale_l,
+		resident / 1024 / 1024,
+		config.target,
+		tracked_usage / 1024 / 1024);
+
+		for (auto const & container : containers_l)
+		{
+			container.action (scale_l);
+		}
+	}
+	stats.sample (nano::stat::sample::memory_budget_resident_mb, static_cast<int64_t> (resident / 1024 / 1024), { 0, static_cast<int64_t> (config.target) });
+}
+
+double nano::memory_budget::scale () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	return scale_m;
+}
+
+nano::container_info nano::memory_budget::container_info () const
+{
+	nano::lock_guard<nano::mutex> guard{ mutex };
+
+	nano::container_info info;
+	info.put ("containers", containers.size ());
+	info.put ("resident", resident_last);
+	info.put ("tracked", tracked_last);
+	return info;
+}
+
+/*
+ * memory_budget_config
+ */
+
+nano::error nano::memory_budget_config::serialize (nano::tomlconfig & toml) const
+{
+	toml.put ("target", target, "Resident memory target for the node process in megabytes. When exceeded, vote, confirmation, unchecked and bootstrap caches are shrunk until memory usage drops below the target. \n0 disables the memory budget.\ntype:uint64");
+	toml.put ("min_scale", min_scale, "Lowest fraction of their configured size the caches can be shrunk to. \ntype:double,[0..1]");
+	toml.put ("interval", interval.count (), "Interval between memory usage checks. \ntype:seconds");
+
+	return toml.get_error ();
+}
+
+nano::error nano::memory_budget_config::deserialize (nano::tomlconfig & toml)
+{
+	toml.get ("target", target);
+	toml.get ("min_scale", min_scale);
+	auto interval_l = interval.count ();
+	toml.get ("interval", interval_l);
+	interval = std::chrono::seconds{ interval_l };
+
+	if (min_scale <= 0.0 || min_scale > 1.0)
+	{
+		toml.get_error ().set ("min_scale must be greater than 0 and at most 1");
+	}
+
+	return toml.get_error ();
+}
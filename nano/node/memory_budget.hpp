@@ -0,0 +1,91 @@
+#pragma once
+
+#include <nano/lib/locks.hpp>
+#include <nano/node/fwd.hpp>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nano
+{
+class memory_budget_config final
+{
+public:
+	nano::error deserialize (nano::tomlconfig &);
+	nano::error serialize (nano::tomlconfig &) const;
+
+public:
+	/** Resident memory target for the whole process in megabytes, 0 disables the budget */
+	size_t target{ 0 };
+	/** Lowest fraction of their configured limits the tracked containers are shrunk to */
+	double min_scale{ 0.1 };
+	std::chrono::seconds interval{ 5 };
+};
+
+/**
+ * Keeps the resident memory of the node below a target by scaling the limits of registered caches and queues.
+ * Limits are lowered proportionally to the excess over the target when it is exceeded and raised back gradually,
+ * up to their configured maximum, once memory usage is comfortably below the target.
+ */
+class memory_budget final
+{
+public:
+	/** Returns the current state of a tracked container, used to estimate its memory usage */
+	using usage_query = std::function<nano::container_info ()>;
+	/** Applies a fraction in the range (0, 1] to the configured limit of a tracked container */
+	using scale_action = std::function<void (double)>;
+
+	memory_budget (memory_budget_config const &, nano::stats &, nano::logger &);
+	~memory_budget ();
+
+	void start ();
+	void stop ();
+
+	/** Registers a container, must be called before start */
+	void add (std::string const & name, usage_query, scale_action);
+
+	double scale () const;
+	nano::container_info container_info () const;
+
+public: // Tests
+	/** Single adjustment step, performed periodically */
+	void adjust ();
+
+	/** Source of the resident memory size in bytes, 0 if unavailable */
+	std::function<size_t ()> resident_memory_query;
+
+private: // Dependencies
+	memory_budget_config const & config;
+	nano::stats & stats;
+	nano::logger & logger;
+
+private:
+	void run ();
+
+	struct tracked
+	{
+		std::string name;
+		usage_query usage;
+		scale_action action;
+	};
+	std::vector<tracked> containers;
+
+	double scale_m{ 1.0 };
+	size_t resident_last{ 0 };
+	size_t tracked_last{ 0 };
+
+	bool stopped{ false };
+	mutable nano::mutex mutex;
+	nano::condition_variable condition;
+	std::thread thread;
+
+	// Limits are only raised again once resident memory drops below this fraction of the target
+	static double constexpr grow_threshold{ 0.85 };
+	static double constexpr grow_step{ 1.1 };
+	// Limits are at most halved in a single step
+	static double constexpr max_shrink{ 0.5 };
+};
+}
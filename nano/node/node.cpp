@@ -10,6 +10,7 @@
 #include <nano/node/active_elections.hpp>
 #include <nano/node/backlog_scan.hpp>
 #include <nano/node/bandwidth_limiter.hpp>
+#include <nano/node/block_filter_service.hpp>
 #include <nano/node/bootstrap/bootstrap_server.hpp>
 #include <nano/node/bootstrap/bootstrap_service.hpp>
 #include <nano/node/bootstrap_weights_beta.hpp>
@@ -24,6 +25,7 @@
 #include <nano/node/local_block_broadcaster.hpp>
 #include <nano/node/local_vote_history.hpp>
 #include <nano/node/make_store.hpp>
+#include <nano/node/memory_budget.hpp>
 #include <nano/node/message_processor.hpp>
 #include <nano/node/monitor.hpp>
 #include <nano/node/node.hpp>
@@ -39,6 +41,7 @@
 #include <nano/node/scheduler/optimistic.hpp>
 #include <nano/node/scheduler/priority.hpp>
 #include <nano/node/telemetry.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/vote_generator.hpp>
 #include <nano/node/vote_processor.hpp>
@@ -96,6 +99,8 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	stats{ *stats_impl },
 	runner_impl{ std::make_unique<nano::thread_runner> (io_ctx_shared, logger, config.io_threads) },
 	runner{ *runner_impl },
+	io_shards_impl{ std::make_unique<nano::transport::io_shards> (io_ctx, config.io_shards, logger) },
+	io_shards{ *io_shards_impl },
 	observers_impl{ std::make_unique<nano::node_observers> () },
 	observers{ *observers_impl },
 	workers_impl{ std::make_unique<nano::thread_pool> (config.background_threads, nano::thread_role::name::worker, /* start immediately */ true) },
@@ -179,13 +184,13 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	scheduler{ *scheduler_impl },
 	aggregator_impl{ std::make_unique<nano::request_aggregator> (config.request_aggregator, *this, generator, final_generator, history, ledger, wallets, vote_router) },
 	aggregator{ *aggregator_impl },
-	backlog_scan_impl{ std::make_unique<nano::backlog_scan> (config.backlog_scan, ledger, stats) },
+	backlog_scan_impl{ std::make_unique<nano::backlog_scan> (config.backlog_scan, ledger, ledger_notifications, confirming_set, stats) },
 	backlog_scan{ *backlog_scan_impl },
 	backlog_impl{ std::make_unique<nano::bounded_backlog> (config, *this, ledger, ledger_notifications, bucketing, backlog_scan, block_processor, confirming_set, stats, logger) },
 	backlog{ *backlog_impl },
 	bootstrap_server_impl{ std::make_unique<nano::bootstrap_server> (config.bootstrap_server, store, ledger, network_params.network, stats) },
 	bootstrap_server{ *bootstrap_server_impl },
-	bootstrap_impl{ std::make_unique<nano::bootstrap_service> (config, ledger, ledger_notifications, block_processor, network, stats, logger) },
+	bootstrap_impl{ std::make_unique<nano::bootstrap_service> (config, ledger, ledger_notifications, block_processor, network, stats, logger, application_path / "bootstrap_frontiers.dat") },
 	bootstrap{ *bootstrap_impl },
 	websocket_impl{ std::make_unique<nano::websocket_server> (config.websocket_config, *this, observers, wallets, ledger, io_ctx, logger) },
 	websocket{ *websocket_impl },
@@ -203,6 +208,10 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 	pruning{ *pruning_impl },
 	vote_rebroadcaster_impl{ std::make_unique<nano::vote_rebroadcaster> (vote_router, network, wallets, stats, logger) },
 	vote_rebroadcaster{ *vote_rebroadcaster_impl },
+	block_filter_impl{ std::make_unique<nano::block_filter_service> (config.block_filter, application_path, ledger, stats, logger) },
+	block_filter{ *block_filter_impl },
+	memory_budget_impl{ std::make_unique<nano::memory_budget> (config.memory_budget, stats, logger) },
+	memory_budget{ *memory_budget_impl },
 	startup_time{ std::chrono::steady_clock::now () },
 	node_seq{ seq }
 {
@@ -212,14 +221,31 @@ nano::node::node (std::shared_ptr<boost::asio::io_context> io_ctx_a, std::filesy
 		return ledger.weight (rep);
 	};
 
+	// Caches shrunk under memory pressure
+	memory_budget.add (
+	"vote_cache", [this] () { return vote_cache.container_info (); }, [this] (double scale) { vote_cache.capacity_scale (scale); });
+	memory_budget.add (
+	"recently_confirmed", [this] () { return active.recently_confirmed.container_info (); }, [this] (double scale) { active.recently_confirmed.capacity_scale (scale); });
+	memory_budget.add (
+	"recently_cemented", [this] () { return active.recently_cemented.container_info (); }, [this] (double scale) { active.recently_cemented.capacity_scale (scale); });
+	memory_budget.add (
+	"unchecked", [this] () { return unchecked.container_info (); }, [this] (double scale) { unchecked.capacity_scale (scale); });
+	memory_budget.add (
+	"history", [this] () { return history.container_info (); }, [this] (double scale) { history.capacity_scale (scale); });
+	memory_budget.add (
+	"bootstrap", [this] () { return bootstrap.container_info (); }, [this] (double scale) { bootstrap.capacity_scale (scale); });
+
 	// TODO: Hook this direclty in the schedulers
 	backlog_scan.batch_activated.add ([this] (auto const & batch) {
-		auto transaction = ledger.tx_begin_read ();
+		std::vector<nano::scheduler::priority::account_state> states;
+		states.reserve (batch.size ());
 		for (auto const & info : batch)
 		{
 			scheduler.optimistic.activate (info.account, info.account_info, info.conf_info);
-			scheduler.priority.activate (transaction, info.account, info.account_info, info.conf_info);
+			states.push_back ({ info.account, info.account_info, info.conf_info });
 		}
+		auto transaction = ledger.tx_begin_read ();
+		scheduler.priority.activate (transaction, states);
 	});
 
 	// Do some cleanup due to this block never being processed by confirmation height processor
@@ -491,6 +517,8 @@ void nano::node::process_local_async (std::shared_ptr<nano::block> const & block
 
 void nano::node::start ()
 {
+	// Must be sized before any component writes blocks
+	block_filter.start ();
 	network.start ();
 	message_processor.start ();
 
@@ -558,6 +586,7 @@ void nano::node::start ()
 	http_callbacks.start ();
 	pruning.start ();
 	vote_rebroadcaster.start ();
+	memory_budget.start ();
 
 	add_initial_peers ();
 }
@@ -609,6 +638,9 @@ void nano::node::stop ()
 	http_callbacks.stop ();
 	pruning.stop ();
 	vote_rebroadcaster.stop ();
+	memory_budget.stop ();
+	// Saves the filter, all components writing blocks must be stopped
+	block_filter.stop ();
 
 	bootstrap_workers.stop ();
 	wallet_workers.stop ();
@@ -617,7 +649,9 @@ void nano::node::stop ()
 
 	// work pool is not stopped on purpose due to testing setup
 
-	// Stop the IO runner last
+	// Stop the IO runners last
+	io_shards.abort ();
+	io_shards.join ();
 	runner.abort ();
 	runner.join ();
 	debug_assert (io_ctx_shared.use_count () == 1); // Node should be the last user of the io_context
@@ -978,6 +1012,8 @@ nano::container_info nano::node::container_info () const
 	info.add ("http_callbacks", http_callbacks.container_info ());
 	info.add ("pruning", pruning.container_info ());
 	info.add ("vote_rebroadcaster", vote_rebroadcaster.container_info ());
+	info.add ("block_filter", block_filter.container_info ());
+	info.add ("memory_budget", memory_budget.container_info ());
 	return info;
 }
 
@@ -105,6 +105,8 @@ public:
 	nano::stats & stats;
 	std::unique_ptr<nano::thread_runner> runner_impl;
 	nano::thread_runner & runner;
+	std::unique_ptr<nano::transport::io_shards> io_shards_impl;
+	nano::transport::io_shards & io_shards;
 	std::unique_ptr<nano::node_observers> observers_impl;
 	nano::node_observers & observers;
 	std::unique_ptr<nano::thread_pool> workers_impl;
@@ -202,6 +204,10 @@ public:
 	nano::pruning & pruning;
 	std::unique_ptr<nano::vote_rebroadcaster> vote_rebroadcaster_impl;
 	nano::vote_rebroadcaster & vote_rebroadcaster;
+	std::unique_ptr<nano::block_filter_service> block_filter_impl;
+	nano::block_filter_service & block_filter;
+	std::unique_ptr<nano::memory_budget> memory_budget_impl;
+	nano::memory_budget & memory_budget;
 
 public:
 	std::chrono::steady_clock::time_point const startup_time;
@@ -40,7 +40,8 @@ nano::node_config::node_config (const std::optional<uint16_t> & peering_port_a,
 	peer_history{ network_params.network },
 	tcp{ network_params.network },
 	network{ network_params.network },
-	local_block_broadcaster{ network_params.network }
+	local_block_broadcaster{ network_params.network },
+	backlog_scan{ network_params.network }
 {
 	if (peering_port == 0)
 	{
@@ -106,6 +107,7 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	toml.put ("representative_vote_weight_minimum", representative_vote_weight_minimum.to_string_dec (), "Minimum vote weight that a representative must have for its vote to be counted.\nAll representatives above this weight will be kept in memory!\ntype:string,amount,raw");
 	toml.put ("password_fanout", password_fanout, "Password fanout factor.\ntype:uint64");
 	toml.put ("io_threads", io_threads, "Number of threads dedicated to I/O operations. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
+	toml.put ("io_shards", io_shards, "Number of I/O contexts peer connections are spread over, each run by a dedicated thread. Every connection is bound to one of them when accepted or connected.\nReduces contention on the shared I/O context with many peers, a value close to the number of CPU threads is recommended. Defaults to 0, handling connections on the io_threads.\ntype:uint64");
 	toml.put ("network_threads", network_threads, "Number of threads dedicated to processing network messages. Defaults to the number of CPU threads, and at least 4.\ntype:uint64");
 	toml.put ("work_threads", work_threads, "Number of threads dedicated to CPU generated work. Defaults to all available CPU threads.\ntype:uint64");
 	toml.put ("background_threads", background_threads, "Number of threads dedicated to background node work, including handling of RPC requests. Defaults to all available CPU threads.\ntype:uint64");
@@ -274,6 +276,14 @@ nano::error nano::node_config::serialize_toml (nano::tomlconfig & toml) const
 	bounded_backlog.serialize (bounded_backlog_l);
 	toml.put_child ("bounded_backlog", bounded_backlog_l);
 
+	nano::tomlconfig block_filter_l;
+	block_filter.serialize (block_filter_l);
+	toml.put_child ("block_filter", block_filter_l);
+
+	nano::tomlconfig memory_budget_l;
+	memory_budget.serialize (memory_budget_l);
+	toml.put_child ("memory_budget", memory_budget_l);
+
 	return toml.get_error ();
 }
 
@@ -431,6 +441,18 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 			bounded_backlog.deserialize (config_l);
 		}
 
+		if (toml.has_key ("block_filter"))
+		{
+			auto config_l = toml.get_required_child ("block_filter");
+			block_filter.deserialize (config_l);
+		}
+
+		if (toml.has_key ("memory_budget"))
+		{
+			auto config_l = toml.get_required_child ("memory_budget");
+			memory_budget.deserialize (config_l);
+		}
+
 		/*
 		 * Values
 		 */
@@ -535,6 +557,7 @@ nano::error nano::node_config::deserialize_toml (nano::tomlconfig & toml)
 		toml.get<unsigned> ("bootstrap_fraction_numerator", bootstrap_fraction_numerator);
 		toml.get<unsigned> ("password_fanout", password_fanout);
 		toml.get<unsigned> ("io_threads", io_threads);
+		toml.get<unsigned> ("io_shards", io_shards);
 		toml.get<unsigned> ("work_threads", work_threads);
 		toml.get<unsigned> ("network_threads", network_threads);
 		toml.get<unsigned> ("background_threads", background_threads);
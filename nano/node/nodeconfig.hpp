@@ -10,6 +10,7 @@
 #include <nano/lib/stats.hpp>
 #include <nano/node/active_elections.hpp>
 #include <nano/node/backlog_scan.hpp>
+#include <nano/node/block_filter_service.hpp>
 #include <nano/node/block_processor.hpp>
 #include <nano/node/bootstrap/bootstrap_config.hpp>
 #include <nano/node/bootstrap/bootstrap_server.hpp>
@@ -17,6 +18,7 @@
 #include <nano/node/confirming_set.hpp>
 #include <nano/node/ipc/ipc_config.hpp>
 #include <nano/node/local_block_broadcaster.hpp>
+#include <nano/node/memory_budget.hpp>
 #include <nano/node/message_processor.hpp>
 #include <nano/node/monitor.hpp>
 #include <nano/node/network.hpp>
@@ -83,6 +85,8 @@ public:
 	nano::amount representative_vote_weight_minimum{ 10 * nano::nano_ratio };
 	unsigned password_fanout{ 1024 };
 	unsigned io_threads{ env_io_threads ().value_or (std::max (4u, nano::hardware_concurrency ())) };
+	/** Number of single threaded io_contexts peer sockets are spread over, zero keeps them on the node io_context */
+	unsigned io_shards{ 0 };
 	unsigned network_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned work_threads{ std::max (4u, nano::hardware_concurrency ()) };
 	unsigned background_threads{ std::max (4u, nano::hardware_concurrency ()) };
@@ -152,6 +156,8 @@ public:
 	nano::monitor_config monitor;
 	nano::backlog_scan_config backlog_scan;
 	nano::bounded_backlog_config bounded_backlog;
+	nano::block_filter_config block_filter;
+	nano::memory_budget_config memory_budget;
 
 public:
 	/** Entry is ignored if it cannot be parsed as a valid address:port */
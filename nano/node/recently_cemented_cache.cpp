@@ -14,12 +14,28 @@ void nano::recently_cemented_cache::put (const nano::election_status & status)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 	cemented.push_back (status);
-	if (cemented.size () > max_size)
+	if (cemented.size () > capacity ())
 	{
 		cemented.pop_front ();
 	}
 }
 
+void nano::recently_cemented_cache::capacity_scale (double scale_a)
+{
+	debug_assert (scale_a > 0.0 && scale_a <= 1.0);
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	scale = scale_a;
+	while (cemented.size () > capacity ())
+	{
+		cemented.pop_front ();
+	}
+}
+
+std::size_t nano::recently_cemented_cache::capacity () const
+{
+	return std::max<std::size_t> (1, static_cast<std::size_t> (max_size * scale));
+}
+
 nano::recently_cemented_cache::queue_t nano::recently_cemented_cache::list () const
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
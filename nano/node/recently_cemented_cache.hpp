@@ -26,11 +26,16 @@ public:
 	queue_t list () const;
 	std::size_t size () const;
 
+	/** Limits the cache to a fraction of its maximum size, evicting the oldest entries if needed */
+	void capacity_scale (double);
+
 	nano::container_info container_info () const;
 
 private:
 	queue_t cemented;
 	std::size_t const max_size;
+	double scale{ 1.0 };
+	std::size_t capacity () const;
 
 	mutable nano::mutex mutex;
 };
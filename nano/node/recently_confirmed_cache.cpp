@@ -14,12 +14,28 @@ void nano::recently_confirmed_cache::put (const nano::qualified_root & root, con
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
 	confirmed.get<tag_sequence> ().emplace_back (root, hash);
-	if (confirmed.size () > max_size)
+	if (confirmed.size () > capacity ())
 	{
 		confirmed.get<tag_sequence> ().pop_front ();
 	}
 }
 
+void nano::recently_confirmed_cache::capacity_scale (double scale_a)
+{
+	debug_assert (scale_a > 0.0 && scale_a <= 1.0);
+	nano::lock_guard<nano::mutex> guard{ mutex };
+	scale = scale_a;
+	while (confirmed.size () > capacity ())
+	{
+		confirmed.get<tag_sequence> ().pop_front ();
+	}
+}
+
+std::size_t nano::recently_confirmed_cache::capacity () const
+{
+	return std::max<std::size_t> (1, static_cast<std::size_t> (max_size * scale));
+}
+
 void nano::recently_confirmed_cache::erase (const nano::block_hash & hash)
 {
 	nano::lock_guard<nano::mutex> guard{ mutex };
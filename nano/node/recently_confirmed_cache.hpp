@@ -35,6 +35,9 @@ public:
 	bool exists (nano::qualified_root const &) const;
 	bool exists (nano::block_hash const &) const;
 
+	/** Limits the cache to a fraction of its maximum size, evicting the oldest entries if needed */
+	void capacity_scale (double);
+
 	nano::container_info container_info () const;
 
 public: // Tests
@@ -57,6 +60,8 @@ private:
 	ordered_recent_confirmations confirmed;
 
 	std::size_t const max_size;
+	double scale{ 1.0 };
+	std::size_t capacity () const;
 
 	mutable nano::mutex mutex;
 };
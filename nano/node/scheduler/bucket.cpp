@@ -121,6 +121,25 @@ void nano::scheduler::bucket::update ()
 bool nano::scheduler::bucket::push (uint64_t time, std::shared_ptr<nano::block> block)
 {
 	nano::lock_guard<nano::mutex> lock{ mutex };
+	return insert (time, std::move (block));
+}
+
+std::vector<bool> nano::scheduler::bucket::push (std::vector<push_entry> const & entries)
+{
+	nano::lock_guard<nano::mutex> lock{ mutex };
+
+	std::vector<bool> result;
+	result.reserve (entries.size ());
+	for (auto const & [time, block] : entries)
+	{
+		result.push_back (insert (time, block));
+	}
+	return result;
+}
+
+bool nano::scheduler::bucket::insert (uint64_t time, std::shared_ptr<nano::block> block)
+{
+	debug_assert (!mutex.try_lock ());
 
 	auto [it, inserted] = queue.insert ({ time, block });
 	release_assert (!queue.empty ());
@@ -18,6 +18,8 @@
 #include <deque>
 #include <memory>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -58,6 +60,9 @@ public:
 	void update ();
 
 	bool push (uint64_t time, std::shared_ptr<nano::block> block);
+	using push_entry = std::pair<nano::priority_timestamp, std::shared_ptr<nano::block>>;
+	/** Pushes all entries with a single lock acquisition, returns whether each entry was inserted */
+	std::vector<bool> push (std::vector<push_entry> const &);
 
 	bool contains (nano::block_hash const &) const;
 	size_t size () const;
@@ -68,6 +73,7 @@ public:
 	void dump () const;
 
 private:
+	bool insert (uint64_t time, std::shared_ptr<nano::block> block);
 	bool election_vacancy (nano::priority_timestamp candidate) const;
 	bool election_overfill () const;
 	void cancel_lowest_election ();
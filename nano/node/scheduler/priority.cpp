@@ -26,16 +26,23 @@ nano::scheduler::priority::priority (nano::node_config & node_config, nano::node
 	}
 
 	// Activate accounts with fresh blocks
+	// Bulk ingested chains are activated by the backlog scan once the bulk ingestion settles
 	ledger_notifications.blocks_processed.add ([this] (auto const & batch) {
-		auto transaction = ledger.tx_begin_read ();
+		std::vector<nano::account> accounts;
+		accounts.reserve (batch.size ());
 		for (auto const & [result, context] : batch)
 		{
-			if (result == nano::block_status::progress)
+			if (result == nano::block_status::progress && context.source != nano::block_source::bootstrap_bulk)
 			{
 				release_assert (context.block != nullptr);
-				activate (transaction, context.block->account ());
+				accounts.push_back (context.block->account ());
 			}
 		}
+		if (!accounts.empty ())
+		{
+			auto transaction = ledger.tx_begin_read ();
+			activate (transaction, accounts);
+		}
 	});
 
 	// Activate successors of cemented blocks
@@ -45,12 +52,16 @@ nano::scheduler::priority::priority (nano::node_config & node_config, nano::node
 			return;
 		}
 
-		auto transaction = ledger.tx_begin_read ();
+		std::vector<std::shared_ptr<nano::block>> blocks;
+		blocks.reserve (batch.size ());
 		for (auto const & context : batch)
 		{
 			release_assert (context.block != nullptr);
-			activate_successors (transaction, *context.block);
+			blocks.push_back (context.block);
 		}
+
+		auto transaction = ledger.tx_begin_read ();
+		activate_successors (transaction, blocks);
 	});
 }
 
@@ -111,48 +122,133 @@ bool nano::scheduler::priority::activate (secure::transaction const & transactio
 
 bool nano::scheduler::priority::activate (secure::transaction const & transaction, nano::account const & account, nano::account_info const & account_info, nano::confirmation_height_info const & conf_info)
 {
-	debug_assert (conf_info.frontier != account_info.head);
-
-	auto const hash = conf_info.height == 0 ? account_info.open_block : ledger.any.block_successor (transaction, conf_info.frontier).value_or (0);
-	auto const block = ledger.any.block_get (transaction, hash);
-	if (!block)
+	auto const candidate = prepare (transaction, account, account_info, conf_info);
+	if (!candidate)
 	{
 		return false; // Not activated
 	}
 
-	if (ledger.dependents_confirmed (transaction, *block))
+	bool added = false;
 	{
-		auto const [priority_balance, priority_timestamp] = ledger.block_priority (transaction, *block);
-		auto const bucket_index = bucketing.bucket_index (priority_balance);
+		auto const & bucket = buckets.at (candidate->bucket_index);
+		release_assert (bucket);
+		added = bucket->push (candidate->priority_timestamp, candidate->block);
+	}
+	pushed (*candidate, added);
+	if (added)
+	{
+		notify ();
+	}
+	return true; // Activated
+}
+
+std::size_t nano::scheduler::priority::activate (secure::transaction const & transaction, std::span<nano::account const> accounts)
+{
+	// Sorted lookups keep consecutive reads close together in the ledger tables
+	std::vector<nano::account> sorted{ accounts.begin (), accounts.end () };
+	std::sort (sorted.begin (), sorted.end ());
+	sorted.erase (std::unique (sorted.begin (), sorted.end ()), sorted.end ());
+
+	std::vector<account_state> states;
+	states.reserve (sorted.size ());
+	for (auto const & account : sorted)
+	{
+		debug_assert (!account.is_zero ());
+		if (auto info = ledger.any.account_get (transaction, account))
+		{
+			nano::confirmation_height_info conf_info;
+			ledger.store.confirmation_height.get (transaction, account, conf_info);
+			if (conf_info.height < info->block_count)
+			{
+				states.push_back ({ account, *info, conf_info });
+				continue;
+			}
+		}
+		stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::activate_skip);
+	}
+	return activate (transaction, states);
+}
 
-		bool added = false;
+std::size_t nano::scheduler::priority::activate (secure::transaction const & transaction, std::span<account_state const> states)
+{
+	// Group candidates by bucket, so each bucket is locked once for the whole batch
+	std::map<nano::bucket_index, std::vector<candidate>> grouped;
+	for (auto const & state : states)
+	{
+		if (auto candidate = prepare (transaction, state.account, state.account_info, state.conf_info))
 		{
-			auto const & bucket = buckets.at (bucket_index);
-			release_assert (bucket);
-			added = bucket->push (priority_timestamp, block);
+			grouped[candidate->bucket_index].push_back (std::move (*candidate));
 		}
-		if (added)
+	}
+
+	std::size_t activated = 0;
+	bool any_added = false;
+	for (auto const & [index, candidates] : grouped)
+	{
+		std::vector<scheduler::bucket::push_entry> entries;
+		entries.reserve (candidates.size ());
+		for (auto const & candidate : candidates)
 		{
-			stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::activated);
-			logger.trace (nano::log::type::election_scheduler, nano::log::detail::block_activated,
-			nano::log::arg{ "account", account },
-			nano::log::arg{ "block", block },
-			nano::log::arg{ "time", account_info.modified },
-			nano::log::arg{ "priority_balance", priority_balance },
-			nano::log::arg{ "priority_timestamp", priority_timestamp });
-
-			notify ();
+			entries.emplace_back (candidate.priority_timestamp, candidate.block);
 		}
-		else
+
+		auto const & bucket = buckets.at (index);
+		release_assert (bucket);
+		auto const added = bucket->push (entries);
+		release_assert (added.size () == candidates.size ());
+
+		for (std::size_t i = 0; i < candidates.size (); ++i)
 		{
-			stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::activate_full);
+			pushed (candidates[i], added[i]);
+			any_added |= added[i];
 		}
+		activated += candidates.size ();
+	}
+	if (any_added)
+	{
+		notify ();
+	}
+	return activated;
+}
+
+std::optional<nano::scheduler::priority::candidate> nano::scheduler::priority::prepare (secure::transaction const & transaction, nano::account const & account, nano::account_info const & account_info, nano::confirmation_height_info const & conf_info)
+{
+	debug_assert (conf_info.frontier != account_info.head);
 
-		return true; // Activated
+	auto const hash = conf_info.height == 0 ? account_info.open_block : ledger.any.block_successor (transaction, conf_info.frontier).value_or (0);
+	auto block = ledger.any.block_get (transaction, hash);
+	if (!block)
+	{
+		return std::nullopt;
+	}
+
+	if (ledger.dependents_confirmed (transaction, *block))
+	{
+		auto const [priority_balance, priority_timestamp] = ledger.block_priority (transaction, *block);
+		auto const bucket_index = bucketing.bucket_index (priority_balance);
+		return candidate{ account, std::move (block), priority_balance, priority_timestamp, bucket_index, account_info.modified };
 	}
 
 	stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::activate_failed);
-	return false; // Not activated
+	return std::nullopt;
+}
+
+void nano::scheduler::priority::pushed (candidate const & candidate, bool added)
+{
+	if (added)
+	{
+		stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::activated);
+		logger.trace (nano::log::type::election_scheduler, nano::log::detail::block_activated,
+		nano::log::arg{ "account", candidate.account },
+		nano::log::arg{ "block", candidate.block },
+		nano::log::arg{ "time", candidate.modified },
+		nano::log::arg{ "priority_balance", candidate.priority_balance },
+		nano::log::arg{ "priority_timestamp", candidate.priority_timestamp });
+	}
+	else
+	{
+		stats.inc (nano::stat::type::election_scheduler, nano::stat::detail::activate_full);
+	}
 }
 
 bool nano::scheduler::priority::activate_successors (secure::transaction const & transaction, nano::block const & block)
@@ -166,6 +262,22 @@ bool nano::scheduler::priority::activate_successors (secure::transaction const &
 	return result;
 }
 
+std::size_t nano::scheduler::priority::activate_successors (secure::transaction const & transaction, std::span<std::shared_ptr<nano::block> const> blocks)
+{
+	std::vector<nano::account> accounts;
+	accounts.reserve (blocks.size () * 2);
+	for (auto const & block : blocks)
+	{
+		accounts.push_back (block->account ());
+		// Start or vote for the next unconfirmed block in the destination account
+		if (block->is_send () && !block->destination ().is_zero () && block->destination () != block->account ())
+		{
+			accounts.push_back (block->destination ());
+		}
+	}
+	return activate (transaction, accounts);
+}
+
 bool nano::scheduler::priority::contains (nano::block_hash const & hash) const
 {
 	return std::any_of (buckets.begin (), buckets.end (), [&hash] (auto const & bucket) {
@@ -3,11 +3,15 @@
 #include <nano/lib/numbers.hpp>
 #include <nano/node/fwd.hpp>
 #include <nano/node/scheduler/bucket.hpp>
+#include <nano/secure/account_info.hpp>
+#include <nano/secure/common.hpp>
 
 #include <condition_variable>
 #include <deque>
 #include <map>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <thread>
 
@@ -33,13 +37,30 @@ public:
 	void start ();
 	void stop ();
 
+	/** Account with its ledger state already read, as provided by the backlog scan */
+	struct account_state
+	{
+		nano::account account;
+		nano::account_info account_info;
+		nano::confirmation_height_info conf_info;
+	};
+
 	/**
 	 * Activates the first unconfirmed block of \p account_a
 	 * @return true if account was activated
 	 */
 	bool activate (nano::secure::transaction const &, nano::account const &);
 	bool activate (nano::secure::transaction const &, nano::account const &, nano::account_info const &, nano::confirmation_height_info const &);
+	/**
+	 * Activates the first unconfirmed block of each account
+	 * Accounts are looked up in sorted order within the same transaction and blocks are pushed with one lock acquisition per bucket
+	 * @return number of accounts activated
+	 */
+	std::size_t activate (nano::secure::transaction const &, std::span<nano::account const>);
+	std::size_t activate (nano::secure::transaction const &, std::span<account_state const>);
 	bool activate_successors (nano::secure::transaction const &, nano::block const &);
+	/** Activates the account and send destination of each block */
+	std::size_t activate_successors (nano::secure::transaction const &, std::span<std::shared_ptr<nano::block> const>);
 
 	bool contains (nano::block_hash const &) const;
 	void notify ();
@@ -60,9 +81,22 @@ private: // Dependencies
 	nano::logger & logger;
 
 private:
+	struct candidate
+	{
+		nano::account account;
+		std::shared_ptr<nano::block> block;
+		nano::amount priority_balance;
+		nano::priority_timestamp priority_timestamp;
+		nano::bucket_index bucket_index;
+		nano::seconds_t modified;
+	};
+
 	void run ();
 	void run_cleanup ();
 	bool predicate () const;
+	/** Finds the block to activate and its bucket, nullopt if the account cannot be activated */
+	std::optional<candidate> prepare (nano::secure::transaction const &, nano::account const &, nano::account_info const &, nano::confirmation_height_info const &);
+	void pushed (candidate const &, bool added);
 
 private:
 	std::map<nano::bucket_index, std::unique_ptr<scheduler::bucket>> buckets;
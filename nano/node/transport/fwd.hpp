@@ -3,6 +3,7 @@
 namespace nano::transport
 {
 class channel;
+class io_shards;
 class tcp_channel;
 class tcp_channels;
 class tcp_server;
@@ -0,0 +1,51 @@
+#include <nano/node/transport/io_shards.hpp>
+
+/*
+ * io_shards
+ */
+
+nano::transport::io_shards::io_shards (asio::io_context & node_io_ctx_a, unsigned count, nano::logger & logger) :
+	node_io_ctx{ node_io_ctx_a }
+{
+	for (unsigned i = 0; i < count; ++i)
+	{
+		// Each shard is only run by its own thread, the concurrency hint lets the scheduler skip waking up other threads
+		auto & io_ctx = contexts.emplace_back (std::make_shared<asio::io_context> (1));
+		runners.emplace_back (std::make_unique<nano::thread_runner> (io_ctx, logger, 1, nano::thread_role::name::io_shard));
+	}
+}
+
+nano::transport::io_shards::~io_shards ()
+{
+	join ();
+}
+
+boost::asio::io_context & nano::transport::io_shards::next ()
+{
+	if (contexts.empty ())
+	{
+		return node_io_ctx;
+	}
+	return *contexts[counter.fetch_add (1, std::memory_order_relaxed) % contexts.size ()];
+}
+
+size_t nano::transport::io_shards::size () const
+{
+	return contexts.size ();
+}
+
+void nano::transport::io_shards::abort ()
+{
+	for (auto & runner : runners)
+	{
+		runner->abort ();
+	}
+}
+
+void nano::transport::io_shards::join ()
+{
+	for (auto & runner : runners)
+	{
+		runner->join ();
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <nano/boost/asio/io_context.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/lib/thread_runner.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace nano::transport
+{
+/**
+ * Set of io_contexts each run by a single thread, peer sockets are assigned to them round robin when accepted or connected.
+ * All handlers of a socket and its channel run on the shard the socket is bound to, so with many connections dispatch no longer
+ * contends on the scheduler of the single node io_context. With no shards configured sockets stay on the node io_context.
+ */
+class io_shards final
+{
+public:
+	io_shards (asio::io_context & node_io_ctx, unsigned count, nano::logger &);
+	~io_shards ();
+
+	/** io_context to bind the next socket to */
+	asio::io_context & next ();
+	/** Number of shards, zero if sockets use the node io_context */
+	size_t size () const;
+
+	void abort ();
+	void join ();
+
+private:
+	asio::io_context & node_io_ctx;
+	std::vector<std::shared_ptr<asio::io_context>> contexts;
+	std::vector<std::unique_ptr<nano::thread_runner>> runners;
+	std::atomic<size_t> counter{ 0 };
+};
+}
@@ -13,7 +13,7 @@
 nano::transport::tcp_channel::tcp_channel (nano::node & node_a, std::shared_ptr<nano::transport::tcp_socket> socket_a) :
 	channel (node_a),
 	socket{ socket_a },
-	strand{ node_a.io_ctx.get_executor () },
+	strand{ socket_a->executor () },
 	sending_task{ strand }
 {
 	remote_endpoint = socket_a->remote_endpoint ();
@@ -60,10 +60,10 @@ void nano::transport::tcp_channel::stop ()
 {
 	if (sending_task.joinable ())
 	{
-		// Node context must be running to gracefully stop async tasks
-		debug_assert (!node.io_ctx.stopped ());
+		// Socket context must be running to gracefully stop async tasks
+		debug_assert (!strand.get_inner_executor ().context ().stopped ());
 		// Ensure that we are not trying to await the task while running on the same thread / io_context
-		debug_assert (!node.io_ctx.get_executor ().running_in_this_thread ());
+		debug_assert (!strand.get_inner_executor ().running_in_this_thread ());
 		sending_task.cancel ();
 		sending_task.join ();
 	}
@@ -2,6 +2,7 @@
 #include <nano/lib/interval.hpp>
 #include <nano/node/messages.hpp>
 #include <nano/node/node.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_listener.hpp>
 #include <nano/node/transport/tcp_server.hpp>
 
@@ -344,14 +345,15 @@ asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::accept_soc
 {
 	debug_assert (strand.running_in_this_thread ());
 
-	co_return co_await acceptor.async_accept (asio::use_awaitable);
+	// Accepted sockets are bound to a shard right away, only the acceptor itself runs on the node io_context
+	co_return co_await acceptor.async_accept (node.io_shards.next (), asio::use_awaitable);
 }
 
 asio::awaitable<asio::ip::tcp::socket> nano::transport::tcp_listener::connect_socket (asio::ip::tcp::endpoint endpoint)
 {
 	debug_assert (strand.running_in_this_thread ());
 
-	asio::ip::tcp::socket raw_socket{ strand };
+	asio::ip::tcp::socket raw_socket{ node.io_shards.next () };
 	co_await raw_socket.async_connect (endpoint, asio::use_awaitable);
 
 	co_return raw_socket;
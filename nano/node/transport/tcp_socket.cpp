@@ -2,6 +2,7 @@
 #include <nano/boost/asio/read.hpp>
 #include <nano/lib/enum_util.hpp>
 #include <nano/node/node.hpp>
+#include <nano/node/transport/io_shards.hpp>
 #include <nano/node/transport/tcp_socket.hpp>
 #include <nano/node/transport/transport.hpp>
 
@@ -12,12 +13,23 @@
 #include <memory>
 #include <utility>
 
+namespace
+{
+/** Handlers of a socket run on the io_context its raw socket was opened on, which is an io_shards shard when sharding is enabled */
+boost::asio::io_context::executor_type io_context_executor (boost::asio::ip::tcp::socket & raw_socket)
+{
+	auto const * executor = raw_socket.get_executor ().target<boost::asio::io_context::executor_type> ();
+	release_assert (executor != nullptr, "tcp_socket requires a raw socket opened on an io_context");
+	return *executor;
+}
+}
+
 /*
  * socket
  */
 
 nano::transport::tcp_socket::tcp_socket (nano::node & node_a, nano::transport::socket_endpoint endpoint_type_a, size_t queue_size_a) :
-	tcp_socket{ node_a, boost::asio::ip::tcp::socket{ node_a.io_ctx }, {}, {}, endpoint_type_a, queue_size_a }
+	tcp_socket{ node_a, boost::asio::ip::tcp::socket{ node_a.io_shards.next () }, {}, {}, endpoint_type_a, queue_size_a }
 {
 }
 
@@ -25,7 +37,7 @@ nano::transport::tcp_socket::tcp_socket (nano::node & node_a, boost::asio::ip::t
 	queue_size{ queue_size_a },
 	send_queue{ queue_size },
 	node_w{ node_a.shared () },
-	strand{ node_a.io_ctx.get_executor () },
+	strand{ io_context_executor (raw_socket_a) },
 	raw_socket{ std::move (raw_socket_a) },
 	remote{ remote_endpoint_a },
 	local{ local_endpoint_a },
@@ -101,6 +101,11 @@ public:
 
 	boost::asio::ip::tcp::endpoint remote_endpoint () const;
 	boost::asio::ip::tcp::endpoint local_endpoint () const;
+	/** Executor of the io_context the socket is bound to, components serving the socket should run on the same io_context */
+	boost::asio::io_context::executor_type executor () const
+	{
+		return strand.get_inner_executor ();
+	}
 
 	/** Returns true if the socket has timed out */
 	bool has_timed_out () const;
@@ -6,11 +6,19 @@
 #include <nano/lib/timer.hpp>
 #include <nano/node/unchecked_map.hpp>
 
+#include <algorithm>
+#include <bit>
+
 nano::unchecked_map::unchecked_map (unsigned const max_unchecked_blocks, nano::stats & stats, bool const & disable_delete) :
 	max_unchecked_blocks{ max_unchecked_blocks },
 	stats{ stats },
 	disable_delete{ disable_delete }
 {
+	auto const count = std::bit_floor (std::clamp<size_t> (max_unchecked_blocks / shard_min_size, 1, shards_max));
+	for (size_t i = 0; i < count; ++i)
+	{
+		shards.push_back (std::make_unique<shard> ());
+	}
 }
 
 nano::unchecked_map::~unchecked_map ()
@@ -44,13 +52,17 @@ void nano::unchecked_map::stop ()
 
 void nano::unchecked_map::put (nano::hash_or_account const & dependency, nano::unchecked_info const & info)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
 	nano::unchecked_key key{ dependency, info.block->hash () };
-	entries.get<tag_root> ().insert ({ key, info });
-
-	if (entries.size () > max_unchecked_blocks)
+	auto & shard = shard_for (key.key ());
 	{
-		entries.get<tag_sequenced> ().pop_front ();
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		auto [begin, end] = shard.entries.get<tag_dependency> ().equal_range (key.key ());
+		bool const exists = std::any_of (begin, end, [&key] (entry const & item) { return item.key == key; });
+		if (!exists)
+		{
+			shard.entries.push_back ({ key, info });
+			trim (shard);
+		}
 	}
 
 	stats.inc (nano::stat::type::unchecked, nano::stat::detail::put);
@@ -58,19 +70,42 @@ void nano::unchecked_map::put (nano::hash_or_account const & dependency, nano::u
 
 void nano::unchecked_map::for_each (std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	for (auto i = entries.begin (), n = entries.end (); predicate () && i != n; ++i)
+	for (auto const & shard : shards)
 	{
-		action (i->key, i->info);
+		// Copy entries so the action runs without holding the lock
+		std::vector<entry> entries_l;
+		{
+			nano::lock_guard<nano::mutex> lock{ shard->mutex };
+			entries_l.assign (shard->entries.begin (), shard->entries.end ());
+		}
+		for (auto const & item : entries_l)
+		{
+			if (!predicate ())
+			{
+				return;
+			}
+			action (item.key, item.info);
+		}
 	}
 }
 
 void nano::unchecked_map::for_each (nano::hash_or_account const & dependency, std::function<void (nano::unchecked_key const &, nano::unchecked_info const &)> action, std::function<bool ()> predicate)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	for (auto i = entries.template get<tag_root> ().lower_bound (nano::unchecked_key{ dependency, 0 }), n = entries.template get<tag_root> ().end (); predicate () && i != n && i->key.key () == dependency.as_block_hash (); ++i)
+	auto const & hash = dependency.as_block_hash ();
+	auto & shard = shard_for (hash);
+	std::vector<entry> entries_l;
 	{
-		action (i->key, i->info);
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		auto [begin, end] = shard.entries.get<tag_dependency> ().equal_range (hash);
+		entries_l.assign (begin, end);
+	}
+	for (auto const & item : entries_l)
+	{
+		if (!predicate ())
+		{
+			return;
+		}
+		action (item.key, item.info);
 	}
 }
 
@@ -85,27 +120,44 @@ std::vector<nano::unchecked_info> nano::unchecked_map::get (nano::block_hash con
 
 bool nano::unchecked_map::exists (nano::unchecked_key const & key) const
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	return entries.get<tag_root> ().count (key) != 0;
+	auto & shard = shard_for (key.key ());
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	auto [begin, end] = shard.entries.get<tag_dependency> ().equal_range (key.key ());
+	return std::any_of (begin, end, [&key] (entry const & item) { return item.key == key; });
 }
 
 void nano::unchecked_map::del (nano::unchecked_key const & key)
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	auto erased = entries.get<tag_root> ().erase (key);
-	debug_assert (erased);
+	auto & shard = shard_for (key.key ());
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
+	auto & entries_by_dependency = shard.entries.get<tag_dependency> ();
+	auto [begin, end] = entries_by_dependency.equal_range (key.key ());
+	auto existing = std::find_if (begin, end, [&key] (entry const & item) { return item.key == key; });
+	debug_assert (existing != end);
+	if (existing != end)
+	{
+		entries_by_dependency.erase (existing);
+	}
 }
 
 void nano::unchecked_map::clear ()
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	entries.clear ();
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		shard->entries.clear ();
+	}
 }
 
 size_t nano::unchecked_map::entries_size () const
 {
-	nano::lock_guard<std::recursive_mutex> lock{ entries_mutex };
-	return entries.size ();
+	size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		result += shard->entries.size ();
+	}
+	return result;
 }
 
 size_t nano::unchecked_map::queries_size () const
@@ -128,6 +180,19 @@ void nano::unchecked_map::trigger (nano::hash_or_account const & dependency)
 	condition.notify_all (); // Notify run ()
 }
 
+void nano::unchecked_map::trigger (std::vector<nano::hash_or_account> const & dependencies)
+{
+	if (dependencies.empty ())
+	{
+		return;
+	}
+	nano::unique_lock<nano::mutex> lock{ mutex };
+	buffer.insert (buffer.end (), dependencies.begin (), dependencies.end ());
+	lock.unlock ();
+	stats.add (nano::stat::type::unchecked, nano::stat::detail::trigger, dependencies.size ());
+	condition.notify_all (); // Notify run ()
+}
+
 void nano::unchecked_map::process_queries (decltype (buffer) const & back_buffer)
 {
 	for (auto const & item : back_buffer)
@@ -162,25 +227,66 @@ void nano::unchecked_map::run ()
 
 void nano::unchecked_map::query_impl (nano::block_hash const & hash)
 {
-	std::deque<nano::unchecked_key> delete_queue;
-	for_each (hash, [this, &delete_queue] (nano::unchecked_key const & key, nano::unchecked_info const & info) {
-		delete_queue.push_back (key);
-		stats.inc (nano::stat::type::unchecked, nano::stat::detail::satisfied);
-		satisfied.notify (info);
-	});
-	if (!disable_delete)
+	// Satisfied entries are taken out in a single pass over the shard
+	std::vector<nano::unchecked_info> satisfied_l;
 	{
-		for (auto const & key : delete_queue)
+		auto & shard = shard_for (hash);
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		auto & entries_by_dependency = shard.entries.get<tag_dependency> ();
+		auto [begin, end] = entries_by_dependency.equal_range (hash);
+		for (auto i = begin; i != end; ++i)
+		{
+			satisfied_l.push_back (i->info);
+		}
+		if (!disable_delete)
 		{
-			del (key);
+			entries_by_dependency.erase (begin, end);
 		}
 	}
+	for (auto const & info : satisfied_l)
+	{
+		stats.inc (nano::stat::type::unchecked, nano::stat::detail::satisfied);
+		satisfied.notify (info);
+	}
+}
+
+auto nano::unchecked_map::shard_for (nano::block_hash const & dependency) const -> shard &
+{
+	// Shard count is a power of two
+	return *shards[dependency.qwords[0] & (shards.size () - 1)];
+}
+
+void nano::unchecked_map::trim (shard & shard)
+{
+	debug_assert (!shard.mutex.try_lock ());
+	auto const capacity = shard_capacity ();
+	while (shard.entries.size () > capacity)
+	{
+		shard.entries.get<tag_sequenced> ().pop_front ();
+	}
+}
+
+void nano::unchecked_map::capacity_scale (double scale_a)
+{
+	debug_assert (scale_a > 0.0 && scale_a <= 1.0);
+	scale = scale_a;
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		trim (*shard);
+	}
+}
+
+size_t nano::unchecked_map::shard_capacity () const
+{
+	auto const capacity = std::max<size_t> (1, static_cast<size_t> (max_unchecked_blocks * scale.load ()));
+	return (capacity + shards.size () - 1) / shards.size ();
 }
 
 nano::container_info nano::unchecked_map::container_info () const
 {
 	nano::container_info info;
-	info.put ("entries", entries_size ());
+	info.put ("entries", entries_size (), sizeof (entry));
 	info.put ("queries", queries_size ());
 	return info;
 }
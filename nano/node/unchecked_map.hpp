@@ -2,16 +2,18 @@
 
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/numbers_templ.hpp>
 #include <nano/lib/observer_set.hpp>
 #include <nano/secure/common.hpp>
 
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index/random_access_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <atomic>
+#include <memory>
 #include <thread>
+#include <vector>
 
 namespace mi = boost::multi_index;
 
@@ -19,6 +21,10 @@ namespace nano
 {
 class stats;
 
+/**
+ * Blocks waiting for a missing dependency, looked up by the hash of that dependency.
+ * Entries are sharded by dependency hash and each shard evicts its oldest entries once full. Callbacks are never invoked while holding a shard lock.
+ */
 class unchecked_map
 {
 public:
@@ -42,11 +48,20 @@ public:
 	 * Trigger requested dependencies
 	 */
 	void trigger (nano::hash_or_account const & dependency);
+	/**
+	 * Trigger all dependencies satisfied by a batch of processed blocks at once
+	 */
+	void trigger (std::vector<nano::hash_or_account> const & dependencies);
 
 	size_t count () const; // Same as `entries_size ()`
 	size_t entries_size () const;
 	size_t queries_size () const;
 
+	/**
+	 * Limits the number of entries to a fraction of the configured maximum, evicting the oldest entries if needed
+	 */
+	void capacity_scale (double);
+
 	nano::container_info container_info () const;
 
 public: // Events
@@ -71,9 +86,15 @@ private:
 	std::thread thread;
 
 	unsigned const max_unchecked_blocks;
+	std::atomic<double> scale{ 1.0 };
 
 	void process_queries (decltype (buffer) const & back_buffer);
 
+public: // Constants
+	/** Smallest number of entries per shard, small maps use fewer shards to keep eviction order close to exact */
+	static size_t constexpr shard_min_size{ 1024 * 4 };
+	static size_t constexpr shards_max{ 16 };
+
 private:
 	struct entry
 	{
@@ -81,18 +102,34 @@ private:
 		nano::unchecked_info info;
 	};
 
+	struct dependency_extractor
+	{
+		using result_type = nano::block_hash;
+		result_type const & operator() (entry const & entry_a) const
+		{
+			return entry_a.key.key ();
+		}
+	};
+
 	// clang-format off
 	class tag_sequenced {};
-	class tag_root {};
+	class tag_dependency {};
 
 	using ordered_unchecked = boost::multi_index_container<entry,
 		mi::indexed_by<
 			mi::sequenced<mi::tag<tag_sequenced>>,
-			mi::ordered_unique<mi::tag<tag_root>,
-				mi::member<entry, nano::unchecked_key, &entry::key>>>>;
+			mi::hashed_non_unique<mi::tag<tag_dependency>, dependency_extractor>>>;
 	// clang-format on
-	ordered_unchecked entries;
 
-	mutable std::recursive_mutex entries_mutex; // Protects entries
+	struct shard
+	{
+		ordered_unchecked entries;
+		mutable nano::mutex mutex;
+	};
+	std::vector<std::unique_ptr<shard>> shards;
+
+	shard & shard_for (nano::block_hash const & dependency) const;
+	size_t shard_capacity () const;
+	void trim (shard &);
 };
 }
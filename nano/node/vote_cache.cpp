@@ -6,6 +6,10 @@
 #include <nano/node/vote_router.hpp>
 #include <nano/secure/vote.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <deque>
+#include <limits>
 #include <ranges>
 
 /*
@@ -19,7 +23,7 @@ nano::vote_cache_entry::vote_cache_entry (const nano::block_hash & hash) :
 
 bool nano::vote_cache_entry::vote (std::shared_ptr<nano::vote> const & vote, const nano::uint128_t & rep_weight, std::size_t max_voters)
 {
-	bool updated = vote_impl (vote, rep_weight, max_voters);
+	bool updated = vote_impl (vote, nano::uint128_fast_t{ rep_weight }, max_voters);
 	if (updated)
 	{
 		auto [tally, final_tally] = calculate_tally ();
@@ -30,22 +34,21 @@ bool nano::vote_cache_entry::vote (std::shared_ptr<nano::vote> const & vote, con
 	return updated;
 }
 
-bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote, const nano::uint128_t & rep_weight, std::size_t max_voters)
+bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote, nano::uint128_fast_t const & rep_weight, std::size_t max_voters)
 {
 	auto const representative = vote->account;
 
-	if (auto existing = voters.find (representative); existing != voters.end ())
+	if (auto index = find (representative); index < voters.size ())
 	{
+		auto & existing = voters[index];
 		// We already have a vote from this rep
 		// Update timestamp if newer but tally remains unchanged as we already counted this rep weight
 		// It is not essential to keep tally up to date if rep voting weight changes, elections do tally calculations independently, so in the worst case scenario only our queue ordering will be a bit off
-		if (vote->timestamp () > existing->vote->timestamp ())
+		if (vote->timestamp () > existing.vote->timestamp ())
 		{
-			bool was_final = existing->vote->is_final ();
-			voters.modify (existing, [&vote, &rep_weight] (auto & existing) {
-				existing.vote = vote;
-				existing.weight = rep_weight;
-			});
+			bool was_final = existing.vote->is_final ();
+			existing.vote = vote;
+			existing.weight = rep_weight;
 			return !was_final && vote->is_final (); // Tally changed only if the vote became final
 		}
 	}
@@ -59,7 +62,7 @@ bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote
 			else
 			{
 				release_assert (!voters.empty ());
-				auto const & min_weight = voters.get<tag_weight> ().begin ()->weight;
+				auto const min_weight = std::min_element (voters.begin (), voters.end (), [] (auto const & a, auto const & b) { return a.weight < b.weight; })->weight;
 				return rep_weight > min_weight;
 			}
 		};
@@ -67,13 +70,14 @@ bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote
 		// Vote from a new representative, add it to the list and update tally
 		if (should_add ())
 		{
-			voters.insert ({ representative, rep_weight, vote });
+			representatives.push_back (representative);
+			voters.push_back ({ rep_weight, vote });
 
 			// If we have reached the maximum number of voters, remove the lowest weight voter
 			if (voters.size () >= max_voters)
 			{
 				release_assert (!voters.empty ());
-				voters.get<tag_weight> ().erase (voters.get<tag_weight> ().begin ());
+				erase_lowest_weight ();
 			}
 
 			return true;
@@ -82,18 +86,42 @@ bool nano::vote_cache_entry::vote_impl (std::shared_ptr<nano::vote> const & vote
 	return false; // Tally unchanged
 }
 
+std::size_t nano::vote_cache_entry::find (nano::account const & representative) const
+{
+	debug_assert (representatives.size () == voters.size ());
+	// Branchless comparison of whole accounts, which the compiler can vectorize
+	auto const & key = representative.qwords;
+	for (std::size_t i = 0, n = representatives.size (); i < n; ++i)
+	{
+		auto const & current = representatives[i].qwords;
+		if (((current[0] ^ key[0]) | (current[1] ^ key[1]) | (current[2] ^ key[2]) | (current[3] ^ key[3])) == 0)
+		{
+			return i;
+		}
+	}
+	return representatives.size ();
+}
+
+void nano::vote_cache_entry::erase_lowest_weight ()
+{
+	// The first of equally weighted voters is the oldest one, as the order of insertion is preserved
+	auto const lowest = std::min_element (voters.begin (), voters.end (), [] (auto const & a, auto const & b) { return a.weight < b.weight; }) - voters.begin ();
+	representatives.erase (representatives.begin () + lowest);
+	voters.erase (voters.begin () + lowest);
+}
+
 std::size_t nano::vote_cache_entry::size () const
 {
 	return voters.size ();
 }
 
-auto nano::vote_cache_entry::calculate_tally () const -> std::pair<nano::uint128_t, nano::uint128_t>
+auto nano::vote_cache_entry::calculate_tally () const -> std::pair<nano::uint128_fast_t, nano::uint128_fast_t>
 {
-	nano::uint128_t tally{ 0 }, final_tally{ 0 };
+	nano::uint128_fast_t tally{ 0 }, final_tally{ 0 };
 	for (auto const & voter : voters)
 	{
 		tally += voter.weight;
-		final_tally += voter.vote->is_final () ? voter.weight : 0;
+		final_tally += voter.vote->is_final () ? voter.weight : nano::uint128_fast_t{ 0 };
 	}
 	return { tally, final_tally };
 }
@@ -108,10 +136,31 @@ std::vector<std::shared_ptr<nano::vote>> nano::vote_cache_entry::votes () const
  * vote_cache
  */
 
+namespace
+{
+/** Upper 64 bits of the tally plus one, so a floor of zero means every entry is ranked */
+uint64_t rank_floor_of (nano::uint128_t const & tally)
+{
+	auto const high = static_cast<uint64_t> (tally >> 64);
+	return high == std::numeric_limits<uint64_t>::max () ? high : high + 1;
+}
+}
+
 nano::vote_cache::vote_cache (vote_cache_config const & config_a, nano::stats & stats_a) :
 	config{ config_a },
 	stats{ stats_a }
 {
+	auto const count = std::bit_floor (std::clamp<std::size_t> (config.max_size / shard_min_size, 1, shards_max));
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		shards.push_back (std::make_unique<shard> ());
+	}
+}
+
+auto nano::vote_cache::shard_for (nano::block_hash const & hash) const -> shard &
+{
+	// Shard count is a power of two
+	return *shards[hash.qwords[0] & (shards.size () - 1)];
 }
 
 void nano::vote_cache::insert (std::shared_ptr<nano::vote> const & vote, std::unordered_map<nano::block_hash, nano::vote_code> const & results)
@@ -122,19 +171,23 @@ void nano::vote_cache::insert (std::shared_ptr<nano::vote> const & vote, std::un
 	auto const representative = vote->account;
 	auto const rep_weight = rep_weight_query (representative);
 
-	nano::lock_guard<nano::mutex> lock{ mutex };
-
 	// Cache votes with a corresponding active election (indicated by `vote_code::vote`) in case that election gets dropped
 	auto filter = [] (auto code) {
 		return code == nano::vote_code::vote || code == nano::vote_code::indeterminate;
 	};
 
+	auto insert_hash = [this, &vote, &rep_weight] (nano::block_hash const & hash) {
+		auto & shard = shard_for (hash);
+		nano::lock_guard<nano::mutex> lock{ shard.mutex };
+		insert_impl (shard, vote, hash, rep_weight);
+	};
+
 	// If results map is empty, insert all hashes (meant for testing)
 	if (results.empty ())
 	{
 		for (auto const & hash : vote->hashes)
 		{
-			insert_impl (vote, hash, rep_weight);
+			insert_hash (hash);
 		}
 	}
 	else
@@ -143,23 +196,26 @@ void nano::vote_cache::insert (std::shared_ptr<nano::vote> const & vote, std::un
 		{
 			if (filter (code))
 			{
-				insert_impl (vote, hash, rep_weight);
+				insert_hash (hash);
 			}
 		}
 	}
 }
 
-void nano::vote_cache::insert_impl (std::shared_ptr<nano::vote> const & vote, nano::block_hash const & hash, nano::uint128_t const & rep_weight)
+void nano::vote_cache::insert_impl (shard & shard, std::shared_ptr<nano::vote> const & vote, nano::block_hash const & hash, nano::uint128_t const & rep_weight)
 {
-	debug_assert (!mutex.try_lock ());
+	debug_assert (!shard.mutex.try_lock ());
 	debug_assert (std::any_of (vote->hashes.begin (), vote->hashes.end (), [&hash] (auto const & vote_hash) { return vote_hash == hash; }));
 
-	if (auto existing = cache.find (hash); existing != cache.end ())
+	if (auto existing = shard.cache.find (hash); existing != shard.cache.end ())
 	{
 		stats.inc (nano::stat::type::vote_cache, nano::stat::detail::update);
 
-		cache.modify (existing, [this, &vote, &rep_weight] (entry & ent) {
-			ent.vote (vote, rep_weight, config.max_voters);
+		shard.cache.modify (existing, [this, &vote, &rep_weight] (entry & ent) {
+			if (ent.vote (vote, rep_weight, config.max_voters))
+			{
+				rank (ent);
+			}
 		});
 	}
 	else
@@ -168,33 +224,107 @@ void nano::vote_cache::insert_impl (std::shared_ptr<nano::vote> const & vote, na
 
 		entry cache_entry{ hash };
 		cache_entry.vote (vote, rep_weight, config.max_voters);
-		cache.insert (cache_entry);
+		rank (cache_entry);
+		shard.cache.insert (std::move (cache_entry));
 
-		// Remove the oldest entry if we have reached the capacity limit
-		if (cache.size () > config.max_size)
-		{
-			cache.get<tag_sequenced> ().pop_front ();
-		}
+		// Remove the oldest entries if we have reached the capacity limit
+		trim (shard);
+	}
+}
+
+void nano::vote_cache::trim (shard & shard)
+{
+	debug_assert (!shard.mutex.try_lock ());
+
+	auto const capacity = shard_capacity ();
+	auto & cache_by_sequence = shard.cache.get<tag_sequenced> ();
+	while (shard.cache.size () > capacity)
+	{
+		unrank (cache_by_sequence.front ());
+		cache_by_sequence.pop_front ();
+	}
+}
+
+void nano::vote_cache::rank (entry & ent)
+{
+	// Entries that may already be ranked must be updated even if their tally decreased
+	if (!ent.ranked && ent.tally_m.high () < rank_threshold.load (std::memory_order_relaxed))
+	{
+		raise_rank_floor (ent.tally ());
+		return;
+	}
+
+	nano::lock_guard<nano::mutex> guard{ ranking_mutex };
+
+	auto & ranking_by_hash = ranking.get<tag_hash> ();
+	if (auto existing = ranking_by_hash.find (ent.hash ()); existing != ranking_by_hash.end ())
+	{
+		ranking_by_hash.modify (existing, [&ent] (ranked_entry & ranked) {
+			ranked.tally = ent.tally ();
+			ranked.final_tally = ent.final_tally ();
+		});
+	}
+	else
+	{
+		ranking.insert ({ ent.hash (), ent.tally (), ent.final_tally () });
+	}
+	ent.ranked = true;
+
+	auto & ranking_by_tally = ranking.get<tag_tally> ();
+	if (ranking.size () > top_max)
+	{
+		// The dropped entry keeps its ranked flag, erasing it from the ranking later is a no-op
+		auto lowest = std::prev (ranking_by_tally.end ());
+		raise_rank_floor (lowest->tally);
+		ranking_by_tally.erase (lowest);
+	}
+	rank_threshold = ranking.size () >= top_max ? static_cast<uint64_t> (ranking_by_tally.rbegin ()->tally >> 64) : 0;
+}
+
+void nano::vote_cache::raise_rank_floor (nano::uint128_t const & tally)
+{
+	auto const floor = rank_floor_of (tally);
+	auto current = rank_floor.load (std::memory_order_relaxed);
+	while (floor > current && !rank_floor.compare_exchange_weak (current, floor, std::memory_order_relaxed))
+	{
+	}
+}
+
+void nano::vote_cache::unrank (entry const & ent)
+{
+	if (ent.ranked)
+	{
+		nano::lock_guard<nano::mutex> guard{ ranking_mutex };
+		ranking.get<tag_hash> ().erase (ent.hash ());
+		rank_threshold = 0;
 	}
 }
 
 bool nano::vote_cache::empty () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return cache.empty ();
+	return std::all_of (shards.begin (), shards.end (), [] (auto const & shard) {
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		return shard->cache.empty ();
+	});
 }
 
 std::size_t nano::vote_cache::size () const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	return cache.size ();
+	std::size_t result = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		result += shard->cache.size ();
+	}
+	return result;
 }
 
 std::vector<std::shared_ptr<nano::vote>> nano::vote_cache::find (const nano::block_hash & hash) const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
 
-	auto & cache_by_hash = cache.get<tag_hash> ();
+	auto & cache_by_hash = shard.cache.get<tag_hash> ();
 	if (auto existing = cache_by_hash.find (hash); existing != cache_by_hash.end ())
 	{
 		return existing->votes ();
@@ -204,20 +334,23 @@ std::vector<std::shared_ptr<nano::vote>> nano::vote_cache::find (const nano::blo
 
 bool nano::vote_cache::contains (const nano::block_hash & hash) const
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
 
-	auto & cache_by_hash = cache.get<tag_hash> ();
+	auto & cache_by_hash = shard.cache.get<tag_hash> ();
 	return cache_by_hash.find (hash) != cache_by_hash.end ();
 }
 
 bool nano::vote_cache::erase (const nano::block_hash & hash)
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
+	auto & shard = shard_for (hash);
+	nano::lock_guard<nano::mutex> lock{ shard.mutex };
 
 	bool result = false;
-	auto & cache_by_hash = cache.get<tag_hash> ();
+	auto & cache_by_hash = shard.cache.get<tag_hash> ();
 	if (auto existing = cache_by_hash.find (hash); existing != cache_by_hash.end ())
 	{
+		unrank (*existing);
 		cache_by_hash.erase (existing);
 		result = true;
 	}
@@ -226,31 +359,60 @@ bool nano::vote_cache::erase (const nano::block_hash & hash)
 
 void nano::vote_cache::clear ()
 {
-	nano::lock_guard<nano::mutex> lock{ mutex };
-	cache.clear ();
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		for (auto const & ent : shard->cache)
+		{
+			unrank (ent);
+		}
+		shard->cache.clear ();
+	}
 }
 
 std::deque<nano::vote_cache::top_entry> nano::vote_cache::top (const nano::uint128_t & min_tally)
 {
 	stats.inc (nano::stat::type::vote_cache, nano::stat::detail::top);
 
+	bool should_cleanup = false;
+	{
+		nano::lock_guard<nano::mutex> guard{ ranking_mutex };
+		should_cleanup = cleanup_interval.elapse (config.age_cutoff / 2);
+	}
+	if (should_cleanup)
+	{
+		cleanup ();
+	}
+
 	std::deque<top_entry> results;
+	if (static_cast<uint64_t> (min_tally >> 64) >= rank_floor.load (std::memory_order_relaxed))
 	{
-		nano::lock_guard<nano::mutex> lock{ mutex };
+		// Every entry outside of the ranking has a lower tally than requested
+		nano::lock_guard<nano::mutex> guard{ ranking_mutex };
 
-		if (cleanup_interval.elapse (config.age_cutoff / 2))
+		for (auto const & ranked : ranking.get<tag_tally> ())
 		{
-			cleanup ();
+			if (ranked.tally < min_tally)
+			{
+				break;
+			}
+			results.push_back ({ ranked.hash, ranked.tally, ranked.final_tally });
 		}
+	}
+	else
+	{
+		stats.inc (nano::stat::type::vote_cache, nano::stat::detail::top_scan);
 
-		for (auto & entry : cache.get<tag_tally> ())
+		for (auto const & shard : shards)
 		{
-			auto tally = entry.tally ();
-			if (tally < min_tally)
+			nano::lock_guard<nano::mutex> lock{ shard->mutex };
+			for (auto const & ent : shard->cache)
 			{
-				break;
+				if (ent.tally () >= min_tally)
+				{
+					results.push_back ({ ent.hash (), ent.tally (), ent.final_tally () });
+				}
 			}
-			results.push_back ({ entry.hash (), tally, entry.final_tally () });
 		}
 	}
 
@@ -271,23 +433,93 @@ std::deque<nano::vote_cache::top_entry> nano::vote_cache::top (const nano::uint1
 
 void nano::vote_cache::cleanup ()
 {
-	debug_assert (!mutex.try_lock ());
-
 	stats.inc (nano::stat::type::vote_cache, nano::stat::detail::cleanup);
 
 	auto const cutoff = std::chrono::steady_clock::now () - config.age_cutoff;
 
-	erase_if (cache, [cutoff] (auto const & entry) {
-		return entry.last_vote () < cutoff;
+	// All shards are locked while the ranking is rebuilt, so no entry can be ranked concurrently
+	std::deque<nano::unique_lock<nano::mutex>> locks;
+	for (auto & shard : shards)
+	{
+		locks.emplace_back (shard->mutex);
+	}
+
+	std::vector<ranked_entry> remaining;
+	for (auto & shard : shards)
+	{
+		for (auto it = shard->cache.begin (); it != shard->cache.end ();)
+		{
+			if (it->last_vote () < cutoff)
+			{
+				it = shard->cache.erase (it);
+			}
+			else
+			{
+				remaining.push_back ({ it->hash (), it->tally (), it->final_tally () });
+				++it;
+			}
+		}
+	}
+
+	// Tallies of entries skipped while the ranking was full may have grown past ranked ones, rank the highest ones again
+	auto const ranked_end = remaining.begin () + std::min (remaining.size (), top_max);
+	std::nth_element (remaining.begin (), ranked_end, remaining.end (), [] (auto const & a, auto const & b) {
+		return a.tally > b.tally;
+	});
+
+	nano::lock_guard<nano::mutex> guard{ ranking_mutex };
+	ranking.clear ();
+	ranking.insert (remaining.begin (), ranked_end);
+	rank_floor = 0;
+	std::for_each (ranked_end, remaining.end (), [this] (auto const & unranked) {
+		raise_rank_floor (unranked.tally);
 	});
+	rank_threshold = ranking.size () >= top_max ? static_cast<uint64_t> (ranking.get<tag_tally> ().rbegin ()->tally >> 64) : 0;
+
+	auto const & ranking_by_hash = ranking.get<tag_hash> ();
+	for (auto & shard : shards)
+	{
+		for (auto it = shard->cache.begin (); it != shard->cache.end (); ++it)
+		{
+			shard->cache.modify (it, [&ranking_by_hash] (entry & ent) {
+				ent.ranked = ranking_by_hash.find (ent.hash ()) != ranking_by_hash.end ();
+			});
+		}
+	}
+}
+
+void nano::vote_cache::capacity_scale (double scale_a)
+{
+	debug_assert (scale_a > 0.0 && scale_a <= 1.0);
+	scale = scale_a;
+	for (auto & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		trim (*shard);
+	}
+}
+
+std::size_t nano::vote_cache::shard_capacity () const
+{
+	auto const capacity = std::max<std::size_t> (1, static_cast<std::size_t> (config.max_size * scale.load ()));
+	return (capacity + shards.size () - 1) / shards.size ();
 }
 
 nano::container_info nano::vote_cache::container_info () const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
+	std::size_t count = 0;
+	for (auto const & shard : shards)
+	{
+		nano::lock_guard<nano::mutex> lock{ shard->mutex };
+		count += shard->cache.size ();
+	}
+
+	nano::lock_guard<nano::mutex> guard{ ranking_mutex };
 
 	nano::container_info info;
-	info.put ("cache", cache);
+	info.put ("cache", count, sizeof (entry));
+	info.put ("ranking", ranking.size (), sizeof (ranked_entry));
+	info.put ("shards", shards.size ());
 	return info;
 }
 
@@ -3,11 +3,14 @@
 #include <nano/lib/interval.hpp>
 #include <nano/lib/locks.hpp>
 #include <nano/lib/numbers.hpp>
+#include <nano/lib/numbers_templ.hpp>
+#include <nano/lib/uint128.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/fwd.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/fwd.hpp>
 
+#include <boost/container/small_vector.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/member.hpp>
@@ -15,6 +18,7 @@
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <atomic>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -46,8 +50,7 @@ class vote_cache_entry final
 private:
 	struct voter_entry
 	{
-		nano::account representative;
-		nano::uint128_t weight;
+		nano::uint128_fast_t weight;
 		std::shared_ptr<nano::vote> vote;
 	};
 
@@ -74,39 +77,46 @@ public: // Keep accessors inlined
 	}
 	nano::uint128_t tally () const
 	{
-		return tally_m;
+		return tally_m.number ();
 	}
 	nano::uint128_t final_tally () const
 	{
-		return final_tally_m;
+		return final_tally_m.number ();
 	}
 
 private:
-	bool vote_impl (std::shared_ptr<nano::vote> const & vote, nano::uint128_t const & rep_weight, std::size_t max_voters);
-	std::pair<nano::uint128_t, nano::uint128_t> calculate_tally () const; // <tally, final_tally>
+	bool vote_impl (std::shared_ptr<nano::vote> const & vote, nano::uint128_fast_t const & rep_weight, std::size_t max_voters);
+	std::pair<nano::uint128_fast_t, nano::uint128_fast_t> calculate_tally () const; // <tally, final_tally>
+	/** Index of the representative in the voter list, equal to the number of voters if not found */
+	std::size_t find (nano::account const & representative) const;
+	void erase_lowest_weight ();
 
-	// clang-format off
-	class tag_representative {};
-	class tag_weight {};
-	// clang-format on
+	/** Most blocks only receive votes from a few representatives, those are stored without a heap allocation */
+	static std::size_t constexpr inline_voters{ 8 };
 
-	// clang-format off
-	using ordered_voters = boost::multi_index_container<voter_entry,
-	mi::indexed_by<
-		mi::hashed_unique<mi::tag<tag_representative>,
-			mi::member<voter_entry, nano::account, &voter_entry::representative>>,
-		mi::ordered_non_unique<mi::tag<tag_weight>,
-			mi::member<voter_entry, nano::uint128_t, &voter_entry::weight>>
-	>>;
-	// clang-format on
-	ordered_voters voters;
+	// Voters are kept in insertion order in two parallel arrays
+	// Representatives are stored apart from the rest of the voter data, so lookups scan a contiguous array of accounts
+	boost::container::small_vector<nano::account, inline_voters> representatives;
+	boost::container::small_vector<voter_entry, inline_voters> voters;
 
 	nano::block_hash const hash_m;
 	std::chrono::steady_clock::time_point last_vote_m{};
-	nano::uint128_t tally_m{ 0 };
-	nano::uint128_t final_tally_m{ 0 };
+	// Tallies are summed on every vote, fixed width arithmetic avoids the generic multiprecision routines
+	nano::uint128_fast_t tally_m{ 0 };
+	nano::uint128_fast_t final_tally_m{ 0 };
+	// Whether the entry may be present in the top tally index of the vote cache
+	bool ranked{ false };
+
+	friend class vote_cache;
 };
 
+/**
+ * Cache of votes for blocks without an active election.
+ * Entries are sharded by block hash, so votes for different blocks can be inserted concurrently. Each shard evicts its oldest entries when full.
+ * The blocks with the highest tallies are tracked in a separate bounded ranking, so `top ()` does not need to lock the shards
+ * as long as the requested minimum tally is above every entry left out of the ranking. Entries that could not be ranked while it
+ * was full are considered again when their tally changes and whenever the ranking is rebuilt during the periodic cleanup.
+ */
 class vote_cache final
 {
 public:
@@ -146,12 +156,18 @@ public:
 	};
 
 	/**
-	 * Returns blocks with highest observed tally
+	 * Returns all blocks with at least `min_tally` observed tally
+	 * Served from the ranking of the `top_max` highest tallies when it covers `min_tally`, otherwise all shards are scanned
 	 * The blocks are sorted in descending order by final tally, then by tally
 	 * @param min_tally minimum tally threshold, entries below with their voting weight below this will be ignored
 	 */
 	std::deque<top_entry> top (nano::uint128_t const & min_tally);
 
+	/**
+	 * Limits the cache to a fraction of the configured maximum size, evicting the oldest entries if needed
+	 */
+	void capacity_scale (double);
+
 	nano::container_info container_info () const;
 
 public:
@@ -164,10 +180,14 @@ private: // Dependencies
 	vote_cache_config const & config;
 	nano::stats & stats;
 
-private:
-	void insert_impl (std::shared_ptr<nano::vote> const &, nano::block_hash const & hash, nano::uint128_t const & rep_weight);
-	void cleanup ();
+public: // Constants
+	/** Number of highest tally entries in the ranking used by `top ()` */
+	static std::size_t constexpr top_max{ 1024 * 4 };
+	/** Smallest number of entries per shard, small caches use fewer shards to keep eviction order close to exact */
+	static std::size_t constexpr shard_min_size{ 1024 * 4 };
+	static std::size_t constexpr shards_max{ 16 };
 
+private:
 	// clang-format off
 	class tag_sequenced {};
 	class tag_hash {};
@@ -179,14 +199,53 @@ private:
 	mi::indexed_by<
 		mi::hashed_unique<mi::tag<tag_hash>,
 			mi::const_mem_fun<entry, nano::block_hash, &entry::hash>>,
-		mi::sequenced<mi::tag<tag_sequenced>>,
+		mi::sequenced<mi::tag<tag_sequenced>>
+	>>;
+	// clang-format on
+
+	struct shard
+	{
+		ordered_cache cache;
+		mutable nano::mutex mutex;
+	};
+
+	struct ranked_entry
+	{
+		nano::block_hash hash;
+		nano::uint128_t tally;
+		nano::uint128_t final_tally;
+	};
+
+	// clang-format off
+	using ordered_ranking = boost::multi_index_container<ranked_entry,
+	mi::indexed_by<
+		mi::hashed_unique<mi::tag<tag_hash>,
+			mi::member<ranked_entry, nano::block_hash, &ranked_entry::hash>>,
 		mi::ordered_non_unique<mi::tag<tag_tally>,
-			mi::const_mem_fun<entry, nano::uint128_t, &entry::tally>, std::greater<>> // DESC
+			mi::member<ranked_entry, nano::uint128_t, &ranked_entry::tally>, std::greater<>> // DESC
 	>>;
 	// clang-format on
-	ordered_cache cache;
 
-	mutable nano::mutex mutex;
+private:
+	shard & shard_for (nano::block_hash const &) const;
+	void insert_impl (shard &, std::shared_ptr<nano::vote> const &, nano::block_hash const & hash, nano::uint128_t const & rep_weight);
+	void trim (shard &);
+	void rank (entry &);
+	void unrank (entry const &);
+	void raise_rank_floor (nano::uint128_t const & tally);
+	void cleanup ();
+	std::size_t shard_capacity () const;
+
+	std::vector<std::unique_ptr<shard>> shards;
+	std::atomic<double> scale{ 1.0 };
+
+	ordered_ranking ranking;
+	// Upper 64 bits of the lowest tally in the ranking once it is full, entries below it can skip locking the ranking
+	std::atomic<uint64_t> rank_threshold{ 0 };
+	// Upper 64 bits plus one of the highest tally left out of the ranking, zero if the ranking holds every entry
+	std::atomic<uint64_t> rank_floor{ 0 };
+	mutable nano::mutex ranking_mutex;
+
 	nano::interval cleanup_interval;
 };
 }
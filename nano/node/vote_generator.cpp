@@ -1,5 +1,6 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/stats.hpp>
+#include <nano/lib/thread_pool.hpp>
 #include <nano/lib/utility.hpp>
 #include <nano/node/local_vote_history.hpp>
 #include <nano/node/network.hpp>
@@ -96,6 +97,11 @@ void nano::vote_generator::stop ()
 	{
 		thread.join ();
 	}
+	nano::lock_guard<nano::mutex> guard{ signing_mutex };
+	if (signing_workers)
+	{
+		signing_workers->stop ();
+	}
 }
 
 void nano::vote_generator::add (const root & root, const block_hash & hash)
@@ -259,12 +265,11 @@ void nano::vote_generator::reply (nano::unique_lock<nano::mutex> & lock_a, reque
 void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a, std::vector<nano::root> const & roots_a, std::function<void (std::shared_ptr<nano::vote> const &)> const & action_a)
 {
 	debug_assert (hashes_a.size () == roots_a.size ());
-	std::vector<std::shared_ptr<nano::vote>> votes_l;
-	wallets.foreach_representative ([this, &hashes_a, &votes_l] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
-		auto timestamp = this->is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
-		uint8_t duration = this->is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
-		votes_l.emplace_back (std::make_shared<nano::vote> (pub_a, prv_a, timestamp, duration, hashes_a));
+	std::vector<std::pair<nano::public_key, nano::raw_key>> representatives;
+	wallets.foreach_representative ([&representatives] (nano::public_key const & pub_a, nano::raw_key const & prv_a) {
+		representatives.emplace_back (pub_a, prv_a);
 	});
+	auto const votes_l = sign (representatives, hashes_a);
 	for (auto const & vote_l : votes_l)
 	{
 		for (std::size_t i (0), n (hashes_a.size ()); i != n; ++i)
@@ -276,9 +281,90 @@ void nano::vote_generator::vote (std::vector<nano::block_hash> const & hashes_a,
 	}
 }
 
+std::vector<std::shared_ptr<nano::vote>> nano::vote_generator::sign (std::vector<std::pair<nano::public_key, nano::raw_key>> const & representatives, std::vector<nano::block_hash> const & hashes_a)
+{
+	std::vector<std::shared_ptr<nano::vote>> result;
+	if (representatives.empty ())
+	{
+		return result;
+	}
+
+	auto const timestamp = is_final ? nano::vote::timestamp_max : nano::milliseconds_since_epoch ();
+	uint8_t const duration = is_final ? nano::vote::duration_max : /*8192ms*/ 0x9;
+	result.reserve (representatives.size ());
+	for (auto const & [pub, prv] : representatives)
+	{
+		result.push_back (std::make_shared<nano::vote> (pub, timestamp, duration, hashes_a));
+	}
+	// The signed hash does not depend on the representative, compute it once for all votes
+	auto const hash = result.front ()->hash ();
+	stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_signed, result.size ());
+
+	auto const workers = representatives.size () > 1 ? signing_pool () : nullptr;
+	if (workers == nullptr)
+	{
+		for (std::size_t i = 0; i < result.size (); ++i)
+		{
+			result[i]->signature = nano::sign_message (representatives[i].second, representatives[i].first, hash);
+		}
+		return result;
+	}
+
+	// Workers and the calling thread claim votes to sign one at a time. A task running after all votes were claimed exits
+	// without touching the vectors, so tasks that are never run by a stopped pool cannot block the caller
+	struct batch_state
+	{
+		explicit batch_state (std::size_t size) :
+			size{ size }
+		{
+		}
+		std::size_t const size;
+		std::atomic<std::size_t> next{ 0 };
+		std::atomic<std::size_t> done{ 0 };
+		nano::mutex mutex;
+		nano::condition_variable condition;
+	};
+	auto state = std::make_shared<batch_state> (result.size ());
+	auto sign_claimed = [state, hash, &representatives, &result] () {
+		for (auto i = state->next++; i < state->size; i = state->next++)
+		{
+			result[i]->signature = nano::sign_message (representatives[i].second, representatives[i].first, hash);
+			if (++state->done == state->size)
+			{
+				nano::lock_guard<nano::mutex> guard{ state->mutex };
+				state->condition.notify_all ();
+			}
+		}
+	};
+	auto const tasks = std::min<std::size_t> (config.signature_checker_threads, result.size () - 1);
+	for (std::size_t i = 0; i < tasks; ++i)
+	{
+		workers->post (sign_claimed);
+	}
+	sign_claimed ();
+	{
+		nano::unique_lock<nano::mutex> lock{ state->mutex };
+		state->condition.wait (lock, [&state] () { return state->done == state->size; });
+	}
+	stats.add (nano::stat::type::vote_generator, nano::stat::detail::generator_signed_parallel, result.size ());
+	return result;
+}
+
+nano::thread_pool * nano::vote_generator::signing_pool ()
+{
+	nano::lock_guard<nano::mutex> guard{ signing_mutex };
+	// Checked under the lock so a pool is never created after stop () has stopped the existing one
+	if (!signing_workers && !stopped && config.enable_voting && config.signature_checker_threads > 0)
+	{
+		signing_workers = std::make_unique<nano::thread_pool> (config.signature_checker_threads, nano::thread_role::name::vote_signing, /* start immediately */ true);
+	}
+	return signing_workers.get ();
+}
+
 void nano::vote_generator::broadcast_action (std::shared_ptr<nano::vote> const & vote_a) const
 {
-	vote_processor.vote (vote_a, inproc_channel);
+	// Signed by this node, no need to verify the signature again
+	vote_processor.vote (vote_a, inproc_channel, nano::vote_source::live, /* verified */ true);
 
 	auto sent_pr = network.flood_vote_pr (vote_a);
 	auto sent_non_pr = network.flood_vote_non_pr (vote_a, 2.0f);
@@ -339,5 +425,10 @@ nano::container_info nano::vote_generator::container_info () const
 	info.put ("candidates", candidates.size ());
 	info.put ("requests", requests.size ());
 	info.add ("queue", vote_generation_queue.container_info ());
+	nano::lock_guard<nano::mutex> signing_guard{ signing_mutex };
+	if (signing_workers)
+	{
+		info.add ("signing_workers", signing_workers->container_info ());
+	}
 	return info;
 }
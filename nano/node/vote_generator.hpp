@@ -53,6 +53,9 @@ private:
 	void broadcast (nano::unique_lock<nano::mutex> &);
 	void reply (nano::unique_lock<nano::mutex> &, request_t &&);
 	void vote (std::vector<nano::block_hash> const &, std::vector<nano::root> const &, std::function<void (std::shared_ptr<nano::vote> const &)> const &);
+	std::vector<std::shared_ptr<nano::vote>> sign (std::vector<std::pair<nano::public_key, nano::raw_key>> const & representatives, std::vector<nano::block_hash> const &);
+	/** Pool for signing votes of several representatives, nullptr if signing must happen on the calling thread */
+	nano::thread_pool * signing_pool ();
 	void broadcast_action (std::shared_ptr<nano::vote> const &) const;
 	void process_batch (std::deque<queue_entry_t> & batch);
 	bool should_vote (transaction_variant_t const &, nano::root const &, nano::block_hash const &) const;
@@ -82,5 +85,8 @@ private:
 	std::thread thread;
 	std::shared_ptr<nano::transport::channel> inproc_channel;
 	nano::processing_queue<queue_entry_t> vote_generation_queue;
+	mutable nano::mutex signing_mutex;
+	/** Signs votes of multiple hosted representatives in parallel, created the first time more than one representative votes */
+	std::unique_ptr<nano::thread_pool> signing_workers;
 };
 }
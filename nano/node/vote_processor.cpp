@@ -101,7 +101,7 @@ void nano::vote_processor::stop ()
 	threads.clear ();
 }
 
-bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote, std::shared_ptr<nano::transport::channel> const & channel, nano::vote_source source)
+bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote, std::shared_ptr<nano::transport::channel> const & channel, nano::vote_source source, bool verified)
 {
 	debug_assert (channel != nullptr);
 
@@ -110,7 +110,7 @@ bool nano::vote_processor::vote (std::shared_ptr<nano::vote> const & vote, std::
 	bool added = false;
 	{
 		nano::lock_guard<nano::mutex> guard{ mutex };
-		added = queue.push ({ vote, source }, { tier, channel });
+		added = queue.push ({ vote, source, verified }, { tier, channel });
 	}
 	if (added)
 	{
@@ -162,8 +162,8 @@ void nano::vote_processor::run_batch (nano::unique_lock<nano::mutex> & lock)
 
 	for (auto const & [item, origin] : batch)
 	{
-		auto const & [vote, source] = item;
-		vote_blocking (vote, origin.channel, source);
+		auto const & [vote, source, verified] = item;
+		vote_blocking (vote, origin.channel, source, verified);
 	}
 
 	total_processed += batch.size ();
@@ -177,10 +177,15 @@ void nano::vote_processor::run_batch (nano::unique_lock<nano::mutex> & lock)
 	}
 }
 
-nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote> const & vote, std::shared_ptr<nano::transport::channel> const & channel, nano::vote_source source)
+nano::vote_code nano::vote_processor::vote_blocking (std::shared_ptr<nano::vote> const & vote, std::shared_ptr<nano::transport::channel> const & channel, nano::vote_source source, bool verified)
 {
+	if (verified)
+	{
+		stats.inc (nano::stat::type::vote_processor, nano::stat::detail::verification_skipped);
+	}
+
 	auto result = nano::vote_code::invalid;
-	if (!vote->validate ()) // false => valid vote
+	if (verified || !vote->validate ()) // false => valid vote
 	{
 		auto vote_results = vote_router.vote (vote, source);
 
@@ -12,6 +12,7 @@
 #include <deque>
 #include <memory>
 #include <thread>
+#include <tuple>
 #include <unordered_set>
 
 namespace nano
@@ -42,9 +43,12 @@ public:
 	void start ();
 	void stop ();
 
-	/** Queue vote for processing. @returns true if the vote was queued */
-	bool vote (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, nano::vote_source = nano::vote_source::live);
-	nano::vote_code vote_blocking (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, nano::vote_source = nano::vote_source::live);
+	/**
+	 * Queue vote for processing. @returns true if the vote was queued
+	 * @param verified skips signature verification, only for votes signed by this node
+	 */
+	bool vote (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, nano::vote_source = nano::vote_source::live, bool verified = false);
+	nano::vote_code vote_blocking (std::shared_ptr<nano::vote> const &, std::shared_ptr<nano::transport::channel> const &, nano::vote_source = nano::vote_source::live, bool verified = false);
 
 	/** Queue hash for vote cache lookup and processing. */
 	void trigger (nano::block_hash const & hash);
@@ -73,7 +77,7 @@ private:
 	void run_batch (nano::unique_lock<nano::mutex> &);
 
 private:
-	using entry_t = std::pair<std::shared_ptr<nano::vote>, nano::vote_source>;
+	using entry_t = std::tuple<std::shared_ptr<nano::vote>, nano::vote_source, bool>;
 	nano::fair_queue<entry_t, nano::rep_tier> queue;
 
 private:
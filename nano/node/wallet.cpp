@@ -160,6 +160,7 @@ bool nano::wallet_store::attempt_password (store::transaction const & transactio
 		nano::raw_key password_l;
 		derive_key (password_l, transaction_a, password_a);
 		password.value_set (password_l);
+		++generation;
 		result = !valid_password (transaction_a);
 	}
 	if (!result)
@@ -188,6 +189,7 @@ bool nano::wallet_store::rekey (store::transaction const & transaction_a, std::s
 		nano::raw_key password_l;
 		password.value (password_l);
 		password.value_set (password_new);
+		++generation;
 		nano::raw_key encrypted;
 		encrypted.encrypt (wallet_key_l, password_new, salt (transaction_a).owords[0]);
 		nano::raw_key wallet_enc;
@@ -202,6 +204,15 @@ bool nano::wallet_store::rekey (store::transaction const & transaction_a, std::s
 	return result;
 }
 
+void nano::wallet_store::lock ()
+{
+	nano::lock_guard<std::recursive_mutex> lock{ mutex };
+	nano::raw_key empty;
+	empty.clear ();
+	password.value_set (empty);
+	++generation;
+}
+
 void nano::wallet_store::derive_key (nano::raw_key & prv_a, store::transaction const & transaction_a, std::string const & password_a)
 {
 	auto salt_l (salt (transaction_a));
@@ -756,6 +767,7 @@ nano::public_key nano::wallet::deterministic_insert (store::transaction const &
 
 			nano::lock_guard<nano::mutex> lock{ representatives_mutex };
 			representatives.insert (key);
+			wallets.voting_keys_invalidate ();
 		}
 	}
 	return key;
@@ -806,6 +818,7 @@ nano::public_key nano::wallet::insert_adhoc (nano::raw_key const & key_a, bool g
 		{
 			nano::lock_guard<nano::mutex> lock{ representatives_mutex };
 			representatives.insert (key);
+			wallets.voting_keys_invalidate ();
 		}
 	}
 	return key;
@@ -1455,6 +1468,7 @@ nano::wallets::wallets (bool error_a, nano::node & node_a) :
 			if (!error)
 			{
 				items[id] = wallet;
+				voting_keys_invalidate ();
 			}
 			else
 			{
@@ -1546,6 +1560,7 @@ std::shared_ptr<nano::wallet> nano::wallets::create (nano::wallet_id const & id_
 	if (!error)
 	{
 		items[id_a] = result;
+		voting_keys_invalidate ();
 		result->enter_initial_password ();
 	}
 	return result;
@@ -1583,6 +1598,7 @@ void nano::wallets::destroy (nano::wallet_id const & id_a)
 	debug_assert (existing != items.end ());
 	auto wallet (existing->second);
 	items.erase (existing);
+	voting_keys_invalidate ();
 	wallet->store.destroy (transaction);
 }
 
@@ -1610,6 +1626,7 @@ void nano::wallets::reload ()
 			if (!error)
 			{
 				items[id] = wallet;
+				voting_keys_invalidate ();
 			}
 		}
 		// List of wallets on disk
@@ -1628,6 +1645,7 @@ void nano::wallets::reload ()
 	{
 		debug_assert (items.find (i) == items.end ());
 		items.erase (i);
+		voting_keys_invalidate ();
 	}
 }
 
@@ -1644,55 +1662,97 @@ void nano::wallets::foreach_representative (std::function<void (nano::public_key
 {
 	if (node.config.enable_voting)
 	{
-		std::vector<std::pair<nano::public_key const, nano::raw_key const>> action_accounts_l;
+		auto const snapshot = voting_keys ();
+		for (auto const & [pub, prv] : snapshot->keys)
 		{
-			auto transaction_l (tx_begin_read ());
-			auto ledger_txn = node.ledger.tx_begin_read ();
-			nano::lock_guard<nano::mutex> lock{ mutex };
-			for (auto i (items.begin ()), n (items.end ()); i != n; ++i)
+			// Weights are checked on every call, using the in memory representative weights
+			if (node.ledger.weight (pub) > 0)
 			{
-				auto & wallet (*i->second);
-				nano::lock_guard<std::recursive_mutex> store_lock{ wallet.store.mutex };
-				decltype (wallet.representatives) representatives_l;
+				action_a (pub, prv);
+			}
+		}
+	}
+}
+
+void nano::wallets::voting_keys_invalidate ()
+{
+	++voting_keys_generation;
+}
+
+std::shared_ptr<nano::wallets::voting_keys_snapshot const> nano::wallets::voting_keys ()
+{
+	nano::lock_guard<nano::mutex> guard{ voting_keys_mutex };
+	if (!voting_keys_m || !voting_keys_valid (*voting_keys_m))
+	{
+		voting_keys_m = voting_keys_build ();
+	}
+	return voting_keys_m;
+}
+
+bool nano::wallets::voting_keys_valid (voting_keys_snapshot const & snapshot) const
+{
+	if (snapshot.generation != voting_keys_generation || snapshot.write_generation != write_generation)
+	{
+		return false;
+	}
+	return std::all_of (snapshot.stores.begin (), snapshot.stores.end (), [] (auto const & item) {
+		return item.first->store.generation == item.second;
+	});
+}
+
+std::shared_ptr<nano::wallets::voting_keys_snapshot const> nano::wallets::voting_keys_build ()
+{
+	auto result = std::make_shared<voting_keys_snapshot> ();
+	// Generations are read before the read transaction is opened, anything committed after this point invalidates the snapshot
+	result->generation = voting_keys_generation;
+	result->write_generation = write_generation;
+	{
+		nano::lock_guard<nano::mutex> lock{ mutex };
+		for (auto const & [id, wallet] : items)
+		{
+			result->stores.emplace_back (wallet, wallet->store.generation);
+		}
+	}
+
+	auto transaction_l (tx_begin_read ());
+	nano::lock_guard<nano::mutex> lock{ mutex };
+	for (auto i (items.begin ()), n (items.end ()); i != n; ++i)
+	{
+		auto & wallet (*i->second);
+		nano::lock_guard<std::recursive_mutex> store_lock{ wallet.store.mutex };
+		decltype (wallet.representatives) representatives_l;
+		{
+			nano::lock_guard<nano::mutex> representatives_lock{ wallet.representatives_mutex };
+			representatives_l = wallet.representatives;
+		}
+		for (auto const & account : representatives_l)
+		{
+			if (wallet.store.exists (transaction_l, account))
+			{
+				if (wallet.store.valid_password (transaction_l))
 				{
-					nano::lock_guard<nano::mutex> representatives_lock{ wallet.representatives_mutex };
-					representatives_l = wallet.representatives;
+					nano::raw_key prv;
+					auto error (wallet.store.fetch (transaction_l, account, prv));
+					(void)error;
+					debug_assert (!error);
+					result->keys.emplace_back (account, prv);
 				}
-				for (auto const & account : representatives_l)
+				else
 				{
-					if (wallet.store.exists (transaction_l, account))
+					// TODO: Better logging interval handling
+					static auto last_log = std::chrono::steady_clock::time_point ();
+					if (last_log < std::chrono::steady_clock::now () - std::chrono::seconds (60))
 					{
-						if (!node.ledger.weight_exact (ledger_txn, account).is_zero ())
-						{
-							if (wallet.store.valid_password (transaction_l))
-							{
-								nano::raw_key prv;
-								auto error (wallet.store.fetch (transaction_l, account, prv));
-								(void)error;
-								debug_assert (!error);
-								action_accounts_l.emplace_back (account, prv);
-							}
-							else
-							{
-								// TODO: Better logging interval handling
-								static auto last_log = std::chrono::steady_clock::time_point ();
-								if (last_log < std::chrono::steady_clock::now () - std::chrono::seconds (60))
-								{
-									last_log = std::chrono::steady_clock::now ();
-
-									logger.warn (nano::log::type::wallet, "Representative locked inside wallet: {}", i->first.to_string ());
-								}
-							}
-						}
+						last_log = std::chrono::steady_clock::now ();
+
+						logger.warn (nano::log::type::wallet, "Representative locked inside wallet: {}", i->first.to_string ());
 					}
+					break;
 				}
 			}
 		}
-		for (auto const & representative : action_accounts_l)
-		{
-			action_a (representative.first, representative.second);
-		}
 	}
+	return result;
 }
 
 bool nano::wallets::exists (store::transaction const & transaction_a, nano::account const & account_a)
@@ -1708,7 +1768,12 @@ bool nano::wallets::exists (store::transaction const & transaction_a, nano::acco
 
 nano::store::write_transaction nano::wallets::tx_begin_write ()
 {
-	return env.tx_begin_write ();
+	nano::store::lmdb::txn_callbacks callbacks;
+	// Called once the changes are committed and visible to new read transactions
+	callbacks.txn_end = [this] (store::transaction_impl const *) {
+		++write_generation;
+	};
+	return env.tx_begin_write (callbacks);
 }
 
 nano::store::read_transaction nano::wallets::tx_begin_read ()
@@ -1779,6 +1844,10 @@ void nano::wallets::compute_reps ()
 			}
 		}
 		nano::lock_guard<nano::mutex> representatives_guard{ wallet.representatives_mutex };
+		if (wallet.representatives != representatives_l)
+		{
+			voting_keys_invalidate ();
+		}
 		wallet.representatives.swap (representatives_l);
 	}
 }
@@ -1890,10 +1959,15 @@ bool nano::mdb_wallets_store::init_error () const
 
 nano::container_info nano::wallets::container_info () const
 {
-	nano::lock_guard<nano::mutex> guard{ mutex };
-
 	nano::container_info info;
-	info.put ("items", items.size ());
-	info.put ("actions", actions.size ());
+	{
+		nano::lock_guard<nano::mutex> guard{ mutex };
+		info.put ("items", items.size ());
+		info.put ("actions", actions.size ());
+	}
+	{
+		nano::lock_guard<nano::mutex> guard{ voting_keys_mutex };
+		info.put ("voting_keys", voting_keys_m ? voting_keys_m->keys.size () : 0);
+	}
 	return info;
 }
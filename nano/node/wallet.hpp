@@ -68,6 +68,8 @@ public:
 	void initialize (store::transaction const &, bool &, std::string const &);
 	nano::uint256_union check (store::transaction const &);
 	bool rekey (store::transaction const &, std::string const &);
+	/** Forgets the password, the wallet stays locked until the password is entered again */
+	void lock ();
 	bool valid_password (store::transaction const &);
 	bool valid_public_key (nano::public_key const &);
 	bool attempt_password (store::transaction const &, std::string const &);
@@ -126,6 +128,8 @@ public:
 	nano::kdf & kdf;
 	std::atomic<MDB_dbi> handle{ 0 };
 	std::recursive_mutex mutex;
+	/** Incremented when the password changes, used to detect stale copies of decrypted keys. Stored keys are tracked by nano::wallets once written. */
+	std::atomic<uint64_t> generation{ 0 };
 
 private:
 	nano::store::lmdb::env & env;
@@ -220,7 +224,10 @@ public:
 	void reload ();
 	void do_wallet_actions ();
 	void queue_wallet_action (nano::uint128_t const &, std::shared_ptr<nano::wallet> const &, std::function<void (nano::wallet &)>);
+	/** Calls \p action for each representative with voting weight in an unlocked wallet, keys come from a cached snapshot */
 	void foreach_representative (std::function<void (nano::public_key const &, nano::raw_key const &)> const &);
+	/** Discards the cached voting keys, they are decrypted again on next use */
+	void voting_keys_invalidate ();
 	bool exists (store::transaction const &, nano::account const &);
 	void clear_send_ids (store::transaction const &);
 	nano::wallet_representatives reps () const;
@@ -258,6 +265,29 @@ public:
 private:
 	mutable nano::mutex reps_cache_mutex;
 	nano::wallet_representatives representatives;
+
+private:
+	/** Decrypted keys of representatives in unlocked wallets, immutable once built */
+	class voting_keys_snapshot final
+	{
+	public:
+		std::vector<std::pair<nano::public_key, nano::raw_key>> keys;
+		/** Store generation of each wallet at the time the snapshot was built */
+		std::vector<std::pair<std::shared_ptr<nano::wallet>, uint64_t>> stores;
+		uint64_t generation{ 0 };
+		uint64_t write_generation{ 0 };
+	};
+
+	std::shared_ptr<voting_keys_snapshot const> voting_keys ();
+	std::shared_ptr<voting_keys_snapshot const> voting_keys_build ();
+	bool voting_keys_valid (voting_keys_snapshot const &) const;
+
+	mutable nano::mutex voting_keys_mutex;
+	std::shared_ptr<voting_keys_snapshot const> voting_keys_m;
+	/** Incremented when wallets are added, removed or their representatives change */
+	std::atomic<uint64_t> voting_keys_generation{ 0 };
+	/** Incremented after each wallet write transaction commits */
+	std::atomic<uint64_t> write_generation{ 0 };
 };
 
 class wallets_store
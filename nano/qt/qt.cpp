@@ -1628,9 +1628,7 @@ nano_qt::settings::settings (nano_qt::wallet & wallet_a) :
 		if (this->wallet.wallet_m->store.valid_password (transaction))
 		{
 			// lock wallet
-			nano::raw_key empty;
-			empty.clear ();
-			this->wallet.wallet_m->store.password.value_set (empty);
+			this->wallet.wallet_m->store.lock ();
 			update_locked (true, true);
 			lock_toggle->setText ("Unlock");
 			this->wallet.node.logger.warn (nano::log::type::qt, "Wallet locked");
@@ -152,6 +152,7 @@ std::unordered_set<std::string> create_rpc_control_impls ()
 	set.emplace ("block_create");
 	set.emplace ("bootstrap_lazy");
 	set.emplace ("database_txn_tracker");
+	set.emplace ("debug_lock_contention");
 	set.emplace ("epoch_upgrade");
 	set.emplace ("keepalive");
 	set.emplace ("ledger");
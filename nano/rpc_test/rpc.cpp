@@ -5273,6 +5273,37 @@ TEST (rpc, stats_clear)
 	ASSERT_LE (node->stats.last_reset ().count (), 5);
 }
 
+TEST (rpc, debug_lock_contention)
+{
+	nano::test::system system;
+	auto node = add_ipc_enabled_node (system);
+	auto const rpc_ctx = add_rpc (system, node);
+	boost::property_tree::ptree request;
+	request.put ("action", "debug_lock_contention");
+	request.put ("enable", "true");
+	request.put ("reset", "true");
+	{
+		auto response (wait_response (system, rpc_ctx, request));
+		ASSERT_EQ ("true", response.get<std::string> ("enabled"));
+	}
+	// The node keeps taking its named locks while idle
+	auto active_acquired = [] () {
+		auto entries = nano::lock_profiler::collect ();
+		return std::any_of (entries.begin (), entries.end (), [] (auto const & entry) {
+			return entry.name == "active" && entry.acquisitions > 0;
+		});
+	};
+	ASSERT_TIMELY (5s, active_acquired ());
+	request.put ("enable", "false");
+	request.erase ("reset");
+	auto response (wait_response (system, rpc_ctx, request));
+	ASSERT_EQ ("false", response.get<std::string> ("enabled"));
+	auto const & active = response.get_child ("locks").get_child ("active");
+	ASSERT_GT (active.get<uint64_t> ("acquisitions"), 0);
+	ASSERT_LE (active.get<uint64_t> ("contended"), active.get<uint64_t> ("acquisitions"));
+	ASSERT_LE (active.get<uint64_t> ("wait_max_us"), active.get<uint64_t> ("wait_us"));
+}
+
 // Tests the RPC command returns the correct data for the unchecked blocks
 TEST (rpc, unchecked)
 {
@@ -12,6 +12,8 @@ public:
 	bool unchecked_count = true;
 	bool account_count = true;
 	bool block_count = true;
+	/* Per-account receivable totals are not generated by default as they require a scan of the pending table */
+	bool receivable = false;
 
 	void enable_all ();
 };
@@ -57,7 +57,7 @@ public:
 		{
 			auto info = ledger.any.account_get (transaction, pending.value ().source);
 			debug_assert (info);
-			ledger.store.pending.del (transaction, key);
+			ledger.pending_del (transaction, key, pending.value ().amount.number ());
 			ledger.cache.rep_weights.representation_add (transaction, info->representative, pending.value ().amount.number ());
 			nano::account_info new_info (block_a.hashables.previous, info->representative, info->open_block, ledger.any.block_balance (transaction, block_a.hashables.previous).value (), nano::seconds_since_epoch (), info->block_count - 1, nano::epoch::epoch_0);
 			ledger.update_account (transaction, pending.value ().source, *info, new_info);
@@ -79,7 +79,7 @@ public:
 		nano::account_info new_info (block_a.hashables.previous, info->representative, info->open_block, ledger.any.block_balance (transaction, block_a.hashables.previous).value (), nano::seconds_since_epoch (), info->block_count - 1, nano::epoch::epoch_0);
 		ledger.update_account (transaction, destination_account, *info, new_info);
 		ledger.store.block.del (transaction, hash);
-		ledger.store.pending.put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account.value_or (0), amount, nano::epoch::epoch_0 });
+		ledger.pending_put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account.value_or (0), amount, nano::epoch::epoch_0 });
 		ledger.store.block.successor_clear (transaction, block_a.hashables.previous);
 		ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::receive);
 	}
@@ -93,7 +93,7 @@ public:
 		nano::account_info new_info;
 		ledger.update_account (transaction, destination_account, new_info, new_info);
 		ledger.store.block.del (transaction, hash);
-		ledger.store.pending.put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account.value_or (0), amount, nano::epoch::epoch_0 });
+		ledger.pending_put (transaction, nano::pending_key (destination_account, block_a.hashables.source), { source_account.value_or (0), amount, nano::epoch::epoch_0 });
 		ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::open);
 	}
 	void change_block (nano::change_block const & block_a) override
@@ -149,7 +149,7 @@ public:
 			{
 				error = ledger.rollback (transaction, ledger.any.account_head (transaction, block_a.hashables.link.as_account ()), list);
 			}
-			ledger.store.pending.del (transaction, key);
+			ledger.pending_del (transaction, key, balance - block_a.hashables.balance.number ());
 			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::send);
 		}
 		else if (!block_a.hashables.link.is_zero () && !ledger.is_epoch_link (block_a.hashables.link))
@@ -157,7 +157,7 @@ public:
 			// Pending account entry can be incorrect if source block was pruned. But it's not affecting correct ledger processing
 			auto source_account = ledger.any.block_account (transaction, block_a.hashables.link.as_block_hash ());
 			nano::pending_info pending_info (source_account.value_or (0), block_a.hashables.balance.number () - balance, block_a.sideband ().source_epoch);
-			ledger.store.pending.put (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
+			ledger.pending_put (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), pending_info);
 			ledger.stats.inc (nano::stat::type::rollback, nano::stat::detail::receive);
 		}
 
@@ -354,11 +354,11 @@ void ledger_processor::state_block_impl (nano::state_block & block_a)
 						{
 							nano::pending_key key (block_a.hashables.link.as_account (), hash);
 							nano::pending_info info (block_a.hashables.account, amount.number (), epoch);
-							ledger.store.pending.put (transaction, key, info);
+							ledger.pending_put (transaction, key, info);
 						}
 						else if (!block_a.hashables.link.is_zero ())
 						{
-							ledger.store.pending.del (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()));
+							ledger.pending_del (transaction, nano::pending_key (block_a.hashables.account, block_a.hashables.link.as_block_hash ()), amount.number ());
 						}
 
 						nano::account_info new_info (hash, block_a.hashables.representative, info.open_block.is_zero () ? hash : info.open_block, block_a.hashables.balance, nano::seconds_since_epoch (), info.block_count + 1, epoch);
@@ -520,7 +520,7 @@ void ledger_processor::send_block (nano::send_block & block_a)
 								ledger.store.block.put (transaction, hash, block_a);
 								nano::account_info new_info (hash, info->representative, info->open_block, block_a.hashables.balance, nano::seconds_since_epoch (), info->block_count + 1, nano::epoch::epoch_0);
 								ledger.update_account (transaction, account, *info, new_info);
-								ledger.store.pending.put (transaction, nano::pending_key (block_a.hashables.destination, hash), { account, amount, nano::epoch::epoch_0 });
+								ledger.pending_put (transaction, nano::pending_key (block_a.hashables.destination, hash), { account, amount, nano::epoch::epoch_0 });
 								ledger.stats.inc (nano::stat::type::ledger, nano::stat::detail::send);
 							}
 						}
@@ -574,7 +574,7 @@ void ledger_processor::receive_block (nano::receive_block & block_a)
 										if (result == nano::block_status::progress)
 										{
 											auto new_balance (info->balance.number () + pending.value ().amount.number ());
-											ledger.store.pending.del (transaction, key);
+											ledger.pending_del (transaction, key, pending.value ().amount.number ());
 											block_a.sideband_set (nano::block_sideband (account, 0, new_balance, info->block_count + 1, nano::seconds_since_epoch (), block_details, nano::epoch::epoch_0 /* unused */));
 											ledger.store.block.put (transaction, hash, block_a);
 											nano::account_info new_info (hash, info->representative, info->open_block, new_balance, nano::seconds_since_epoch (), info->block_count + 1, nano::epoch::epoch_0);
@@ -626,7 +626,7 @@ void ledger_processor::open_block (nano::open_block & block_a)
 								result = ledger.constants.work.difficulty (block_a) >= ledger.constants.work.threshold (block_a.work_version (), block_details) ? nano::block_status::progress : nano::block_status::insufficient_work; // Does this block have sufficient work? (Malformed)
 								if (result == nano::block_status::progress)
 								{
-									ledger.store.pending.del (transaction, key);
+									ledger.pending_del (transaction, key, pending.value ().amount.number ());
 									block_a.sideband_set (nano::block_sideband (block_a.hashables.account, 0, pending.value ().amount, 1, nano::seconds_since_epoch (), block_details, nano::epoch::epoch_0 /* unused */));
 									ledger.store.block.put (transaction, hash, block_a);
 									nano::account_info new_info (hash, block_a.representative_field ().value (), hash, pending.value ().amount.number (), nano::seconds_since_epoch (), 1, nano::epoch::epoch_0);
@@ -791,6 +791,22 @@ void nano::ledger::initialize (nano::generate_cache_flags const & generate_cache
 		});
 	}
 
+	if (generate_cache_flags_a.receivable)
+	{
+		cache.receivable.enable ();
+		store.pending.for_each_par (
+		[this] (store::read_transaction const & /*unused*/, auto i, auto n) {
+			nano::receivable_totals receivable_l;
+			receivable_l.enable ();
+			auto transaction = tx_begin_read ();
+			for (; i != n; ++i)
+			{
+				receivable_l.add (i->first.account, i->second.amount.number (), confirmed.block_exists_or_pruned (transaction, i->first.hash));
+			}
+			this->cache.receivable.copy_from (receivable_l);
+		});
+	}
+
 	auto transaction (store.tx_begin_read ());
 	cache.pruned_count = store.pruned.count (transaction);
 }
@@ -802,6 +818,11 @@ bool nano::ledger::unconfirmed_exists (secure::transaction const & transaction,
 
 nano::uint128_t nano::ledger::account_receivable (secure::transaction const & transaction_a, nano::account const & account_a, bool only_confirmed_a)
 {
+	if (cache.receivable.enabled ())
+	{
+		auto totals = cache.receivable.get (account_a);
+		return only_confirmed_a ? totals.confirmed_amount : totals.amount;
+	}
 	nano::uint128_t result (0);
 	nano::account end (account_a.number () + 1);
 	for (auto i (store.pending.begin (transaction_a, nano::pending_key (account_a, 0))), n (store.pending.begin (transaction_a, nano::pending_key (end, 0))); i != n; ++i)
@@ -898,6 +919,15 @@ void nano::ledger::confirm_one (secure::write_transaction & transaction, nano::b
 	store.confirmation_height.put (transaction, block.account (), info);
 	++cache.cemented_count;
 
+	// A receivable entry becomes confirmed with its source block, unless it was already received
+	if (cache.receivable.enabled () && block.is_send ())
+	{
+		if (auto pending = store.pending.get (transaction, { block.destination (), block.hash () }))
+		{
+			cache.receivable.confirm (block.destination (), pending->amount.number ());
+		}
+	}
+
 	stats.inc (nano::stat::type::confirmation_height, nano::stat::detail::blocks_confirmed);
 }
 
@@ -1255,6 +1285,25 @@ std::shared_ptr<nano::block> nano::ledger::forked_block (secure::transaction con
 	return result;
 }
 
+void nano::ledger::pending_put (secure::write_transaction const & transaction, nano::pending_key const & key, nano::pending_info const & info)
+{
+	store.pending.put (transaction, key, info);
+	if (cache.receivable.enabled ())
+	{
+		// Entries restored by rolling back a receive can refer to an already confirmed source block
+		cache.receivable.add (key.account, info.amount.number (), confirmed.block_exists_or_pruned (transaction, key.hash));
+	}
+}
+
+void nano::ledger::pending_del (secure::write_transaction const & transaction, nano::pending_key const & key, nano::uint128_t const & amount)
+{
+	if (cache.receivable.enabled ())
+	{
+		cache.receivable.remove (key.account, amount, confirmed.block_exists_or_pruned (transaction, key.hash));
+	}
+	store.pending.del (transaction, key);
+}
+
 uint64_t nano::ledger::pruning_action (secure::write_transaction & transaction_a, nano::block_hash const & hash_a, uint64_t const batch_size_a)
 {
 	uint64_t pruned_count (0);
@@ -1527,6 +1576,47 @@ bool nano::ledger::migrate_lmdb_to_rocksdb (std::filesystem::path const & data_p
 	return error;
 }
 
+// A precondition is that the store is a RocksDB store
+bool nano::ledger::migrate_rocksdb_block_encoding () const
+{
+	nano::logger logger;
+
+	auto table_size = store.count (store.tx_begin_read (), tables::blocks);
+	logger.info (nano::log::type::ledger, "Rewriting {} entries from blocks table in the compact encoding. This will take a while...", table_size);
+
+	// RocksDB converts values written in the canonical block + sideband format to the compact encoding,
+	// entries that are already compact are rewritten unchanged.
+	std::atomic<std::size_t> count = 0;
+	store.block.for_each_par (
+	[&] (store::read_transaction const & /*unused*/, auto i, auto n) {
+		auto transaction = store.tx_begin_write ();
+		for (; i != n; ++i)
+		{
+			transaction.refresh_if_needed ();
+			std::vector<uint8_t> vector;
+			{
+				nano::vectorstream stream (vector);
+				nano::serialize_block (stream, *i->second.block);
+				i->second.sideband.serialize (stream, i->second.block->type ());
+			}
+			store.block.raw_put (transaction, vector, i->first);
+
+			if (auto count_l = ++count; count_l % 5000000 == 0)
+			{
+				logger.info (nano::log::type::ledger, "{} blocks converted ({}%)", count_l, count_l * 100 / table_size);
+			}
+		}
+	});
+	logger.info (nano::log::type::ledger, "{} entries converted ({}%)", count.load (), table_size > 0 ? count.load () * 100 / table_size : 100);
+
+	auto const error = count.load () != table_size;
+	if (!error)
+	{
+		logger.info (nano::log::type::ledger, "Migration completed. Disk space is reclaimed as RocksDB compacts the blocks table");
+	}
+	return error;
+}
+
 nano::epoch nano::ledger::version (nano::block const & block)
 {
 	if (block.type () == nano::block_type::state)
@@ -1579,5 +1669,6 @@ nano::container_info nano::ledger::container_info () const
 	nano::container_info info;
 	info.put ("bootstrap_weights", bootstrap_weights);
 	info.add ("rep_weights", cache.rep_weights.container_info ());
+	info.add ("receivable", cache.receivable.container_info ());
 	return info;
 }
@@ -44,6 +44,10 @@ public:
 	secure::read_transaction tx_begin_read () const;
 
 	bool unconfirmed_exists (secure::transaction const &, nano::block_hash const &);
+	/**
+	 * Returns the sum of receivable amounts for the account.
+	 * With receivable totals enabled this is answered from the cache and reflects the latest ledger state rather than the transaction's view.
+	 */
 	nano::uint128_t account_receivable (secure::transaction const &, nano::account const &, bool = false);
 	/**
 	 * Returns the cached vote weight for the given representative.
@@ -66,6 +70,10 @@ public:
 	bool rollback (secure::write_transaction const &, nano::block_hash const &, std::deque<std::shared_ptr<nano::block>> & rollback_list);
 	bool rollback (secure::write_transaction const &, nano::block_hash const &);
 	void update_account (secure::write_transaction const &, nano::account const &, nano::account_info const &, nano::account_info const &);
+	/** Writes a pending entry and updates the receivable totals */
+	void pending_put (secure::write_transaction const &, nano::pending_key const &, nano::pending_info const &);
+	/** Deletes a pending entry of \p amount and updates the receivable totals */
+	void pending_del (secure::write_transaction const &, nano::pending_key const &, nano::uint128_t const & amount);
 	uint64_t pruning_action (secure::write_transaction &, nano::block_hash const &, uint64_t const);
 	void dump_account_chain (nano::account const &, std::ostream & = std::cout);
 	bool dependents_confirmed (secure::transaction const &, nano::block const &) const;
@@ -76,6 +84,7 @@ public:
 	nano::account const & epoch_signer (nano::link const &) const;
 	nano::link const & epoch_link (nano::epoch) const;
 	bool migrate_lmdb_to_rocksdb (std::filesystem::path const &) const;
+	bool migrate_rocksdb_block_encoding () const;
 	bool bootstrap_height_reached () const;
 	std::unordered_map<nano::account, nano::uint128_t> rep_weights_snapshot () const;
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nano/lib/numbers.hpp>
+#include <nano/secure/receivable_totals.hpp>
 #include <nano/secure/rep_weights.hpp>
 #include <nano/store/rep_weight.hpp>
 
@@ -26,6 +27,7 @@ class ledger_cache
 public:
 	explicit ledger_cache (nano::store::rep_weight & rep_weight_store_a, nano::uint128_t min_rep_weight_a = 0);
 	nano::rep_weights rep_weights;
+	nano::receivable_totals receivable;
 
 private:
 	std::atomic<uint64_t> cemented_count{ 0 };
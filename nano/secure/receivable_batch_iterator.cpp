@@ -0,0 +1,88 @@
+#include <nano/secure/ledger.hpp>
+#include <nano/secure/receivable_batch_iterator.hpp>
+#include <nano/store/component.hpp>
+
+#include <algorithm>
+
+nano::receivable_batch_iterator::receivable_batch_iterator (nano::ledger const & ledger_a, secure::transaction const & transaction_a, std::vector<nano::account> accounts_a) :
+	ledger{ ledger_a },
+	transaction{ transaction_a },
+	accounts{ std::move (accounts_a) },
+	current{ ledger_a.store.pending.end (transaction_a) }
+{
+	std::sort (accounts.begin (), accounts.end ());
+	accounts.erase (std::unique (accounts.begin (), accounts.end ()), accounts.end ());
+	if (ledger.cache.receivable.enabled ())
+	{
+		std::erase_if (accounts, [this] (nano::account const & account) {
+			return ledger.cache.receivable.get (account).count == 0;
+		});
+	}
+	if (!accounts.empty ())
+	{
+		current = ledger.store.pending.begin (transaction, nano::pending_key{ accounts.front (), 0 });
+	}
+	find ();
+}
+
+bool nano::receivable_batch_iterator::end () const
+{
+	return index >= accounts.size ();
+}
+
+auto nano::receivable_batch_iterator::operator++ () -> receivable_batch_iterator &
+{
+	debug_assert (!end ());
+	++current;
+	if (!current.is_end () && current->first.account != accounts[index])
+	{
+		++index;
+	}
+	find ();
+	return *this;
+}
+
+void nano::receivable_batch_iterator::next_account ()
+{
+	debug_assert (!end ());
+	++index;
+	find ();
+}
+
+/** Positions the cursor at the first entry of the current account, skipping accounts without entries */
+void nano::receivable_batch_iterator::find ()
+{
+	for (; index < accounts.size (); ++index)
+	{
+		auto const & account = accounts[index];
+		for (size_t steps = 0; !current.is_end () && current->first.account < account && steps < max_steps; ++steps)
+		{
+			++current;
+		}
+		if (!current.is_end () && current->first.account < account)
+		{
+			current = ledger.store.pending.begin (transaction, nano::pending_key{ account, 0 });
+		}
+		if (current.is_end ())
+		{
+			// No entries past this point, the remaining accounts have nothing receivable
+			index = accounts.size ();
+			return;
+		}
+		if (current->first.account == account)
+		{
+			return;
+		}
+	}
+}
+
+std::pair<nano::pending_key, nano::pending_info> const & nano::receivable_batch_iterator::operator* () const
+{
+	debug_assert (!end ());
+	return *current;
+}
+
+std::pair<nano::pending_key, nano::pending_info> const * nano::receivable_batch_iterator::operator->() const
+{
+	return &**this;
+}
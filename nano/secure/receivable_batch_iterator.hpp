@@ -0,0 +1,48 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/secure/pending_info.hpp>
+#include <nano/secure/transaction.hpp>
+#include <nano/store/pending.hpp>
+
+#include <utility>
+#include <vector>
+
+namespace nano
+{
+class ledger;
+
+/**
+ * Iterates receivable entries of a batch of accounts with a single database cursor.
+ * Accounts are visited in ascending order, the cursor is stepped forward to nearby accounts and only repositioned when the next account is further away.
+ * If the ledger maintains receivable totals, accounts without receivable entries are skipped without a database lookup.
+ */
+class receivable_batch_iterator final
+{
+public:
+	receivable_batch_iterator (nano::ledger const &, secure::transaction const &, std::vector<nano::account> accounts);
+
+	/** Returns true once the entries of all accounts were visited */
+	bool end () const;
+	/** Advances to the next receivable entry, continuing with the next account once the current one has no more entries */
+	receivable_batch_iterator & operator++ ();
+	/** Skips the remaining entries of the current account */
+	void next_account ();
+
+public: // Dereferencing, undefined behavior when end () is true
+	std::pair<nano::pending_key, nano::pending_info> const & operator* () const;
+	std::pair<nano::pending_key, nano::pending_info> const * operator->() const;
+
+private:
+	void find ();
+
+	nano::ledger const & ledger;
+	secure::transaction const & transaction;
+	std::vector<nano::account> accounts;
+	size_t index{ 0 };
+	nano::store::pending::iterator current;
+
+	// Number of entries stepped over before the cursor is repositioned with a seek
+	static size_t constexpr max_steps{ 8 };
+};
+}
@@ -0,0 +1,101 @@
+#include <nano/secure/receivable_totals.hpp>
+
+bool nano::receivable_totals::enabled () const
+{
+	return enabled_m;
+}
+
+void nano::receivable_totals::enable ()
+{
+	enabled_m = true;
+}
+
+void nano::receivable_totals::add (nano::account const & account, nano::uint128_t const & amount, bool confirmed)
+{
+	if (!enabled_m)
+	{
+		return;
+	}
+	std::unique_lock guard{ mutex };
+	auto & entry = totals[account];
+	++entry.count;
+	entry.amount += amount;
+	if (confirmed)
+	{
+		++entry.confirmed_count;
+		entry.confirmed_amount += amount;
+	}
+}
+
+void nano::receivable_totals::remove (nano::account const & account, nano::uint128_t const & amount, bool confirmed)
+{
+	if (!enabled_m)
+	{
+		return;
+	}
+	std::unique_lock guard{ mutex };
+	auto existing = totals.find (account);
+	release_assert (existing != totals.end () && existing->second.count > 0 && existing->second.amount >= amount);
+	auto & entry = existing->second;
+	--entry.count;
+	entry.amount -= amount;
+	if (confirmed)
+	{
+		release_assert (entry.confirmed_count > 0 && entry.confirmed_amount >= amount);
+		--entry.confirmed_count;
+		entry.confirmed_amount -= amount;
+	}
+	if (entry.count == 0)
+	{
+		totals.erase (existing);
+	}
+}
+
+void nano::receivable_totals::confirm (nano::account const & account, nano::uint128_t const & amount)
+{
+	if (!enabled_m)
+	{
+		return;
+	}
+	std::unique_lock guard{ mutex };
+	auto existing = totals.find (account);
+	release_assert (existing != totals.end () && existing->second.confirmed_count < existing->second.count);
+	++existing->second.confirmed_count;
+	existing->second.confirmed_amount += amount;
+}
+
+auto nano::receivable_totals::get (nano::account const & account) const -> entry
+{
+	std::shared_lock guard{ mutex };
+	auto existing = totals.find (account);
+	return existing != totals.end () ? existing->second : entry{};
+}
+
+void nano::receivable_totals::copy_from (nano::receivable_totals & other)
+{
+	std::unique_lock guard_this{ mutex };
+	std::shared_lock guard_other{ other.mutex };
+	for (auto const & [account, other_entry] : other.totals)
+	{
+		auto & entry = totals[account];
+		entry.count += other_entry.count;
+		entry.amount += other_entry.amount;
+		entry.confirmed_count += other_entry.confirmed_count;
+		entry.confirmed_amount += other_entry.confirmed_amount;
+	}
+}
+
+size_t nano::receivable_totals::size () const
+{
+	std::shared_lock guard{ mutex };
+	return totals.size ();
+}
+
+nano::container_info nano::receivable_totals::container_info () const
+{
+	std::shared_lock guard{ mutex };
+
+	nano::container_info info;
+	info.put ("totals", totals);
+	return info;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/lib/numbers_templ.hpp>
+#include <nano/lib/utility.hpp>
+
+#include <atomic>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace nano
+{
+/**
+ * Maintains the number and sum of receivable entries per destination account, split by whether the source block is confirmed.
+ * Totals are only maintained when enabled, they are built from the pending table when the ledger is loaded and updated
+ * by the ledger whenever pending entries are added, removed or their source block is confirmed.
+ */
+class receivable_totals
+{
+public:
+	class entry
+	{
+	public:
+		uint64_t count{ 0 };
+		nano::uint128_t amount{ 0 };
+		uint64_t confirmed_count{ 0 };
+		nano::uint128_t confirmed_amount{ 0 };
+	};
+
+	bool enabled () const;
+	void enable ();
+
+	/* Accounts a new receivable entry */
+	void add (nano::account const & account, nano::uint128_t const & amount, bool confirmed);
+	/* Removes a receivable entry when it is received or its source block is rolled back */
+	void remove (nano::account const & account, nano::uint128_t const & amount, bool confirmed);
+	/* Moves a receivable entry to the confirmed totals when its source block is confirmed */
+	void confirm (nano::account const & account, nano::uint128_t const & amount);
+	/* Returns zero totals for accounts without receivable entries */
+	entry get (nano::account const & account) const;
+	/* Only use this method when loading totals from the pending table */
+	void copy_from (receivable_totals & other);
+	size_t size () const;
+	nano::container_info container_info () const;
+
+private:
+	std::atomic<bool> enabled_m{ false };
+	mutable std::shared_mutex mutex;
+	std::unordered_map<nano::account, entry> totals;
+};
+}
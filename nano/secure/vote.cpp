@@ -20,6 +20,14 @@ nano::vote::vote (nano::account const & account_a, nano::raw_key const & prv_a,
 	signature = nano::sign_message (prv_a, account_a, hash ());
 }
 
+nano::vote::vote (nano::account const & account_a, uint64_t timestamp_a, uint8_t duration, std::vector<nano::block_hash> const & hashes) :
+	hashes{ hashes },
+	timestamp_m{ packed_timestamp (timestamp_a, duration) },
+	account{ account_a }
+{
+	debug_assert (hashes.size () <= max_hashes);
+}
+
 void nano::vote::serialize (nano::stream & stream_a) const
 {
 	debug_assert (hashes.size () <= max_hashes);
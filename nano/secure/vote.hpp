@@ -19,6 +19,8 @@ public:
 	vote (nano::vote const &) = default;
 	vote (bool & error, nano::stream &);
 	vote (nano::account const &, nano::raw_key const &, nano::millis_t timestamp, uint8_t duration, std::vector<nano::block_hash> const & hashes);
+	/** Creates an unsigned vote, the signature must be set before the vote is used */
+	vote (nano::account const &, nano::millis_t timestamp, uint8_t duration, std::vector<nano::block_hash> const & hashes);
 
 	void serialize (nano::stream &) const;
 	/**
@@ -1,4 +1,5 @@
 #include <nano/crypto_lib/random_pool.hpp>
+#include <nano/lib/block_uniquer.hpp>
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/logging.hpp>
 #include <nano/lib/thread_runner.hpp>
@@ -2085,6 +2086,64 @@ TEST (node, wallet_create_block_confirm_conflicts)
 	}
 }
 
+/**
+ * Measures uniquer throughput with many network threads deduplicating overlapping blocks
+ */
+TEST (block_uniquer, perf_concurrent)
+{
+	nano::keypair key;
+	nano::state_block_builder builder;
+	auto block = builder
+				 .account (0)
+				 .previous (0)
+				 .representative (0)
+				 .balance (0)
+				 .link (0)
+				 .sign (key.prv, key.pub)
+				 .work (0)
+				 .build ();
+
+	const int thread_count = 12;
+	const int block_count = 200000;
+
+	// Each thread receives the same blocks in a different order, as if relayed by different peers
+	std::vector<std::vector<std::shared_ptr<nano::block>>> blocks (thread_count);
+	for (int index = 0; index < thread_count; ++index)
+	{
+		for (uint64_t work = 0; work < block_count; ++work)
+		{
+			auto copy = std::make_shared<nano::state_block> (*block);
+			copy->block_work_set ((work * 7919 + index * 104729) % block_count + index % 2 * block_count);
+			blocks[index].push_back (copy);
+		}
+	}
+
+	nano::block_uniquer uniquer;
+	std::vector<std::thread> threads;
+	auto const start = std::chrono::steady_clock::now ();
+	for (int index = 0; index < thread_count; ++index)
+	{
+		threads.emplace_back ([&uniquer, &blocks, index] () {
+			for (auto & item : blocks[index])
+			{
+				item = uniquer.unique (item);
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+	auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+
+	auto const calls = uint64_t{ thread_count } * block_count;
+	std::cout << "deduplicated " << calls << " blocks in " << elapsed.count () << " ms (" << calls * 1000 / std::max<int64_t> (elapsed.count (), 1) << " per second)" << std::endl;
+
+	// Half of the threads share each set of blocks
+	ASSERT_EQ (uniquer.size (), 2 * block_count);
+	ASSERT_EQ (blocks[0][0], uniquer.unique (std::make_shared<nano::state_block> (*std::static_pointer_cast<nano::state_block> (blocks[0][0]))));
+}
+
 namespace nano
 {
 /**
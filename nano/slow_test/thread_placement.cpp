@@ -0,0 +1,113 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/thread_placement.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/node/block_processor.hpp>
+#include <nano/secure/ledger.hpp>
+#include <nano/test_common/system.hpp>
+#include <nano/test_common/testutil.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+/** Roles on the path of a block from the network into the ledger */
+std::vector<nano::thread_role::name> const ingest_roles{
+	nano::thread_role::name::io,
+	nano::thread_role::name::block_processing,
+	nano::thread_role::name::ledger_notifications,
+	nano::thread_role::name::confirmation_height,
+};
+
+/** Places the block_processing thread on \p block_processing_cpus and the other ingest roles on \p other_cpus , empty lists leave all roles unplaced */
+void place (std::string const & block_processing_cpus, std::string const & other_cpus)
+{
+	nano::thread_placement_config config;
+	config.enable = !block_processing_cpus.empty ();
+	if (config.enable)
+	{
+		for (auto role : ingest_roles)
+		{
+			config.roles[role] = role == nano::thread_role::name::block_processing ? block_processing_cpus : other_cpus;
+		}
+	}
+	nano::thread_placement::apply (config);
+}
+
+/** Prints the blocks per second processed by a node started after placing its threads */
+void report_block_processing (std::string const & label, std::vector<std::shared_ptr<nano::block>> const & blocks, std::string const & block_processing_cpus, std::string const & other_cpus)
+{
+	place (block_processing_cpus, other_cpus);
+	nano::test::system system;
+	auto config = system.default_config ();
+	config.backlog_scan.enable = false;
+	auto & node = *system.add_node (config);
+
+	auto const start = std::chrono::steady_clock::now ();
+	for (auto const & block : blocks)
+	{
+		node.block_processor.add (block);
+	}
+	ASSERT_TIMELY_EQ (120s, node.ledger.block_count (), blocks.size () + 1);
+	auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+	std::cout << label << ": " << blocks.size () * 1000ULL / std::max<int64_t> (elapsed.count (), 1) << " blocks/s" << std::endl;
+}
+}
+
+/**
+ * Compares block processing throughput of a node with unplaced threads, with the ingest roles on one NUMA node and with
+ * block processing on a different NUMA node than the other ingest roles
+ */
+TEST (thread_placement, perf_block_processing)
+{
+	auto const node0 = nano::thread_role::numa_node_cpus (0);
+	auto const node1 = nano::thread_role::numa_node_cpus (1);
+	if (node0.empty ())
+	{
+		GTEST_SKIP () << "Needs NUMA topology information" << std::endl;
+	}
+
+#ifndef NDEBUG
+	auto const block_count = 5000;
+#else
+	auto const block_count = 50000;
+#endif
+	nano::test::system system;
+	nano::block_builder builder;
+	std::vector<std::shared_ptr<nano::block>> blocks;
+	auto previous = nano::dev::genesis->hash ();
+	for (auto i = 0; i < block_count; ++i)
+	{
+		auto send = builder.state ()
+					.account (nano::dev::genesis_key.pub)
+					.previous (previous)
+					.representative (nano::dev::genesis_key.pub)
+					.balance (nano::dev::constants.genesis_amount - i - 1)
+					.link (nano::dev::genesis_key.pub)
+					.sign (nano::dev::genesis_key.prv, nano::dev::genesis_key.pub)
+					.work (*system.work.generate (previous))
+					.build ();
+		previous = send->hash ();
+		blocks.push_back (send);
+	}
+
+	report_block_processing ("unplaced", blocks, "", "");
+	report_block_processing ("same node", blocks, "numa:0", "numa:0");
+	if (!node1.empty ())
+	{
+		report_block_processing ("cross node", blocks, "numa:1", "numa:0");
+	}
+	else
+	{
+		std::cout << "single NUMA node, cross node throughput not measured" << std::endl;
+	}
+
+	nano::thread_placement::apply ({});
+}
@@ -1,5 +1,6 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/node/active_elections.hpp>
+#include <nano/node/vote_cache.hpp>
 #include <nano/node/vote_router.hpp>
 #include <nano/test_common/rate_observer.hpp>
 #include <nano/test_common/system.hpp>
@@ -250,3 +251,68 @@ TEST (vote_cache, perf_multithreaded)
 	// Ensure vote cache size is at max capacity
 	ASSERT_EQ (node.vote_cache.size (), config.vote_cache.max_size);
 }
+
+/*
+ * Inserts votes for unknown blocks directly into the vote cache from multiple threads, while another thread keeps querying top entries
+ * Simulates a vote flood, where every vote_processor thread inserts into the cache
+ */
+TEST (vote_cache, perf_concurrent_insert)
+{
+	nano::test::system system;
+	nano::vote_cache_config config;
+	nano::vote_cache vote_cache{ config, system.stats };
+	vote_cache.rep_weight_query = [] (nano::account const & rep) { return nano::uint128_t{ rep.qwords[0] % 1024 } * nano::Knano_ratio; };
+
+	const int thread_count = 12;
+	const int rep_count = 64;
+	const int vote_count = 200000 / thread_count;
+	const int single_vote_size = 7;
+
+	std::vector<nano::keypair> reps (rep_count);
+	// Votes are signed upfront, so only the cache is measured
+	std::vector<std::vector<std::shared_ptr<nano::vote>>> votes (thread_count);
+	for (int index = 0; index < thread_count; ++index)
+	{
+		for (int n = 0; n < vote_count; ++n)
+		{
+			std::vector<nano::block_hash> hashes;
+			for (int i = 0; i < single_vote_size; ++i)
+			{
+				// Reuse some hashes, so both new entries and updates are exercised
+				hashes.push_back (n % 4 == 0 && n > 0 ? votes[index][n - 1]->hashes[i] : nano::test::random_hash ());
+			}
+			votes[index].push_back (nano::test::make_vote (reps[(index + n) % rep_count], hashes));
+		}
+	}
+
+	std::cout << "preparation done" << std::endl;
+
+	std::atomic<bool> done{ false };
+	std::atomic<uint64_t> top_queries{ 0 };
+	std::thread top_thread ([&] () {
+		while (!done)
+		{
+			vote_cache.top (0);
+			++top_queries;
+		}
+	});
+
+	auto const start = std::chrono::steady_clock::now ();
+	run_parallel (thread_count, [&vote_cache, &votes] (int index) {
+		for (auto const & vote : votes[index])
+		{
+			vote_cache.insert (vote);
+		}
+	});
+	auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds> (std::chrono::steady_clock::now () - start);
+
+	done = true;
+	top_thread.join ();
+
+	auto const inserted = thread_count * vote_count * single_vote_size;
+	std::cout << "inserted " << inserted << " hashes in " << elapsed.count () << " ms (" << inserted * 1000ULL / std::max<int64_t> (elapsed.count (), 1) << " per second), top queries: " << top_queries << std::endl;
+
+	ASSERT_EQ (vote_cache.size (), config.max_size);
+	auto tops = vote_cache.top (0);
+	ASSERT_EQ (tops.size (), vote_cache.size ());
+}
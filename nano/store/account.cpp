@@ -2,6 +2,8 @@
 #include <nano/store/reverse_iterator_templ.hpp>
 #include <nano/store/typed_iterator_templ.hpp>
 
+#include <algorithm>
+
 template class nano::store::typed_iterator<nano::account, nano::account_info>;
 template class nano::store::reverse_iterator<nano::store::typed_iterator<nano::account, nano::account_info>>;
 
@@ -19,6 +21,20 @@ std::optional<nano::account_info> nano::store::account::get (store::transaction
 	}
 }
 
+std::vector<std::optional<nano::account_info>> nano::store::account::get_sorted (store::transaction const & transaction, std::span<nano::account const> accounts)
+{
+	debug_assert (std::is_sorted (accounts.begin (), accounts.end ()));
+
+	// Sorted point lookups touch neighbouring pages in order, backends with a native batched read override this
+	std::vector<std::optional<nano::account_info>> result;
+	result.reserve (accounts.size ());
+	for (auto const & account : accounts)
+	{
+		result.push_back (get (transaction, account));
+	}
+	return result;
+}
+
 auto nano::store::account::rbegin (store::transaction const & tx) const -> reverse_iterator
 {
 	auto iter = end (tx);
@@ -7,6 +7,9 @@
 #include <nano/store/typed_iterator.hpp>
 
 #include <functional>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace nano
 {
@@ -28,6 +31,8 @@ public:
 	virtual void put (write_transaction const & tx, nano::account const &, nano::account_info const &) = 0;
 	virtual bool get (transaction const & tx, nano::account const &, nano::account_info &) = 0;
 	std::optional<nano::account_info> get (transaction const & tx, nano::account const &);
+	/** Looks up many accounts at once, \p accounts must be sorted in ascending order and results are returned in the same order */
+	virtual std::vector<std::optional<nano::account_info>> get_sorted (transaction const & tx, std::span<nano::account const> accounts);
 	virtual void del (write_transaction const & tx, nano::account const &) = 0;
 	virtual bool exists (transaction const & tx, nano::account const &) = 0;
 	virtual size_t count (transaction const & tx) = 0;
@@ -26,6 +26,7 @@ public:
 
 public:
 	virtual void put (write_transaction const & tx, nano::block_hash const &, nano::block const &) = 0;
+	/** Stores a value in the canonical block + sideband format, backends are free to re-encode it */
 	virtual void raw_put (write_transaction const & tx, std::vector<uint8_t> const &, nano::block_hash const &) = 0;
 	virtual std::optional<nano::block_hash> successor (transaction const & tx, nano::block_hash const &) const = 0;
 	virtual void successor_clear (write_transaction const & tx, nano::block_hash const &) = 0;
@@ -0,0 +1,192 @@
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/stream.hpp>
+#include <nano/store/block_encoding.hpp>
+
+#include <limits>
+
+bool nano::store::block_encoding::is_compact (uint8_t const * data, size_t size)
+{
+	debug_assert (size > 0);
+	return (data[0] & compact_tag) != 0;
+}
+
+nano::block_type nano::store::block_encoding::type (uint8_t const * data, size_t size)
+{
+	debug_assert (size > 0);
+	// The block type is the first byte in both layouts
+	return static_cast<nano::block_type> (data[0] & ~compact_tag);
+}
+
+size_t nano::store::block_encoding::successor_position (uint8_t const * data, size_t size)
+{
+	if (is_compact (data, size))
+	{
+		return successor_offset;
+	}
+	// The canonical format stores the successor as the first sideband field, after the block
+	return size - nano::block_sideband::size (type (data, size));
+}
+
+bool nano::store::block_encoding::has_account (nano::block_type type)
+{
+	return type != nano::block_type::state && type != nano::block_type::open;
+}
+
+bool nano::store::block_encoding::has_balance (nano::block_type type)
+{
+	return type == nano::block_type::receive || type == nano::block_type::change || type == nano::block_type::open;
+}
+
+std::vector<uint8_t> nano::store::block_encoding::encode (nano::block const & block)
+{
+	auto const type = block.type ();
+	auto const & sideband = block.sideband ();
+
+	uint8_t flags_l = 0;
+	if (sideband.height == 1)
+	{
+		flags_l |= height_implicit;
+	}
+	else if (sideband.height <= std::numeric_limits<uint32_t>::max ())
+	{
+		flags_l |= height_narrow;
+	}
+	if (sideband.timestamp <= std::numeric_limits<uint32_t>::max ())
+	{
+		flags_l |= timestamp_narrow;
+	}
+	if (type == nano::block_type::state && sideband.source_epoch != nano::epoch::epoch_0)
+	{
+		flags_l |= source_epoch_present;
+	}
+
+	std::vector<uint8_t> result;
+	{
+		nano::vectorstream stream (result);
+		nano::write (stream, static_cast<uint8_t> (compact_tag | static_cast<uint8_t> (type)));
+		nano::write (stream, sideband.successor.bytes);
+		nano::write (stream, flags_l);
+		if (flags_l & height_narrow)
+		{
+			nano::write (stream, boost::endian::native_to_big (static_cast<uint32_t> (sideband.height)));
+		}
+		else if (!(flags_l & height_implicit))
+		{
+			nano::write (stream, boost::endian::native_to_big (sideband.height));
+		}
+		if (flags_l & timestamp_narrow)
+		{
+			nano::write (stream, boost::endian::native_to_big (static_cast<uint32_t> (sideband.timestamp)));
+		}
+		else
+		{
+			nano::write (stream, boost::endian::native_to_big (sideband.timestamp));
+		}
+		if (has_account (type))
+		{
+			nano::write (stream, sideband.account.bytes);
+		}
+		if (has_balance (type))
+		{
+			nano::write (stream, sideband.balance.bytes);
+		}
+		if (type == nano::block_type::state)
+		{
+			sideband.details.serialize (stream);
+			if (flags_l & source_epoch_present)
+			{
+				nano::write (stream, static_cast<uint8_t> (sideband.source_epoch));
+			}
+		}
+		block.serialize (stream);
+	}
+	return result;
+}
+
+std::vector<uint8_t> nano::store::block_encoding::encode (std::vector<uint8_t> const & canonical)
+{
+	if (is_compact (canonical.data (), canonical.size ()))
+	{
+		return canonical;
+	}
+	auto decoded = decode (canonical.data (), canonical.size ());
+	return encode (*decoded.block);
+}
+
+nano::store::block_w_sideband nano::store::block_encoding::decode (uint8_t const * data, size_t size)
+{
+	nano::bufferstream stream (data, size);
+	nano::store::block_w_sideband result;
+	if (!is_compact (data, size))
+	{
+		result.block = nano::deserialize_block (stream);
+		release_assert (result.block != nullptr);
+		auto error = result.sideband.deserialize (stream, result.block->type ());
+		release_assert (!error);
+	}
+	else
+	{
+		auto const type_l = type (data, size);
+		try
+		{
+			uint8_t tag{ 0 };
+			nano::read (stream, tag);
+			nano::read (stream, result.sideband.successor.bytes);
+			uint8_t flags_l{ 0 };
+			nano::read (stream, flags_l);
+			if (flags_l & height_implicit)
+			{
+				result.sideband.height = 1;
+			}
+			else if (flags_l & height_narrow)
+			{
+				uint32_t height{ 0 };
+				nano::read (stream, height);
+				result.sideband.height = boost::endian::big_to_native (height);
+			}
+			else
+			{
+				nano::read (stream, result.sideband.height);
+				boost::endian::big_to_native_inplace (result.sideband.height);
+			}
+			if (flags_l & timestamp_narrow)
+			{
+				uint32_t timestamp{ 0 };
+				nano::read (stream, timestamp);
+				result.sideband.timestamp = boost::endian::big_to_native (timestamp);
+			}
+			else
+			{
+				nano::read (stream, result.sideband.timestamp);
+				boost::endian::big_to_native_inplace (result.sideband.timestamp);
+			}
+			if (has_account (type_l))
+			{
+				nano::read (stream, result.sideband.account.bytes);
+			}
+			if (has_balance (type_l))
+			{
+				nano::read (stream, result.sideband.balance.bytes);
+			}
+			if (type_l == nano::block_type::state)
+			{
+				auto error = result.sideband.details.deserialize (stream);
+				release_assert (!error);
+				if (flags_l & source_epoch_present)
+				{
+					uint8_t source_epoch{ 0 };
+					nano::read (stream, source_epoch);
+					result.sideband.source_epoch = static_cast<nano::epoch> (source_epoch);
+				}
+			}
+		}
+		catch (std::runtime_error const &)
+		{
+			release_assert (false, "malformed compact block value");
+		}
+		result.block = nano::deserialize_block (stream, type_l);
+		release_assert (result.block != nullptr);
+	}
+	result.block->sideband_set (result.sideband);
+	return result;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <nano/lib/block_type.hpp>
+#include <nano/store/block_w_sideband.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nano
+{
+class block;
+}
+namespace nano::store
+{
+/**
+ * Compact value encoding for the blocks table, written by the RocksDB backend.
+ *
+ * Layout: [tag | type] [successor] [flags] [height] [timestamp] [account] [balance] [details] [source_epoch] [block]
+ *
+ * The first byte is the block type with `compact_tag` set, which lets readers tell compact values apart from
+ * values in the canonical block + sideband format, so both can coexist in a database during migration.
+ * The successor is stored at a fixed offset so it can be patched in place.
+ * Height is omitted for the first block of an account and, like the timestamp, narrowed to 32 bits when it fits.
+ * Account and balance are only stored for legacy block types and the source epoch only for state receives,
+ * every other field is derivable from the block itself.
+ */
+class block_encoding final
+{
+public:
+	static uint8_t constexpr compact_tag = 0x80;
+	static size_t constexpr successor_offset = 1;
+
+	/** Returns true if the value is in the compact layout */
+	static bool is_compact (uint8_t const * data, size_t size);
+	/** Block type of a value in either layout */
+	static nano::block_type type (uint8_t const * data, size_t size);
+	/** Offset of the successor field of a value in either layout */
+	static size_t successor_position (uint8_t const * data, size_t size);
+
+	/** Encodes a block with its sideband in the compact layout */
+	static std::vector<uint8_t> encode (nano::block const &);
+	/** Converts a value in the canonical block + sideband format to the compact layout, compact values are returned unchanged */
+	static std::vector<uint8_t> encode (std::vector<uint8_t> const & canonical);
+	/** Decodes a value in either layout */
+	static nano::store::block_w_sideband decode (uint8_t const * data, size_t size);
+
+private:
+	enum flags : uint8_t
+	{
+		height_implicit = 1 << 0,
+		height_narrow = 1 << 1,
+		timestamp_narrow = 1 << 2,
+		source_epoch_present = 1 << 3,
+	};
+	static bool has_account (nano::block_type);
+	static bool has_balance (nano::block_type);
+};
+}
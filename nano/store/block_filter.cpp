@@ -0,0 +1,240 @@
+#include <nano/lib/utility.hpp>
+#include <nano/store/block_filter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+/*
+ * block_filter::table
+ */
+
+nano::store::block_filter::table::table (size_t capacity_a, size_t bits_per_block) :
+	lines{ (std::max<size_t> (capacity_a * bits_per_block, 1) + line_words * 64 - 1) / (line_words * 64) },
+	// Optimal number of hashes is bits_per_block * ln 2, a 64-bit qword yields at most 7 9-bit positions
+	hash_count{ std::clamp<unsigned> (static_cast<unsigned> (std::lround (bits_per_block * 0.693)), 1, 7) },
+	capacity{ capacity_a }
+{
+	words = std::make_unique<std::atomic<uint64_t>[]> (lines * line_words);
+	for (size_t i = 0, n = lines * line_words; i < n; ++i)
+	{
+		words[i].store (0, std::memory_order_relaxed);
+	}
+}
+
+size_t nano::store::block_filter::table::line_index (nano::block_hash const & hash) const
+{
+	return hash.qwords[0] % lines;
+}
+
+auto nano::store::block_filter::table::mask (nano::block_hash const & hash) const -> line_mask
+{
+	line_mask result{};
+	auto bits = hash.qwords[1];
+	for (unsigned i = 0; i < hash_count; ++i, bits >>= 9)
+	{
+		auto const position = bits & 511;
+		result[position / 64] |= uint64_t{ 1 } << (position % 64);
+	}
+	return result;
+}
+
+void nano::store::block_filter::table::insert (nano::block_hash const & hash)
+{
+	auto const line = &words[line_index (hash) * line_words];
+	auto const masks = mask (hash);
+	for (size_t i = 0; i < line_words; ++i)
+	{
+		if (masks[i] != 0)
+		{
+			line[i].fetch_or (masks[i], std::memory_order_relaxed);
+		}
+	}
+}
+
+bool nano::store::block_filter::table::may_contain (nano::block_hash const & hash) const
+{
+	auto const line = &words[line_index (hash) * line_words];
+	auto const masks = mask (hash);
+	for (size_t i = 0; i < line_words; ++i)
+	{
+		if ((line[i].load (std::memory_order_relaxed) & masks[i]) != masks[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * block_filter
+ */
+
+void nano::store::block_filter::reset (size_t capacity, size_t bits_per_block_a)
+{
+	debug_assert (capacity > 0);
+	debug_assert (bits_per_block_a > 0);
+	ready_m = false;
+	bits_per_block = bits_per_block_a;
+	next = nullptr;
+	std::lock_guard guard{ tables_mutex };
+	tables.clear ();
+	tables.push_back (std::make_unique<table> (capacity, bits_per_block));
+	current = tables.back ().get ();
+	erased = 0;
+}
+
+void nano::store::block_filter::ready_set ()
+{
+	debug_assert (current != nullptr);
+	ready_m = true;
+}
+
+bool nano::store::block_filter::ready () const
+{
+	return ready_m;
+}
+
+size_t nano::store::block_filter::capacity () const
+{
+	auto const table_l = current.load (std::memory_order_acquire);
+	return table_l != nullptr ? table_l->capacity : 0;
+}
+
+void nano::store::block_filter::grow_begin (size_t capacity)
+{
+	debug_assert (current != nullptr);
+	debug_assert (next == nullptr);
+	std::lock_guard guard{ tables_mutex };
+	tables.push_back (std::make_unique<table> (capacity, bits_per_block));
+	next.store (tables.back ().get (), std::memory_order_release);
+}
+
+void nano::store::block_filter::grow_end ()
+{
+	debug_assert (next != nullptr);
+	current.store (next.load (), std::memory_order_release);
+	next = nullptr;
+	// Hashes of deleted blocks were not carried over
+	erased = 0;
+}
+
+void nano::store::block_filter::grow_abort ()
+{
+	next = nullptr;
+}
+
+void nano::store::block_filter::insert (nano::block_hash const & hash)
+{
+	// Blocks written before the filter is sized, e.g. while initializing a new ledger, are picked up when it is populated
+	if (auto const table_l = current.load (std::memory_order_acquire))
+	{
+		table_l->insert (hash);
+	}
+	if (auto const table_l = next.load (std::memory_order_acquire))
+	{
+		table_l->insert (hash);
+	}
+}
+
+void nano::store::block_filter::erase (nano::block_hash const & hash)
+{
+	if (current.load (std::memory_order_relaxed) != nullptr)
+	{
+		++erased;
+	}
+}
+
+bool nano::store::block_filter::may_contain (nano::block_hash const & hash) const
+{
+	if (!ready_m.load (std::memory_order_acquire))
+	{
+		return true;
+	}
+	if (!current.load (std::memory_order_acquire)->may_contain (hash))
+	{
+		filtered.fetch_add (1, std::memory_order_relaxed);
+		return false;
+	}
+	return true;
+}
+
+void nano::store::block_filter::false_positive () const
+{
+	if (ready_m.load (std::memory_order_relaxed))
+	{
+		false_positives.fetch_add (1, std::memory_order_relaxed);
+	}
+}
+
+bool nano::store::block_filter::save (std::filesystem::path const & path, uint64_t tag) const
+{
+	if (!ready_m)
+	{
+		return true;
+	}
+	auto const & table_l = *current.load ();
+	std::ofstream stream{ path, std::ios::binary | std::ios::trunc };
+	uint64_t const header[] = { file_magic, file_version, tag, table_l.lines, table_l.hash_count };
+	stream.write (reinterpret_cast<char const *> (header), sizeof (header));
+	for (size_t i = 0, n = table_l.lines * line_words; i < n && stream; ++i)
+	{
+		auto const word = table_l.words[i].load (std::memory_order_relaxed);
+		stream.write (reinterpret_cast<char const *> (&word), sizeof (word));
+	}
+	return !stream;
+}
+
+bool nano::store::block_filter::load (std::filesystem::path const & path, uint64_t tag)
+{
+	debug_assert (!ready_m);
+	auto & table_l = *current.load ();
+	std::ifstream stream{ path, std::ios::binary };
+	uint64_t header[5] = {};
+	stream.read (reinterpret_cast<char *> (header), sizeof (header));
+	if (!stream || header[0] != file_magic || header[1] != file_version || header[2] != tag || header[3] != table_l.lines || header[4] != table_l.hash_count)
+	{
+		return true;
+	}
+	for (size_t i = 0, n = table_l.lines * line_words; i < n; ++i)
+	{
+		uint64_t word{ 0 };
+		stream.read (reinterpret_cast<char *> (&word), sizeof (word));
+		if (!stream)
+		{
+			return true;
+		}
+		// Blocks inserted while loading must be kept
+		table_l.words[i].fetch_or (word, std::memory_order_relaxed);
+	}
+	return false;
+}
+
+size_t nano::store::block_filter::memory_usage () const
+{
+	std::lock_guard guard{ tables_mutex };
+	size_t result = 0;
+	for (auto const & table_l : tables)
+	{
+		result += table_l->lines * line_words * sizeof (uint64_t);
+	}
+	return result;
+}
+
+auto nano::store::block_filter::counters_get () const -> counters
+{
+	return { filtered.load (), false_positives.load (), erased.load () };
+}
+
+nano::container_info nano::store::block_filter::container_info () const
+{
+	nano::container_info info;
+	auto const table_l = current.load ();
+	info.put ("lines", table_l != nullptr ? table_l->lines : 0, line_words * sizeof (uint64_t));
+	{
+		std::lock_guard guard{ tables_mutex };
+		info.put ("tables", tables.size ());
+	}
+	info.put ("erased", erased.load ());
+	return info;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <nano/lib/container_info.hpp>
+#include <nano/lib/numbers.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nano::store
+{
+/**
+ * Blocked bloom filter over the hashes in the blocks table, used to answer negative existence checks without a database lookup.
+ * Each hash maps to a single 512-bit cache line and sets up to 7 bits within it, so a query touches exactly one cache line.
+ * Block hashes are already uniformly distributed, the line index and bit positions are taken directly from the hash.
+ * Deleted hashes cannot be removed from the filter, they only add to the false positive rate until the filter is rebuilt.
+ * The filter answers "maybe" for every query until it is marked ready, which allows populating it in the background.
+ * Growing fills a larger table next to the current one, insertions go to both and queries keep using the current table until the
+ * larger one is complete. Replaced tables are kept until the next reset since concurrent queries may still read them, with the capacity
+ * at least doubling on each growth they take less memory than the current table.
+ * @note This class is thread-safe.
+ */
+class block_filter final
+{
+public:
+	/** Resizes and clears the filter, marking it not ready. Must not be called concurrently with insertions. */
+	void reset (size_t capacity, size_t bits_per_block);
+	void ready_set ();
+	bool ready () const;
+	/** Number of blocks the current table was sized for */
+	size_t capacity () const;
+
+	/** Starts filling a table sized for \p capacity, which replaces the current one once complete. Must not be called concurrently with itself or reset. */
+	void grow_begin (size_t capacity);
+	/** Replaces the current table with the one being filled, every block must have been inserted since grow_begin */
+	void grow_end ();
+	/** Drops the table being filled */
+	void grow_abort ();
+
+	void insert (nano::block_hash const &);
+	/** Records a deletion, the hash stays in the filter */
+	void erase (nano::block_hash const &);
+	/** Returns false if the hash is definitely not in the blocks table */
+	bool may_contain (nano::block_hash const &) const;
+	/** Called when a lookup that passed the filter did not find the block */
+	void false_positive () const;
+
+	/** Writes the filter to \p path , \p tag identifies the ledger state it was saved for. Returns true on error */
+	bool save (std::filesystem::path const & path, uint64_t tag) const;
+	/** Reads the filter from \p path if it was saved with a matching \p tag and geometry. Returns true on error */
+	bool load (std::filesystem::path const & path, uint64_t tag);
+
+	size_t memory_usage () const;
+
+	struct counters
+	{
+		uint64_t filtered; // Negative lookups answered by the filter
+		uint64_t false_positives; // Lookups that passed the filter but missed in the store
+		uint64_t erased; // Stale hashes left in the filter
+	};
+	counters counters_get () const;
+
+	nano::container_info container_info () const;
+
+public:
+	static size_t constexpr line_words = 8; // 512-bit lines
+
+private:
+	using line_mask = std::array<uint64_t, line_words>;
+
+	class table final
+	{
+	public:
+		table (size_t capacity, size_t bits_per_block);
+
+		void insert (nano::block_hash const &);
+		bool may_contain (nano::block_hash const &) const;
+
+		std::unique_ptr<std::atomic<uint64_t>[]> words;
+		size_t const lines;
+		unsigned const hash_count;
+		size_t const capacity;
+
+	private:
+		size_t line_index (nano::block_hash const &) const;
+		line_mask mask (nano::block_hash const &) const;
+	};
+
+private:
+	static uint64_t constexpr file_magic = 0x6e616e6f626c6f6f; // "nanobloo"
+	static uint64_t constexpr file_version = 1;
+
+	std::atomic<table *> current{ nullptr };
+	std::atomic<table *> next{ nullptr };
+	/** Owns the current table, the one being filled and the replaced ones */
+	std::vector<std::unique_ptr<table>> tables;
+	mutable std::mutex tables_mutex;
+	size_t bits_per_block{ 0 };
+	std::atomic<bool> ready_m{ false };
+
+	mutable std::atomic<uint64_t> filtered{ 0 };
+	mutable std::atomic<uint64_t> false_positives{ 0 };
+	std::atomic<uint64_t> erased{ 0 };
+};
+}
@@ -4,6 +4,7 @@
 #include <nano/lib/memory.hpp>
 #include <nano/secure/common.hpp>
 #include <nano/secure/fwd.hpp>
+#include <nano/store/block_filter.hpp>
 #include <nano/store/fwd.hpp>
 #include <nano/store/tables.hpp>
 #include <nano/store/transaction.hpp>
@@ -14,12 +15,17 @@
 #include <boost/polymorphic_cast.hpp>
 #include <boost/property_tree/ptree.hpp>
 
+#include <functional>
 #include <stack>
+#include <vector>
 
 namespace nano
 {
 namespace store
 {
+	/** Produces the next entry of a sorted key range, returns false once the range is exhausted */
+	using bulk_source = std::function<bool (std::vector<uint8_t> & key, std::vector<uint8_t> & value)>;
+
 	/**
 	 * Store manager
 	 */
@@ -70,12 +76,23 @@ namespace store
 	public: // TODO: Shouldn't be public
 		store::write_queue write_queue;
 
+	public:
+		/** Negative lookup filter for the blocks table, populated by nano::block_filter_service */
+		store::block_filter block_filter;
+
 	public:
 		virtual unsigned max_block_write_batch_num () const = 0;
 
 		virtual bool copy_db (std::filesystem::path const & destination) = 0;
 		virtual void rebuild_db (write_transaction const & transaction_a) = 0;
 
+		/**
+		 * Loads entries into an empty table using the backend's sequential write path.
+		 * Sources must cover ascending, non-overlapping key ranges and produce keys in ascending order, values are in the canonical format.
+		 * Returns true on error
+		 */
+		virtual bool bulk_load (tables, std::vector<bulk_source> const &) = 0;
+
 		/** Not applicable to all sub-classes */
 		virtual void serialize_mdb_tracker (::boost::property_tree::ptree &, std::chrono::milliseconds, std::chrono::milliseconds){};
 		virtual void serialize_memory_stats (::boost::property_tree::ptree &) = 0;
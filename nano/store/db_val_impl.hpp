@@ -3,6 +3,7 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/secure/account_info.hpp>
 #include <nano/secure/pending_info.hpp>
+#include <nano/store/block_encoding.hpp>
 #include <nano/store/db_val.hpp>
 
 template <typename T>
@@ -71,13 +72,8 @@ nano::store::db_val<T>::operator std::shared_ptr<nano::block> () const
 template <typename T>
 nano::store::db_val<T>::operator nano::store::block_w_sideband () const
 {
-	nano::bufferstream stream (reinterpret_cast<uint8_t const *> (data ()), size ());
-	nano::store::block_w_sideband block_w_sideband;
-	block_w_sideband.block = (nano::deserialize_block (stream));
-	auto error = block_w_sideband.sideband.deserialize (stream, block_w_sideband.block->type ());
-	release_assert (!error);
-	block_w_sideband.block->sideband_set (block_w_sideband.sideband);
-	return block_w_sideband;
+	// Accepts both the canonical block + sideband format and the compact layout written by RocksDB
+	return nano::store::block_encoding::decode (reinterpret_cast<uint8_t const *> (data ()), size ());
 }
 
 template <typename T>
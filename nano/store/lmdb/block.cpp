@@ -47,6 +47,7 @@ void nano::store::lmdb::block::raw_put (store::write_transaction const & transac
 	nano::store::lmdb::db_val value{ data.size (), (void *)data.data () };
 	auto status = store.put (transaction_a, tables::blocks, hash_a, value);
 	store.release_assert_success (status);
+	store.block_filter.insert (hash_a);
 }
 
 std::optional<nano::block_hash> nano::store::lmdb::block::successor (store::transaction const & transaction_a, nano::block_hash const & hash_a) const
@@ -87,10 +88,18 @@ void nano::store::lmdb::block::successor_clear (store::write_transaction const &
 
 std::shared_ptr<nano::block> nano::store::lmdb::block::get (store::transaction const & transaction, nano::block_hash const & hash) const
 {
+	if (!store.block_filter.may_contain (hash))
+	{
+		return nullptr;
+	}
 	nano::store::lmdb::db_val value;
 	block_raw_get (transaction, hash, value);
 	std::shared_ptr<nano::block> result;
-	if (value.size () != 0)
+	if (value.size () == 0)
+	{
+		store.block_filter.false_positive ();
+	}
+	else
 	{
 		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
 		nano::block_type type;
@@ -110,11 +119,21 @@ void nano::store::lmdb::block::del (store::write_transaction const & transaction
 {
 	auto status = store.del (transaction_a, tables::blocks, hash_a);
 	store.release_assert_success (status);
+	store.block_filter.erase (hash_a);
 }
 
 bool nano::store::lmdb::block::exists (store::transaction const & transaction, nano::block_hash const & hash)
 {
-	return store.exists (transaction, tables::blocks, hash);
+	if (!store.block_filter.may_contain (hash))
+	{
+		return false;
+	}
+	auto result = store.exists (transaction, tables::blocks, hash);
+	if (!result)
+	{
+		store.block_filter.false_positive ();
+	}
+	return result;
 }
 
 uint64_t nano::store::lmdb::block::count (store::transaction const & transaction_a)
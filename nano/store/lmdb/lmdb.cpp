@@ -499,6 +499,34 @@ void nano::store::lmdb::component::rebuild_db (store::write_transaction const &
 	}
 }
 
+bool nano::store::lmdb::component::bulk_load (tables table_a, std::vector<store::bulk_source> const & sources_a)
+{
+	auto transaction = tx_begin_write ();
+	auto const dbi = table_to_dbi (table_a);
+	if (count (transaction, dbi) != 0)
+	{
+		logger.error (nano::log::type::lmdb, "Bulk load requires an empty table");
+		return true;
+	}
+	std::vector<uint8_t> key;
+	std::vector<uint8_t> value;
+	for (auto const & source : sources_a)
+	{
+		while (source (key, value))
+		{
+			// Sources are sorted, appending avoids page splits and keeps pages fully packed
+			auto status = mdb_put (env.tx (transaction), dbi, nano::store::lmdb::db_val{ key.size (), key.data () }, nano::store::lmdb::db_val{ value.size (), value.data () }, MDB_APPEND);
+			if (!success (status))
+			{
+				logger.error (nano::log::type::lmdb, "Bulk load failed: {}", error_string (status));
+				return true;
+			}
+			transaction.refresh_if_needed ();
+		}
+	}
+	return false;
+}
+
 bool nano::store::lmdb::component::init_error () const
 {
 	return error;
@@ -92,6 +92,7 @@ public:
 
 	bool copy_db (std::filesystem::path const & destination_file) override;
 	void rebuild_db (store::write_transaction const & transaction_a) override;
+	bool bulk_load (tables, std::vector<store::bulk_source> const &) override;
 
 	bool init_error () const override;
 
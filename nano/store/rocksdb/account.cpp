@@ -26,6 +26,40 @@ bool nano::store::rocksdb::account::get (store::transaction const & transaction,
 	return result;
 }
 
+std::vector<std::optional<nano::account_info>> nano::store::rocksdb::account::get_sorted (store::transaction const & transaction_a, std::span<nano::account const> accounts_a)
+{
+	debug_assert (std::is_sorted (accounts_a.begin (), accounts_a.end ()));
+
+	std::vector<::rocksdb::Slice> keys;
+	keys.reserve (accounts_a.size ());
+	for (auto const & account : accounts_a)
+	{
+		keys.emplace_back (reinterpret_cast<char const *> (account.bytes.data ()), account.bytes.size ());
+	}
+
+	std::vector<nano::store::rocksdb::db_val> values;
+	auto statuses = store.get (transaction_a, tables::accounts, keys, values);
+
+	std::vector<std::optional<nano::account_info>> result;
+	result.reserve (accounts_a.size ());
+	for (std::size_t i = 0; i < accounts_a.size (); ++i)
+	{
+		release_assert (store.success (statuses[i]) || store.not_found (statuses[i]));
+		std::optional<nano::account_info> entry;
+		if (store.success (statuses[i]))
+		{
+			nano::account_info info;
+			nano::bufferstream stream (reinterpret_cast<uint8_t const *> (values[i].data ()), values[i].size ());
+			if (!info.deserialize (stream))
+			{
+				entry = info;
+			}
+		}
+		result.push_back (entry);
+	}
+	return result;
+}
+
 void nano::store::rocksdb::account::del (store::write_transaction const & transaction_a, nano::account const & account_a)
 {
 	auto status = store.del (transaction_a, tables::accounts, account_a);
@@ -1,4 +1,5 @@
 #include <nano/secure/parallel_traversal.hpp>
+#include <nano/store/block_encoding.hpp>
 #include <nano/store/db_val_impl.hpp>
 #include <nano/store/rocksdb/block.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
@@ -31,13 +32,7 @@ nano::store::rocksdb::block::block (nano::store::rocksdb::component & store_a) :
 void nano::store::rocksdb::block::put (store::write_transaction const & transaction, nano::block_hash const & hash, nano::block const & block)
 {
 	debug_assert (block.sideband ().successor.is_zero () || exists (transaction, block.sideband ().successor));
-	std::vector<uint8_t> vector;
-	{
-		nano::vectorstream stream (vector);
-		nano::serialize_block (stream, block);
-		block.sideband ().serialize (stream, block.type ());
-	}
-	raw_put (transaction, vector, hash);
+	encoded_put (transaction, nano::store::block_encoding::encode (block), hash);
 	block_predecessor_rocksdb_set predecessor (transaction, *this);
 	block.visit (predecessor);
 	debug_assert (block.previous ().is_zero () || successor (transaction, block.previous ()) == hash);
@@ -45,9 +40,17 @@ void nano::store::rocksdb::block::put (store::write_transaction const & transact
 
 void nano::store::rocksdb::block::raw_put (store::write_transaction const & transaction_a, std::vector<uint8_t> const & data, nano::block_hash const & hash_a)
 {
+	// Values in the canonical block + sideband format are converted to the compact layout
+	encoded_put (transaction_a, nano::store::block_encoding::encode (data), hash_a);
+}
+
+void nano::store::rocksdb::block::encoded_put (store::write_transaction const & transaction_a, std::vector<uint8_t> const & data, nano::block_hash const & hash_a)
+{
+	debug_assert (nano::store::block_encoding::is_compact (data.data (), data.size ()));
 	nano::store::rocksdb::db_val value{ data.size (), (void *)data.data () };
 	auto status = store.put (transaction_a, tables::blocks, hash_a, value);
 	store.release_assert_success (status);
+	store.block_filter.insert (hash_a);
 }
 
 std::optional<nano::block_hash> nano::store::rocksdb::block::successor (store::transaction const & transaction_a, nano::block_hash const & hash_a) const
@@ -58,8 +61,7 @@ std::optional<nano::block_hash> nano::store::rocksdb::block::successor (store::t
 	if (value.size () != 0)
 	{
 		debug_assert (value.size () >= result.bytes.size ());
-		auto type = block_type_from_raw (value.data ());
-		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + block_successor_offset (transaction_a, value.size (), type), result.bytes.size ());
+		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()) + successor_position (value), result.bytes.size ());
 		auto error (nano::try_read (stream, result.bytes));
 		(void)error;
 		debug_assert (!error);
@@ -80,29 +82,27 @@ void nano::store::rocksdb::block::successor_clear (store::write_transaction cons
 	nano::store::rocksdb::db_val value;
 	block_raw_get (transaction, hash, value);
 	debug_assert (value.size () != 0);
-	auto type = block_type_from_raw (value.data ());
 	std::vector<uint8_t> data (static_cast<uint8_t *> (value.data ()), static_cast<uint8_t *> (value.data ()) + value.size ());
-	std::fill_n (data.begin () + block_successor_offset (transaction, value.size (), type), sizeof (nano::block_hash), uint8_t{ 0 });
+	std::fill_n (data.begin () + successor_position (value), sizeof (nano::block_hash), uint8_t{ 0 });
 	raw_put (transaction, data, hash);
 }
 
 std::shared_ptr<nano::block> nano::store::rocksdb::block::get (store::transaction const & transaction, nano::block_hash const & hash) const
 {
+	if (!store.block_filter.may_contain (hash))
+	{
+		return nullptr;
+	}
 	nano::store::rocksdb::db_val value;
 	block_raw_get (transaction, hash, value);
 	std::shared_ptr<nano::block> result;
-	if (value.size () != 0)
+	if (value.size () == 0)
 	{
-		nano::bufferstream stream (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
-		nano::block_type type;
-		auto error (try_read (stream, type));
-		release_assert (!error);
-		result = nano::deserialize_block (stream, type);
-		release_assert (result != nullptr);
-		nano::block_sideband sideband;
-		error = (sideband.deserialize (stream, type));
-		release_assert (!error);
-		result->sideband_set (sideband);
+		store.block_filter.false_positive ();
+	}
+	else
+	{
+		result = nano::store::block_encoding::decode (reinterpret_cast<uint8_t const *> (value.data ()), value.size ()).block;
 	}
 	return result;
 }
@@ -111,11 +111,21 @@ void nano::store::rocksdb::block::del (store::write_transaction const & transact
 {
 	auto status = store.del (transaction_a, tables::blocks, hash_a);
 	store.release_assert_success (status);
+	store.block_filter.erase (hash_a);
 }
 
 bool nano::store::rocksdb::block::exists (store::transaction const & transaction, nano::block_hash const & hash)
 {
-	return store.exists (transaction, tables::blocks, hash);
+	if (!store.block_filter.may_contain (hash))
+	{
+		return false;
+	}
+	auto result = store.exists (transaction, tables::blocks, hash);
+	if (!result)
+	{
+		store.block_filter.false_positive ();
+	}
+	return result;
 }
 
 uint64_t nano::store::rocksdb::block::count (store::transaction const & transaction_a)
@@ -154,15 +164,10 @@ void nano::store::rocksdb::block::block_raw_get (store::transaction const & tran
 	release_assert (store.success (status) || store.not_found (status));
 }
 
-size_t nano::store::rocksdb::block::block_successor_offset (store::transaction const & transaction_a, size_t entry_size_a, nano::block_type type_a) const
-{
-	return entry_size_a - nano::block_sideband::size (type_a);
-}
-
-nano::block_type nano::store::rocksdb::block::block_type_from_raw (void * data_a)
+size_t nano::store::rocksdb::block::successor_position (nano::store::rocksdb::db_val const & value)
 {
-	// The block type is the first byte
-	return static_cast<nano::block_type> ((reinterpret_cast<uint8_t const *> (data_a))[0]);
+	// Entries written before the compact layout was introduced are still in the canonical format
+	return nano::store::block_encoding::successor_position (reinterpret_cast<uint8_t const *> (value.data ()), value.size ());
 }
 
 nano::block_predecessor_rocksdb_set::block_predecessor_rocksdb_set (store::write_transaction const & transaction_a, nano::store::rocksdb::block & block_store_a) :
@@ -177,9 +182,8 @@ void nano::block_predecessor_rocksdb_set::fill_value (nano::block const & block_
 	nano::store::rocksdb::db_val value;
 	block_store.block_raw_get (transaction, block_a.previous (), value);
 	debug_assert (value.size () != 0);
-	auto type = block_store.block_type_from_raw (value.data ());
 	std::vector<uint8_t> data (static_cast<uint8_t *> (value.data ()), static_cast<uint8_t *> (value.data ()) + value.size ());
-	std::copy (hash.bytes.begin (), hash.bytes.end (), data.begin () + block_store.block_successor_offset (transaction, value.size (), type));
+	std::copy (hash.bytes.begin (), hash.bytes.end (), data.begin () + block_store.successor_position (value));
 	block_store.raw_put (transaction, data, block_a.previous ());
 }
 
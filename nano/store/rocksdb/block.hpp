@@ -35,7 +35,7 @@ public:
 
 protected:
 	void block_raw_get (store::transaction const & transaction_a, nano::block_hash const & hash_a, nano::store::rocksdb::db_val & value) const;
-	size_t block_successor_offset (store::transaction const & transaction_a, size_t entry_size_a, nano::block_type type_a) const;
-	static nano::block_type block_type_from_raw (void * data_a);
+	void encoded_put (store::write_transaction const & transaction_a, std::vector<uint8_t> const & data, nano::block_hash const & hash_a);
+	static size_t successor_position (nano::store::rocksdb::db_val const & value);
 };
 } // namespace nano::store::rocksdb
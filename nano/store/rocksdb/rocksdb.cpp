@@ -2,6 +2,9 @@
 #include <nano/lib/blocks.hpp>
 #include <nano/lib/files.hpp>
 #include <nano/lib/rocksdbconfig.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/threading.hpp>
+#include <nano/store/block_encoding.hpp>
 #include <nano/store/rocksdb/iterator.hpp>
 #include <nano/store/rocksdb/rocksdb.hpp>
 #include <nano/store/rocksdb/transaction_impl.hpp>
@@ -15,6 +18,7 @@
 #include <rocksdb/merge_operator.h>
 #include <rocksdb/slice.h>
 #include <rocksdb/slice_transform.h>
+#include <rocksdb/sst_file_writer.h>
 #include <rocksdb/utilities/backup_engine.h>
 #include <rocksdb/utilities/transaction.h>
 
@@ -67,6 +71,7 @@ nano::store::rocksdb::component::component (nano::logger & logger_a, std::filesy
 	constants{ constants },
 	rocksdb_config{ rocksdb_config_a },
 	max_block_write_batch_num_m{ nano::narrow_cast<unsigned> ((rocksdb_config_a.write_cache * 1024 * 1024) / (2 * (sizeof (nano::block_type) + nano::state_block::size + nano::block_sideband::size (nano::block_type::state)))) },
+	path{ path_a },
 	cf_name_table_map{ create_cf_name_table_map () }
 {
 	boost::system::error_code error_mkdir, error_chmod;
@@ -391,6 +396,17 @@ rocksdb::ColumnFamilyOptions nano::store::rocksdb::component::get_cf_options (st
 		// Size of each memtable (write buffer for this column family)
 		cf_options.write_buffer_size = rocksdb_config.write_cache * 1024 * 1024;
 	}
+	if (cf_name_a == "blocks" && rocksdb_config.block_compression == "zstd")
+	{
+		// Block values share a lot of structure (representatives, links, sideband fields), a dictionary trained on sampled blocks
+		// lets zstd exploit that even though individual values are small
+		cf_options.compression = ::rocksdb::kZSTD;
+		cf_options.compression_opts.max_dict_bytes = rocksdb_config.block_compression_dictionary * 1024;
+		cf_options.compression_opts.zstd_max_train_bytes = 100 * cf_options.compression_opts.max_dict_bytes;
+		cf_options.bottommost_compression = ::rocksdb::kZSTD;
+		cf_options.bottommost_compression_opts = cf_options.compression_opts;
+		cf_options.bottommost_compression_opts.enabled = true;
+	}
 	return cf_options;
 }
 
@@ -586,6 +602,46 @@ int nano::store::rocksdb::component::get (store::transaction const & transaction
 	return status.code ();
 }
 
+std::vector<int> nano::store::rocksdb::component::get (store::transaction const & transaction_a, tables table_a, std::span<::rocksdb::Slice const> keys_a, std::vector<nano::store::rocksdb::db_val> & values_a) const
+{
+	::rocksdb::ReadOptions options;
+	std::vector<::rocksdb::PinnableSlice> slices (keys_a.size ());
+	std::vector<::rocksdb::Status> statuses (keys_a.size ());
+	auto handle = table_to_column_family (table_a);
+	auto internals = rocksdb::tx (transaction_a);
+	std::visit ([&] (auto && ptr) {
+		using V = std::remove_cvref_t<decltype (ptr)>;
+		if constexpr (std::is_same_v<V, ::rocksdb::Transaction *>)
+		{
+			ptr->MultiGet (options, handle, keys_a.size (), keys_a.data (), slices.data (), statuses.data (), /* sorted_input */ true);
+		}
+		else if constexpr (std::is_same_v<V, ::rocksdb::ReadOptions *>)
+		{
+			db->MultiGet (*ptr, handle, keys_a.size (), keys_a.data (), slices.data (), statuses.data (), /* sorted_input */ true);
+		}
+		else
+		{
+			static_assert (sizeof (V) == 0, "Missing variant handler for type V");
+		}
+	},
+	internals);
+
+	std::vector<int> result;
+	result.reserve (keys_a.size ());
+	values_a.resize (keys_a.size ());
+	for (std::size_t i = 0; i < keys_a.size (); ++i)
+	{
+		if (statuses[i].ok ())
+		{
+			values_a[i].buffer = std::make_shared<std::vector<uint8_t>> (slices[i].size ());
+			std::memcpy (values_a[i].buffer->data (), slices[i].data (), slices[i].size ());
+			values_a[i].convert_buffer_to_value ();
+		}
+		result.push_back (statuses[i].code ());
+	}
+	return result;
+}
+
 int nano::store::rocksdb::component::put (store::write_transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a, nano::store::rocksdb::db_val const & value_a)
 {
 	debug_assert (transaction_a.contains (table_a));
@@ -854,6 +910,96 @@ void nano::store::rocksdb::component::rebuild_db (store::write_transaction const
 	// Not available for RocksDB
 }
 
+bool nano::store::rocksdb::component::bulk_load (tables table_a, std::vector<store::bulk_source> const & sources_a)
+{
+	auto const column_family = table_to_column_family (table_a);
+	{
+		std::unique_ptr<::rocksdb::Iterator> it{ db->NewIterator (::rocksdb::ReadOptions{}, column_family) };
+		it->SeekToFirst ();
+		if (it->Valid ())
+		{
+			logger.error (nano::log::type::rocksdb, "Bulk load requires an empty table");
+			return true;
+		}
+	}
+
+	// Each source is written to its own SST file in parallel, sources cover disjoint key ranges so the files can be ingested together
+	auto const options = db->GetOptions (column_family);
+	std::vector<std::string> files (sources_a.size ());
+	std::atomic<size_t> next{ 0 };
+	std::atomic<bool> error_l{ false };
+	auto write_files = [&] () {
+		nano::thread_role::set (nano::thread_role::name::db_parallel_traversal);
+		std::vector<uint8_t> key;
+		std::vector<uint8_t> value;
+		for (auto index = next++; index < sources_a.size () && !error_l; index = next++)
+		{
+			auto const file = (path / (boost::str (boost::format ("bulk_load_%1%_%2%.sst") % column_family->GetName () % index))).string ();
+			bool empty = true;
+			{
+				::rocksdb::SstFileWriter writer{ ::rocksdb::EnvOptions{}, options, column_family };
+				auto status = writer.Open (file);
+				while (status.ok () && sources_a[index] (key, value))
+				{
+					if (table_a == tables::blocks)
+					{
+						value = nano::store::block_encoding::encode (value);
+					}
+					status = writer.Put (::rocksdb::Slice{ reinterpret_cast<char const *> (key.data ()), key.size () }, ::rocksdb::Slice{ reinterpret_cast<char const *> (value.data ()), value.size () });
+					empty = false;
+				}
+				// Empty SST files cannot be finished
+				if (status.ok () && !empty)
+				{
+					status = writer.Finish ();
+				}
+				if (!status.ok ())
+				{
+					logger.error (nano::log::type::rocksdb, "Bulk load failed writing {}: {}", file, status.ToString ());
+					error_l = true;
+				}
+			}
+			if (empty)
+			{
+				std::error_code ec;
+				std::filesystem::remove (file, ec);
+			}
+			else
+			{
+				files[index] = file;
+			}
+		}
+	};
+	std::vector<std::thread> threads;
+	for (auto i = std::min<size_t> (sources_a.size (), nano::hardware_concurrency ()); i > 0; --i)
+	{
+		threads.emplace_back (write_files);
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+
+	std::erase_if (files, [] (auto const & file) { return file.empty (); });
+	if (!error_l && !files.empty ())
+	{
+		::rocksdb::IngestExternalFileOptions ingest_options;
+		ingest_options.move_files = true;
+		auto status = db->IngestExternalFile (column_family, files, ingest_options);
+		if (!status.ok ())
+		{
+			logger.error (nano::log::type::rocksdb, "Bulk load failed ingesting files: {}", status.ToString ());
+			error_l = true;
+		}
+	}
+	for (auto const & file : files)
+	{
+		std::error_code ec;
+		std::filesystem::remove (file, ec);
+	}
+	return error_l;
+}
+
 bool nano::store::rocksdb::component::init_error () const
 {
 	return error;
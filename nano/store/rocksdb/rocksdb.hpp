@@ -24,6 +24,8 @@
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/transaction_db.h>
 
+#include <span>
+
 namespace nano
 {
 class logging_mt;
@@ -75,6 +77,8 @@ public:
 
 	bool exists (store::transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a) const;
 	int get (store::transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a, nano::store::rocksdb::db_val & value_a) const;
+	/** Batched lookup of \p keys_a sorted in ascending order, fills \p values_a and returns the status of each lookup */
+	std::vector<int> get (store::transaction const & transaction_a, tables table_a, std::span<::rocksdb::Slice const> keys_a, std::vector<nano::store::rocksdb::db_val> & values_a) const;
 	int put (store::write_transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a, nano::store::rocksdb::db_val const & value_a);
 	int del (store::write_transaction const & transaction_a, tables table_a, nano::store::rocksdb::db_val const & key_a);
 
@@ -82,6 +86,7 @@ public:
 
 	bool copy_db (std::filesystem::path const & destination) override;
 	void rebuild_db (store::write_transaction const & transaction_a) override;
+	bool bulk_load (tables, std::vector<store::bulk_source> const &) override;
 
 	unsigned max_block_write_batch_num () const override;
 
@@ -98,6 +103,7 @@ private:
 	std::vector<std::unique_ptr<::rocksdb::ColumnFamilyHandle>> handles;
 	nano::rocksdb_config rocksdb_config;
 	unsigned const max_block_write_batch_num_m;
+	std::filesystem::path const path;
 
 	class tombstone_info
 	{
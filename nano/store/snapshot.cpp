@@ -0,0 +1,399 @@
+#include <nano/crypto/blake2/blake2.h>
+#include <nano/lib/blocks.hpp>
+#include <nano/lib/logging.hpp>
+#include <nano/lib/thread_roles.hpp>
+#include <nano/lib/threading.hpp>
+#include <nano/store/account.hpp>
+#include <nano/store/block.hpp>
+#include <nano/store/component.hpp>
+#include <nano/store/confirmation_height.hpp>
+#include <nano/store/db_val_impl.hpp>
+#include <nano/store/final_vote.hpp>
+#include <nano/store/lmdb/db_val.hpp>
+#include <nano/store/pending.hpp>
+#include <nano/store/pruned.hpp>
+#include <nano/store/rep_weight.hpp>
+#include <nano/store/snapshot.hpp>
+#include <nano/store/version.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+std::string const manifest_name = "manifest";
+std::string const manifest_magic = "nano-ledger-snapshot";
+
+using digest_t = std::array<uint8_t, 32>;
+
+/** Upper bound on the size of a key or value, sizes are read before the checksum can be verified */
+uint32_t constexpr max_entry_size = 64 * 1024;
+
+std::string to_hex (uint8_t const * data, size_t size)
+{
+	static char const digits[] = "0123456789ABCDEF";
+	std::string result;
+	result.reserve (size * 2);
+	for (size_t i = 0; i < size; ++i)
+	{
+		result.push_back (digits[data[i] >> 4]);
+		result.push_back (digits[data[i] & 0xf]);
+	}
+	return result;
+}
+
+/** A chunk as listed in the manifest */
+class chunk
+{
+public:
+	std::string table;
+	std::string file;
+	uint64_t count{ 0 };
+	std::string checksum;
+};
+
+class chunk_writer
+{
+public:
+	explicit chunk_writer (std::filesystem::path const & path) :
+		stream{ path, std::ios::binary | std::ios::trunc }
+	{
+		blake2b_init (&hash, sizeof (digest_t));
+	}
+
+	void write (std::vector<uint8_t> const & key, std::vector<uint8_t> const & value)
+	{
+		uint32_t const sizes[] = { boost::endian::native_to_big (static_cast<uint32_t> (key.size ())), boost::endian::native_to_big (static_cast<uint32_t> (value.size ())) };
+		append (reinterpret_cast<uint8_t const *> (sizes), sizeof (sizes));
+		append (key.data (), key.size ());
+		append (value.data (), value.size ());
+		++count;
+	}
+
+	/** Writes the trailer, returns the checksum or an empty string on error */
+	std::string finish ()
+	{
+		digest_t digest;
+		blake2b_final (&hash, digest.data (), digest.size ());
+		auto const count_l = boost::endian::native_to_big (count);
+		stream.write (reinterpret_cast<char const *> (&count_l), sizeof (count_l));
+		stream.write (reinterpret_cast<char const *> (digest.data ()), digest.size ());
+		stream.close ();
+		return stream ? to_hex (digest.data (), digest.size ()) : std::string{};
+	}
+
+	uint64_t count{ 0 };
+
+private:
+	void append (uint8_t const * data, size_t size)
+	{
+		blake2b_update (&hash, data, size);
+		stream.write (reinterpret_cast<char const *> (data), size);
+	}
+
+	std::ofstream stream;
+	blake2b_state hash;
+};
+
+class chunk_reader
+{
+public:
+	chunk_reader (std::filesystem::path const & path, uint64_t count) :
+		stream{ path, std::ios::binary },
+		remaining{ count }
+	{
+		blake2b_init (&hash, sizeof (digest_t));
+	}
+
+	/** Reads the next entry, returns false once all entries are read or on error */
+	bool next (std::vector<uint8_t> & key, std::vector<uint8_t> & value)
+	{
+		if (remaining == 0)
+		{
+			return false;
+		}
+		uint32_t sizes[2];
+		if (!read (reinterpret_cast<uint8_t *> (sizes), sizeof (sizes)))
+		{
+			return false;
+		}
+		auto const key_size = boost::endian::big_to_native (sizes[0]);
+		auto const value_size = boost::endian::big_to_native (sizes[1]);
+		if (key_size > max_entry_size || value_size > max_entry_size)
+		{
+			return false;
+		}
+		key.resize (key_size);
+		value.resize (value_size);
+		if (!read (key.data (), key.size ()) || !read (value.data (), value.size ()))
+		{
+			return false;
+		}
+		--remaining;
+		return true;
+	}
+
+	/** Compares the trailer with the entries read, returns true on error */
+	bool verify (std::string const & checksum)
+	{
+		uint64_t count_l{ 0 };
+		digest_t expected;
+		stream.read (reinterpret_cast<char *> (&count_l), sizeof (count_l));
+		stream.read (reinterpret_cast<char *> (expected.data ()), expected.size ());
+		digest_t digest;
+		blake2b_final (&hash, digest.data (), digest.size ());
+		return !stream || remaining != 0 || digest != expected || to_hex (digest.data (), digest.size ()) != checksum;
+	}
+
+private:
+	bool read (uint8_t * data, size_t size)
+	{
+		stream.read (reinterpret_cast<char *> (data), size);
+		blake2b_update (&hash, data, size);
+		return static_cast<bool> (stream);
+	}
+
+	std::ifstream stream;
+	uint64_t remaining;
+	blake2b_state hash;
+};
+
+/** Runs \p action for every index in [0, count) on a pool of threads */
+void parallel_for (size_t count, std::function<void (size_t)> const & action)
+{
+	std::atomic<size_t> next{ 0 };
+	std::vector<std::thread> threads;
+	for (auto i = std::min<size_t> (count, nano::hardware_concurrency ()); i > 0; --i)
+	{
+		threads.emplace_back ([&] () {
+			nano::thread_role::set (nano::thread_role::name::db_parallel_traversal);
+			for (auto index = next++; index < count; index = next++)
+			{
+				action (index);
+			}
+		});
+	}
+	for (auto & thread : threads)
+	{
+		thread.join ();
+	}
+}
+
+/** Serializes typed table entries with the same conversions the stores use */
+template <typename Entry>
+void serialize (Entry const & entry, std::vector<uint8_t> & key, std::vector<uint8_t> & value)
+{
+	nano::store::lmdb::db_val key_l{ entry.first };
+	nano::store::lmdb::db_val value_l{ entry.second };
+	key.assign (static_cast<uint8_t const *> (key_l.data ()), static_cast<uint8_t const *> (key_l.data ()) + key_l.size ());
+	value.assign (static_cast<uint8_t const *> (value_l.data ()), static_cast<uint8_t const *> (value_l.data ()) + value_l.size ());
+}
+
+void serialize (std::pair<nano::block_hash, nano::store::block_w_sideband> const & entry, std::vector<uint8_t> & key, std::vector<uint8_t> & value)
+{
+	key.assign (entry.first.bytes.begin (), entry.first.bytes.end ());
+	value.clear ();
+	nano::vectorstream stream (value);
+	nano::serialize_block (stream, *entry.second.block);
+	entry.second.sideband.serialize (stream, entry.second.block->type ());
+}
+
+/** Writes one chunk per range visited by the table's for_each_par */
+template <typename Table>
+bool export_table (Table const & table, std::string const & name, std::filesystem::path const & path, std::vector<chunk> & chunks, nano::logger & logger)
+{
+	auto const first = chunks.size ();
+	std::mutex mutex;
+	std::atomic<bool> error{ false };
+	std::atomic<uint64_t> total{ 0 };
+	table.for_each_par ([&] (nano::store::read_transaction const &, auto i, auto n) {
+		if (i == n)
+		{
+			return;
+		}
+		std::vector<uint8_t> key;
+		std::vector<uint8_t> value;
+		serialize (*i, key, value);
+		// Naming chunks after their first key keeps them in key order
+		auto const file = name + "-" + to_hex (key.data (), key.size ());
+		chunk_writer writer{ path / file };
+		for (; i != n && !error; ++i)
+		{
+			serialize (*i, key, value);
+			writer.write (key, value);
+		}
+		auto checksum = writer.finish ();
+		if (checksum.empty ())
+		{
+			logger.error (nano::log::type::ledger, "Error writing snapshot chunk: {}", file);
+			error = true;
+		}
+		total += writer.count;
+		std::lock_guard<std::mutex> guard{ mutex };
+		chunks.push_back ({ name, file, writer.count, checksum });
+	});
+	// Keys have a fixed length per table, sorting by name sorts by key
+	std::sort (chunks.begin () + first, chunks.end (), [] (auto const & a, auto const & b) {
+		return a.file < b.file;
+	});
+	logger.info (nano::log::type::ledger, "Exported {} entries from {} table", total.load (), name);
+	return error;
+}
+}
+
+bool nano::store::snapshot::write (nano::store::component & store, nano::block_hash const & genesis, std::filesystem::path const & path, nano::logger & logger)
+{
+	std::error_code ec;
+	if (std::filesystem::exists (path) && !std::filesystem::is_empty (path, ec))
+	{
+		logger.error (nano::log::type::ledger, "Snapshot directory '{}' is not empty", path.string ());
+		return true;
+	}
+	std::filesystem::create_directories (path, ec);
+	if (ec)
+	{
+		logger.error (nano::log::type::ledger, "Unable to create snapshot directory '{}': {}", path.string (), ec.message ());
+		return true;
+	}
+
+	logger.info (nano::log::type::ledger, "Exporting ledger snapshot to '{}'...", path.string ());
+
+	std::vector<chunk> chunks;
+	bool error = false;
+	error = error || export_table (store.block, "blocks", path, chunks, logger);
+	error = error || export_table (store.account, "accounts", path, chunks, logger);
+	error = error || export_table (store.pending, "pending", path, chunks, logger);
+	error = error || export_table (store.confirmation_height, "confirmation_height", path, chunks, logger);
+	error = error || export_table (store.rep_weight, "rep_weights", path, chunks, logger);
+	error = error || export_table (store.pruned, "pruned", path, chunks, logger);
+	error = error || export_table (store.final_vote, "final_votes", path, chunks, logger);
+	if (error)
+	{
+		return true;
+	}
+
+	std::ofstream manifest{ path / manifest_name, std::ios::trunc };
+	manifest << manifest_magic << ' ' << format_version << ' ' << store.version.get (store.tx_begin_read ()) << ' ' << genesis.to_string () << '\n';
+	for (auto const & chunk : chunks)
+	{
+		manifest << chunk.table << ' ' << chunk.file << ' ' << chunk.count << ' ' << chunk.checksum << '\n';
+	}
+	manifest.close ();
+	if (!manifest)
+	{
+		logger.error (nano::log::type::ledger, "Error writing snapshot manifest");
+		return true;
+	}
+
+	logger.info (nano::log::type::ledger, "Exported ledger snapshot ({} chunks)", chunks.size ());
+	return false;
+}
+
+bool nano::store::snapshot::read (std::filesystem::path const & path, nano::block_hash const & genesis, nano::store::component & store, nano::logger & logger)
+{
+	std::ifstream manifest{ path / manifest_name };
+	std::string magic;
+	unsigned format_version_l{ 0 };
+	int store_version{ 0 };
+	std::string genesis_l;
+	manifest >> magic >> format_version_l >> store_version >> genesis_l;
+	if (!manifest || magic != manifest_magic || format_version_l != format_version)
+	{
+		logger.error (nano::log::type::ledger, "No valid snapshot found in '{}'", path.string ());
+		return true;
+	}
+	if (genesis_l != genesis.to_string ())
+	{
+		logger.error (nano::log::type::ledger, "Snapshot is for a different network (genesis {})", genesis_l);
+		return true;
+	}
+	if (store_version != store.version.get (store.tx_begin_read ()))
+	{
+		logger.error (nano::log::type::ledger, "Snapshot database version {} does not match the store version", store_version);
+		return true;
+	}
+	std::pair<nano::tables, std::string> const tables[] = {
+		{ nano::tables::blocks, "blocks" },
+		{ nano::tables::accounts, "accounts" },
+		{ nano::tables::pending, "pending" },
+		{ nano::tables::confirmation_height, "confirmation_height" },
+		{ nano::tables::rep_weights, "rep_weights" },
+		{ nano::tables::pruned, "pruned" },
+		{ nano::tables::final_votes, "final_votes" },
+	};
+	{
+		// Checked up front, a failed import clears the tables again and must not remove entries that were there before
+		auto transaction = store.tx_begin_read ();
+		if (std::any_of (std::begin (tables), std::end (tables), [&store, &transaction] (auto const & entry) { return store.count (transaction, entry.first) != 0; }))
+		{
+			logger.error (nano::log::type::ledger, "Snapshots can only be imported into an empty ledger");
+			return true;
+		}
+	}
+	std::vector<chunk> chunks;
+	for (chunk entry; manifest >> entry.table >> entry.file >> entry.count >> entry.checksum;)
+	{
+		chunks.push_back (entry);
+	}
+
+	logger.info (nano::log::type::ledger, "Verifying {} snapshot chunks...", chunks.size ());
+	std::atomic<bool> error{ false };
+	parallel_for (chunks.size (), [&] (size_t index) {
+		auto const & chunk = chunks[index];
+		chunk_reader reader{ path / chunk.file, chunk.count };
+		std::vector<uint8_t> key;
+		std::vector<uint8_t> value;
+		while (reader.next (key, value))
+		{
+		}
+		if (reader.verify (chunk.checksum))
+		{
+			logger.error (nano::log::type::ledger, "Snapshot chunk {} is corrupt", chunk.file);
+			error = true;
+		}
+	});
+	if (error)
+	{
+		return true;
+	}
+
+	for (auto const & [table, name] : tables)
+	{
+		std::vector<nano::store::bulk_source> sources;
+		uint64_t expected{ 0 };
+		std::atomic<uint64_t> loaded{ 0 };
+		for (auto const & chunk : chunks)
+		{
+			if (chunk.table == name)
+			{
+				auto reader = std::make_shared<chunk_reader> (path / chunk.file, chunk.count);
+				sources.push_back ([reader, &loaded] (std::vector<uint8_t> & key, std::vector<uint8_t> & value) {
+					auto result = reader->next (key, value);
+					loaded += result;
+					return result;
+				});
+				expected += chunk.count;
+			}
+		}
+		logger.info (nano::log::type::ledger, "Importing {} entries into {} table", expected, name);
+		if (store.bulk_load (table, sources) || loaded != expected)
+		{
+			logger.error (nano::log::type::ledger, "Error importing {} table, removing the partially imported ledger", name);
+			auto transaction = store.tx_begin_write ();
+			for (auto const & [table_l, name_l] : tables)
+			{
+				store.drop (transaction, table_l);
+			}
+			return true;
+		}
+	}
+
+	logger.info (nano::log::type::ledger, "Imported ledger snapshot from '{}'", path.string ());
+	return false;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <nano/lib/numbers.hpp>
+#include <nano/store/fwd.hpp>
+
+#include <filesystem>
+
+namespace nano
+{
+class logger;
+}
+namespace nano::store
+{
+/**
+ * Ledger snapshot for fast node bootstrapping from a trusted source.
+ *
+ * A snapshot is a directory holding a manifest and one chunk file per table key range, written in parallel by for_each_par.
+ * Chunk entries are stored in ascending key order as [key size] [value size] [key] [value] with values in the canonical
+ * store format, followed by the entry count and a blake2b checksum of the entries.
+ * Chunks of a table cover disjoint key ranges and are listed in key order, so importing only needs sequential appends.
+ */
+class snapshot final
+{
+public:
+	/** Exports all ledger tables of \p store into the new directory \p path . Returns true on error */
+	static bool write (nano::store::component & store, nano::block_hash const & genesis, std::filesystem::path const & path, nano::logger &);
+	/**
+	 * Verifies the snapshot at \p path and bulk loads it into the empty \p store . Returns true on error
+	 * If loading fails after verification, the ledger tables are cleared again so the store is left empty
+	 */
+	static bool read (std::filesystem::path const & path, nano::block_hash const & genesis, nano::store::component & store, nano::logger &);
+
+	static unsigned constexpr format_version = 1;
+};
+}